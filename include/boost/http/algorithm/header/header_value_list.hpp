@@ -0,0 +1,83 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+#ifndef BOOST_HTTP_ALGORITHM_HEADER_VALUE_LIST_HPP
+#define BOOST_HTTP_ALGORITHM_HEADER_VALUE_LIST_HPP
+
+#include <iterator>
+
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/detail/find_unquoted.hpp>
+#include <boost/http/syntax/detail/is_ows.hpp>
+
+namespace boost {
+namespace http {
+
+/* A lazy forward range over the elements of a comma-separated list (section 7
+   of RFC7230). Elements are trimmed of OWS and empty elements are skipped. */
+template<class StringView>
+class header_value_list
+{
+public:
+    typedef typename StringView::value_type char_type;
+    typedef StringView value_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef StringView value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type *pointer;
+        typedef const value_type &reference;
+
+        const_iterator();
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator &o) const;
+        bool operator!=(const const_iterator &o) const;
+
+    private:
+        friend class header_value_list;
+
+        const_iterator(const header_value_list *list, const char_type *pos);
+
+        void read_element();
+        const char_type *find_delimiter(const char_type *first,
+                                        const char_type *last) const;
+
+        const header_value_list *list;
+
+        // beginning of the next element or null on the end iterator
+        const char_type *next;
+        value_type current;
+    };
+
+    typedef const_iterator iterator;
+
+    /* If `quoted_strings` is `true`, commas within quoted-strings (section
+       3.2.6 of RFC7230) don't split elements. */
+    explicit header_value_list(const StringView &header_value,
+                               bool quoted_strings = false);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    StringView header_value;
+    bool quoted_strings;
+};
+
+} // namespace http
+} // namespace boost
+
+#include "header_value_list.ipp"
+
+#endif // BOOST_HTTP_ALGORITHM_HEADER_VALUE_LIST_HPP
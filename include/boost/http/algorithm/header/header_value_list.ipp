@@ -0,0 +1,139 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+template<class StringView>
+header_value_list<StringView>::const_iterator::const_iterator()
+    : list(0)
+    , next(0)
+{}
+
+template<class StringView>
+header_value_list<StringView>::const_iterator
+::const_iterator(const header_value_list *list, const char_type *pos)
+    : list(list)
+    , next(pos)
+{
+    read_element();
+}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator::reference
+header_value_list<StringView>::const_iterator::operator*() const
+{
+    return current;
+}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator::pointer
+header_value_list<StringView>::const_iterator::operator->() const
+{
+    return &current;
+}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator &
+header_value_list<StringView>::const_iterator::operator++()
+{
+    read_element();
+    return *this;
+}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator
+header_value_list<StringView>::const_iterator::operator++(int)
+{
+    const_iterator ret(*this);
+    read_element();
+    return ret;
+}
+
+template<class StringView>
+bool header_value_list<StringView>::const_iterator
+::operator==(const const_iterator &o) const
+{
+    return next == o.next;
+}
+
+template<class StringView>
+bool header_value_list<StringView>::const_iterator
+::operator!=(const const_iterator &o) const
+{
+    return next != o.next;
+}
+
+template<class StringView>
+const typename header_value_list<StringView>::char_type *
+header_value_list<StringView>::const_iterator
+::find_delimiter(const char_type *first, const char_type *last) const
+{
+    if (!list->quoted_strings)
+        return http::detail::find(first, last, ',');
+
+    return syntax::detail::find_unquoted(first, last, ',');
+}
+
+template<class StringView>
+void header_value_list<StringView>::const_iterator::read_element()
+{
+    using syntax::detail::is_ows;
+
+    const char_type *last
+        = list->header_value.data() + list->header_value.size();
+
+    for (;;) {
+        while (next != last && is_ows(*next))
+            ++next;
+
+        if (next == last) {
+            next = 0;
+            return;
+        }
+
+        // Empty elements are skipped
+        if (*next != ',')
+            break;
+
+        ++next;
+    }
+
+    const char_type *first = next;
+    const char_type *delimiter = find_delimiter(first, last);
+
+    /* Leading OWS was skipped on the way forward, so only the trailing OWS is
+       walked backwards. There is at least one non-OWS character. */
+    const char_type *element_end = delimiter;
+    while (is_ows(element_end[-1]))
+        --element_end;
+
+    current = StringView(first, element_end - first);
+    next = (delimiter == last) ? last : delimiter + 1;
+}
+
+template<class StringView>
+header_value_list<StringView>::header_value_list(const StringView &header_value,
+                                                 bool quoted_strings)
+    : header_value(header_value)
+    , quoted_strings(quoted_strings)
+{}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator
+header_value_list<StringView>::begin() const
+{
+    return const_iterator(this, header_value.data());
+}
+
+template<class StringView>
+typename header_value_list<StringView>::const_iterator
+header_value_list<StringView>::end() const
+{
+    return const_iterator();
+}
+
+} // namespace http
+} // namespace boost
@@ -0,0 +1,102 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+#ifndef BOOST_HTTP_ALGORITHM_PATH_NORMALIZE_PATH_HPP
+#define BOOST_HTTP_ALGORITHM_PATH_NORMALIZE_PATH_HPP
+
+#include <algorithm>
+
+#include <boost/http/detail/simd.hpp>
+
+namespace boost {
+namespace http {
+
+namespace detail {
+
+/* Returns 1 for ".", 2 for ".." and 0 for any other segment. A dot may also be
+   percent-encoded as "%2E" or "%2e" (section 6.2.2.2 of RFC3986). */
+template<class CharT>
+int count_dot_segment(const CharT *segment, std::size_t size)
+{
+    int dots = 0;
+    std::size_t i = 0;
+    while (i != size) {
+        if (segment[i] == '.') {
+            ++i;
+        } else if (size - i >= 3 && segment[i] == '%' && segment[i + 1] == '2'
+                   && (segment[i + 2] | 0x20) == 'e') {
+            i += 3;
+        } else {
+            return 0;
+        }
+
+        if (++dots > 2)
+            return 0;
+    }
+    return dots;
+}
+
+} // namespace detail
+
+/* Removes dot segments (section 5.2.4 of RFC3986) and collapses sequences of
+   slashes from the `size` elements at `path`. The path is rewritten in place
+   and the new size is returned. */
+template<class CharT>
+std::size_t normalize_path(CharT *path, std::size_t size)
+{
+    const CharT *first = path;
+    const CharT *last = path + size;
+    CharT *out = path;
+
+    const bool absolute = size != 0 && *first == '/';
+    if (absolute)
+        ++first;
+
+    /* The output is kept as "/seg1/seg2" (without the leading slash for
+       relative paths) and the trailing slash is only written at the end. Every
+       byte written was preceded by at least as many bytes read, so writing
+       never overtakes reading. */
+    bool trailing_slash = false;
+
+    while (first != last) {
+        const CharT *segment_end = http::detail::find(first, last, '/');
+        std::size_t segment_size = segment_end - first;
+
+        if (segment_size != 0) {
+            switch (detail::count_dot_segment(first, segment_size)) {
+            case 1:
+                trailing_slash = true;
+                break;
+            case 2:
+                while (out != path && *--out != '/');
+                trailing_slash = true;
+                break;
+            default:
+                if (absolute || out != path)
+                    *out++ = '/';
+                out = std::copy(first, segment_end, out);
+                trailing_slash = false;
+            }
+        }
+
+        if (segment_end == last)
+            break;
+
+        first = segment_end + 1;
+
+        if (first == last)
+            trailing_slash = true;
+    }
+
+    if ((trailing_slash && out != path) || (absolute && out == path))
+        *out++ = '/';
+
+    return out - path;
+}
+
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_ALGORITHM_PATH_NORMALIZE_PATH_HPP
@@ -0,0 +1,94 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+#ifndef BOOST_HTTP_ALGORITHM_QUERY_QUERY_RANGE_HPP
+#define BOOST_HTTP_ALGORITHM_QUERY_QUERY_RANGE_HPP
+
+#include <iterator>
+
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/percent_decode.hpp>
+
+namespace boost {
+namespace http {
+
+/* A lazy forward range over the `key=value` pairs of a query component. No
+   element is extracted before the iterator reaches it and nothing is
+   allocated. */
+template<class StringView>
+class query_range
+{
+public:
+    typedef typename StringView::value_type char_type;
+
+    struct value_type
+    {
+        StringView key;
+        StringView value;
+
+        // `true` if `key` and `value` point to the decoded copies in scratch
+        bool decoded;
+    };
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename query_range::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type *pointer;
+        typedef const value_type &reference;
+
+        const_iterator();
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator &o) const;
+        bool operator!=(const const_iterator &o) const;
+
+    private:
+        friend class query_range;
+
+        const_iterator(const query_range *range, const char_type *pos);
+
+        void read_element();
+
+        const query_range *range;
+
+        // beginning of the next element or null on the end iterator
+        const char_type *next;
+        value_type current;
+    };
+
+    typedef const_iterator iterator;
+
+    explicit query_range(const StringView &query);
+
+    /* Keys and values will be percent-decoded into `scratch` (`'+'` is decoded
+       into a space). An element is yielded undecoded if it is bigger than
+       `scratch_size` or if it holds an invalid escape sequence. The decoded
+       views are invalidated when the iterator is incremented. */
+    query_range(const StringView &query, char_type *scratch,
+                std::size_t scratch_size);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    StringView query;
+    char_type *scratch;
+    std::size_t scratch_size;
+};
+
+} // namespace http
+} // namespace boost
+
+#include "query_range.ipp"
+
+#endif // BOOST_HTTP_ALGORITHM_QUERY_QUERY_RANGE_HPP
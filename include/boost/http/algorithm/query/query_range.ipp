@@ -0,0 +1,162 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+template<class StringView>
+query_range<StringView>::const_iterator::const_iterator()
+    : range(0)
+    , next(0)
+{}
+
+template<class StringView>
+query_range<StringView>::const_iterator
+::const_iterator(const query_range *range, const char_type *pos)
+    : range(range)
+    , next(pos)
+{
+    read_element();
+}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator::reference
+query_range<StringView>::const_iterator::operator*() const
+{
+    return current;
+}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator::pointer
+query_range<StringView>::const_iterator::operator->() const
+{
+    return &current;
+}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator &
+query_range<StringView>::const_iterator::operator++()
+{
+    read_element();
+    return *this;
+}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator
+query_range<StringView>::const_iterator::operator++(int)
+{
+    const_iterator ret(*this);
+    read_element();
+    return ret;
+}
+
+template<class StringView>
+bool query_range<StringView>::const_iterator
+::operator==(const const_iterator &o) const
+{
+    return next == o.next;
+}
+
+template<class StringView>
+bool query_range<StringView>::const_iterator
+::operator!=(const const_iterator &o) const
+{
+    return next != o.next;
+}
+
+template<class StringView>
+void query_range<StringView>::const_iterator::read_element()
+{
+    typedef syntax::percent_decode<char_type> percent_decode;
+
+    const char_type *last = range->query.data() + range->query.size();
+
+    /* Empty elements are skipped, so we don't yield a pair that was never
+       there. */
+    while (next != last && *next == '&')
+        ++next;
+
+    if (next == last) {
+        next = 0;
+        return;
+    }
+
+    /* One pass: the first delimiter found tells whether there is a value at
+       all. */
+    static const unsigned char set[] = {'&', '='};
+    const char_type *first = next;
+    const char_type *key_end = http::detail::find_first_of(first, last, set);
+    const char_type *value_begin = key_end;
+    const char_type *element_end = key_end;
+
+    if (key_end != last && *key_end == '=') {
+        value_begin = key_end + 1;
+        element_end = http::detail::find(value_begin, last, '&');
+    }
+
+    next = (element_end == last) ? last : element_end + 1;
+
+    current.key = StringView(first, key_end - first);
+    current.value = StringView(value_begin, element_end - value_begin);
+    current.decoded = false;
+
+    if (!range->scratch
+        || std::size_t(element_end - first) > range->scratch_size) {
+        return;
+    }
+
+    std::size_t key_size;
+    std::size_t value_size;
+    char_type *key_out = range->scratch;
+
+    if (percent_decode::decode_form(current.key, key_out, key_size)
+        != percent_decode::result::ok) {
+        return;
+    }
+
+    char_type *value_out = key_out + key_size;
+
+    if (percent_decode::decode_form(current.value, value_out, value_size)
+        != percent_decode::result::ok) {
+        return;
+    }
+
+    current.key = StringView(key_out, key_size);
+    current.value = StringView(value_out, value_size);
+    current.decoded = true;
+}
+
+template<class StringView>
+query_range<StringView>::query_range(const StringView &query)
+    : query(query)
+    , scratch(0)
+    , scratch_size(0)
+{}
+
+template<class StringView>
+query_range<StringView>::query_range(const StringView &query,
+                                     char_type *scratch,
+                                     std::size_t scratch_size)
+    : query(query)
+    , scratch(scratch)
+    , scratch_size(scratch_size)
+{}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator
+query_range<StringView>::begin() const
+{
+    return const_iterator(this, query.data());
+}
+
+template<class StringView>
+typename query_range<StringView>::const_iterator
+query_range<StringView>::end() const
+{
+    return const_iterator();
+}
+
+} // namespace http
+} // namespace boost
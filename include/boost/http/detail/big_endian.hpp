@@ -0,0 +1,59 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_DETAIL_BIG_ENDIAN_HPP
+#define BOOST_HTTP_DETAIL_BIG_ENDIAN_HPP
+
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Network byte order integers (e.g. the fields of HTTP/2 frames)
+
+inline uint_least16_t load_be16(const unsigned char *p)
+{
+    return static_cast<uint_least16_t>((p[0] << 8) | p[1]);
+}
+
+inline uint_least32_t load_be24(const unsigned char *p)
+{
+    return (uint_least32_t(p[0]) << 16) | (uint_least32_t(p[1]) << 8) | p[2];
+}
+
+inline uint_least32_t load_be32(const unsigned char *p)
+{
+    return (uint_least32_t(p[0]) << 24) | (uint_least32_t(p[1]) << 16)
+        | (uint_least32_t(p[2]) << 8) | p[3];
+}
+
+inline void store_be16(unsigned char *p, uint_least16_t v)
+{
+    p[0] = static_cast<unsigned char>(v >> 8);
+    p[1] = static_cast<unsigned char>(v);
+}
+
+inline void store_be24(unsigned char *p, uint_least32_t v)
+{
+    p[0] = static_cast<unsigned char>(v >> 16);
+    p[1] = static_cast<unsigned char>(v >> 8);
+    p[2] = static_cast<unsigned char>(v);
+}
+
+inline void store_be32(unsigned char *p, uint_least32_t v)
+{
+    p[0] = static_cast<unsigned char>(v >> 24);
+    p[1] = static_cast<unsigned char>(v >> 16);
+    p[2] = static_cast<unsigned char>(v >> 8);
+    p[3] = static_cast<unsigned char>(v);
+}
+
+} // namespace detail
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_DETAIL_BIG_ENDIAN_HPP
@@ -0,0 +1,229 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_DETAIL_HPACK_HPP
+#define BOOST_HTTP_DETAIL_HPACK_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/http/hpack_field.hpp>
+#include <boost/http/detail/hpack_huffman.hpp>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+struct hpack_static_entry
+{
+    const char *name;
+    unsigned char name_size;
+    const char *value;
+    unsigned char value_size;
+    hpack_field::value field;
+};
+
+// Number of entries in the static table (appendix A of RFC7541)
+const std::size_t hpack_static_table_size = 61;
+
+// Overhead added to the size of every dynamic table entry (section 4.1)
+const std::size_t hpack_entry_overhead = 32;
+
+// Entry `i` has the HPACK index `i + 1`
+inline const hpack_static_entry *hpack_static_table()
+{
+    static const hpack_static_entry table[hpack_static_table_size] = {
+        {":authority", 10, "", 0, hpack_field::authority},
+        {":method", 7, "GET", 3, hpack_field::method},
+        {":method", 7, "POST", 4, hpack_field::method},
+        {":path", 5, "/", 1, hpack_field::path},
+        {":path", 5, "/index.html", 11, hpack_field::path},
+        {":scheme", 7, "http", 4, hpack_field::scheme},
+        {":scheme", 7, "https", 5, hpack_field::scheme},
+        {":status", 7, "200", 3, hpack_field::status},
+        {":status", 7, "204", 3, hpack_field::status},
+        {":status", 7, "206", 3, hpack_field::status},
+        {":status", 7, "304", 3, hpack_field::status},
+        {":status", 7, "400", 3, hpack_field::status},
+        {":status", 7, "404", 3, hpack_field::status},
+        {":status", 7, "500", 3, hpack_field::status},
+        {"accept-charset", 14, "", 0, hpack_field::accept_charset},
+        {"accept-encoding", 15,
+         "gzip, deflate", 13, hpack_field::accept_encoding},
+        {"accept-language", 15, "", 0, hpack_field::accept_language},
+        {"accept-ranges", 13, "", 0, hpack_field::accept_ranges},
+        {"accept", 6, "", 0, hpack_field::accept},
+        {"access-control-allow-origin", 27,
+         "", 0, hpack_field::access_control_allow_origin},
+        {"age", 3, "", 0, hpack_field::age},
+        {"allow", 5, "", 0, hpack_field::allow},
+        {"authorization", 13, "", 0, hpack_field::authorization},
+        {"cache-control", 13, "", 0, hpack_field::cache_control},
+        {"content-disposition", 19, "", 0, hpack_field::content_disposition},
+        {"content-encoding", 16, "", 0, hpack_field::content_encoding},
+        {"content-language", 16, "", 0, hpack_field::content_language},
+        {"content-length", 14, "", 0, hpack_field::content_length},
+        {"content-location", 16, "", 0, hpack_field::content_location},
+        {"content-range", 13, "", 0, hpack_field::content_range},
+        {"content-type", 12, "", 0, hpack_field::content_type},
+        {"cookie", 6, "", 0, hpack_field::cookie},
+        {"date", 4, "", 0, hpack_field::date},
+        {"etag", 4, "", 0, hpack_field::etag},
+        {"expect", 6, "", 0, hpack_field::expect},
+        {"expires", 7, "", 0, hpack_field::expires},
+        {"from", 4, "", 0, hpack_field::from},
+        {"host", 4, "", 0, hpack_field::host},
+        {"if-match", 8, "", 0, hpack_field::if_match},
+        {"if-modified-since", 17, "", 0, hpack_field::if_modified_since},
+        {"if-none-match", 13, "", 0, hpack_field::if_none_match},
+        {"if-range", 8, "", 0, hpack_field::if_range},
+        {"if-unmodified-since", 19, "", 0, hpack_field::if_unmodified_since},
+        {"last-modified", 13, "", 0, hpack_field::last_modified},
+        {"link", 4, "", 0, hpack_field::link},
+        {"location", 8, "", 0, hpack_field::location},
+        {"max-forwards", 12, "", 0, hpack_field::max_forwards},
+        {"proxy-authenticate", 18, "", 0, hpack_field::proxy_authenticate},
+        {"proxy-authorization", 19, "", 0, hpack_field::proxy_authorization},
+        {"range", 5, "", 0, hpack_field::range},
+        {"referer", 7, "", 0, hpack_field::referer},
+        {"refresh", 7, "", 0, hpack_field::refresh},
+        {"retry-after", 11, "", 0, hpack_field::retry_after},
+        {"server", 6, "", 0, hpack_field::server},
+        {"set-cookie", 10, "", 0, hpack_field::set_cookie},
+        {"strict-transport-security", 25,
+         "", 0, hpack_field::strict_transport_security},
+        {"transfer-encoding", 17, "", 0, hpack_field::transfer_encoding},
+        {"user-agent", 10, "", 0, hpack_field::user_agent},
+        {"vary", 4, "", 0, hpack_field::vary},
+        {"via", 3, "", 0, hpack_field::via},
+        {"www-authenticate", 16, "", 0, hpack_field::www_authenticate}
+    };
+    return table;
+}
+
+// Size of the longest name within the static table
+const std::size_t hpack_static_max_name_size = 27;
+
+/* The HPACK indexes of the static table entries with a distinct name, grouped
+   by the size of the name (0-terminated). A name is compared against, at most,
+   6 candidates. */
+inline const unsigned char (*hpack_static_names_by_size())[7]
+{
+    static const unsigned char table[hpack_static_max_name_size + 1][7] = {
+        {0}, {0}, {0},
+        {21, 60, 0},
+        {33, 34, 37, 38, 45, 59, 0},
+        {4, 22, 50, 0},
+        {19, 32, 35, 54, 0},
+        {2, 6, 8, 36, 51, 52, 0},
+        {39, 42, 46, 0},
+        {0},
+        {1, 55, 58, 0},
+        {53, 0},
+        {31, 47, 0},
+        {18, 23, 24, 30, 41, 44, 0},
+        {15, 28, 0},
+        {16, 17, 0},
+        {26, 27, 29, 61, 0},
+        {40, 57, 0},
+        {48, 0},
+        {25, 43, 49, 0},
+        {0}, {0}, {0}, {0}, {0},
+        {56, 0},
+        {0},
+        {20, 0}
+    };
+    return table;
+}
+
+/* Returns the HPACK index of the first static table entry named `name` (the
+   entries sharing a name are contiguous) or 0 if there is none. */
+inline std::size_t hpack_static_find_name(const char *name, std::size_t size)
+{
+    if (size > hpack_static_max_name_size)
+        return 0;
+
+    const hpack_static_entry *table = hpack_static_table();
+    for (const unsigned char *i = hpack_static_names_by_size()[size] ; *i
+             ; ++i) {
+        if (std::memcmp(table[*i - 1].name, name, size) == 0)
+            return *i;
+    }
+    return 0;
+}
+
+/* Decodes an integer with a `prefix`-bit prefix (section 5.1 of RFC7541).
+   Returns the number of bytes used, 0 if `size` bytes aren't enough or -1 if
+   the value doesn't fit in 32 bits. */
+inline std::ptrdiff_t hpack_decode_integer(const unsigned char *in,
+                                           std::size_t size, unsigned prefix,
+                                           uint_least32_t &value)
+{
+    if (size == 0)
+        return 0;
+
+    const unsigned mask = (1u << prefix) - 1;
+    value = in[0] & mask;
+    if (value != mask)
+        return 1;
+
+    uint_least64_t v = value;
+    for (std::size_t i = 1, shift = 0 ; i != size ; ++i, shift += 7) {
+        // 5 continuation bytes already hold 35 bits
+        if (shift > 28)
+            return -1;
+
+        v += uint_least64_t(in[i] & 0x7F) << shift;
+        if (v > 0xFFFFFFFF)
+            return -1;
+
+        if (!(in[i] & 0x80)) {
+            value = static_cast<uint_least32_t>(v);
+            return static_cast<std::ptrdiff_t>(i + 1);
+        }
+    }
+    return 0;
+}
+
+// Size of `value` once encoded with a `prefix`-bit prefix (section 5.1)
+inline std::size_t hpack_integer_size(unsigned prefix, std::size_t value)
+{
+    const std::size_t mask = (1u << prefix) - 1;
+    if (value < mask)
+        return 1;
+
+    std::size_t n = 2;
+    for (value -= mask ; value >= 0x80 ; value >>= 7)
+        ++n;
+    return n;
+}
+
+/* Encodes `value` with a `prefix`-bit prefix (section 5.1 of RFC7541). `flags`
+   holds the bits of the first byte that precede the prefix. Returns the number
+   of bytes written. */
+inline std::size_t hpack_encode_integer(unsigned char *out, unsigned prefix,
+                                        unsigned char flags, std::size_t value)
+{
+    const std::size_t mask = (1u << prefix) - 1;
+    if (value < mask) {
+        out[0] = static_cast<unsigned char>(flags | value);
+        return 1;
+    }
+
+    out[0] = static_cast<unsigned char>(flags | mask);
+    std::size_t i = 1;
+    for (value -= mask ; value >= 0x80 ; value >>= 7)
+        out[i++] = static_cast<unsigned char>(0x80 | (value & 0x7F));
+    out[i++] = static_cast<unsigned char>(value);
+    return i;
+}
+
+} // namespace detail
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_DETAIL_HPACK_HPP
@@ -0,0 +1,80 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_DETAIL_SHA1_HPP
+#define BOOST_HTTP_DETAIL_SHA1_HPP
+
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+/* The pieces of SHA-1 (RFC3174) needed by callers that know the shape of
+   their input in advance and can therefore skip the generic padding and
+   buffering logic (e.g. by precomputing the schedule of constant blocks). */
+
+inline uint32_t sha1_rotl(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+// Expands the 16 words of a block into the 80 words of its message schedule
+inline void sha1_expand(uint32_t (&w)[80])
+{
+    for (int i = 16 ; i != 80 ; ++i)
+        w[i] = sha1_rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+}
+
+inline void sha1_compress(uint32_t (&h)[5], const uint32_t (&w)[80])
+{
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+    for (int i = 0 ; i != 80 ; ++i) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+
+        uint32_t t = sha1_rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = sha1_rotl(b, 30);
+        b = a;
+        a = t;
+    }
+
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+}
+
+inline void sha1_init(uint32_t (&h)[5])
+{
+    h[0] = 0x67452301;
+    h[1] = 0xEFCDAB89;
+    h[2] = 0x98BADCFE;
+    h[3] = 0x10325476;
+    h[4] = 0xC3D2E1F0;
+}
+
+} // namespace detail
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_DETAIL_SHA1_HPP
@@ -0,0 +1,172 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_DETAIL_SIMD_HPP
+#define BOOST_HTTP_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+/* Define BOOST_HTTP_DETAIL_NO_SIMD to force the portable scalar code paths
+   (e.g. to test them on machines where the vectorized ones would be taken). */
+#ifndef BOOST_HTTP_DETAIL_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_HTTP_DETAIL_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define BOOST_HTTP_DETAIL_AVX2
+#include <immintrin.h>
+#endif
+#endif // BOOST_HTTP_DETAIL_NO_SIMD
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// `x` must not be zero
+inline unsigned countr_zero(unsigned x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long ret;
+    _BitScanForward(&ret, x);
+    return ret;
+#else
+    unsigned ret = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        ++ret;
+    }
+    return ret;
+#endif
+}
+
+/* Returns the first element within [first, last) equal to any of the N bytes
+   from `set` or `last` if none is found. Sixteen bytes are inspected at a time
+   when SSE2 is available. */
+template<int N>
+const unsigned char *find_any(const unsigned char *first,
+                              const unsigned char *last,
+                              const unsigned char (&set)[N])
+{
+#ifdef BOOST_HTTP_DETAIL_SSE2
+    __m128i needles[N];
+    for (int i = 0 ; i != N ; ++i)
+        needles[i] = _mm_set1_epi8(static_cast<char>(set[i]));
+
+    while (last - first >= 16) {
+        __m128i chunk
+            = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i eq = _mm_cmpeq_epi8(chunk, needles[0]);
+        for (int i = 1 ; i != N ; ++i)
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi8(chunk, needles[i]));
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        if (mask != 0)
+            return first + countr_zero(mask);
+
+        first += 16;
+    }
+#endif // BOOST_HTTP_DETAIL_SSE2
+
+    for ( ; first != last ; ++first) {
+        for (int i = 0 ; i != N ; ++i) {
+            if (*first == set[i])
+                return first;
+        }
+    }
+    return last;
+}
+
+template<class CharT, int N>
+const CharT *find_first_of(const CharT *first, const CharT *last,
+                           const unsigned char (&set)[N])
+{
+    BOOST_STATIC_ASSERT(sizeof(CharT) == 1);
+    typedef const unsigned char *pointer;
+    return reinterpret_cast<const CharT*>(
+        find_any(reinterpret_cast<pointer>(first),
+                 reinterpret_cast<pointer>(last), set));
+}
+
+/* The single byte case is delegated to `memchr`, which the C library already
+   vectorizes. */
+template<class CharT>
+const CharT *find(const CharT *first, const CharT *last, unsigned char c)
+{
+    BOOST_STATIC_ASSERT(sizeof(CharT) == 1);
+    if (first == last)
+        return last;
+
+    const void *ret = std::memchr(first, c, last - first);
+    return ret ? static_cast<const CharT*>(ret) : last;
+}
+
+/* XORs the `n` bytes of `data` with the repeating four-byte `key` (as done by
+   the WebSocket masking), starting at `key[offset % 4]`. 32 (AVX2) or 16
+   (SSE2) bytes are processed at a time when available and 8 bytes at a time
+   otherwise. */
+inline void xor_mask(unsigned char *data, std::size_t n,
+                     const unsigned char (&key)[4], std::size_t offset)
+{
+    unsigned char k[8];
+    for (int i = 0 ; i != 8 ; ++i)
+        k[i] = key[(offset + i) % 4];
+
+    /* Every step below processes a multiple of 4 bytes, so `k` stays aligned
+       with `data`. */
+    std::size_t i = 0;
+
+#if defined(BOOST_HTTP_DETAIL_AVX2) || defined(BOOST_HTTP_DETAIL_SSE2)
+    int word;
+    std::memcpy(&word, k, 4);
+#endif
+
+#ifdef BOOST_HTTP_DETAIL_AVX2
+    __m256i mask256 = _mm256_set1_epi32(word);
+    for ( ; n - i >= 32 ; i += 32) {
+        __m256i *p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p),
+                                                mask256));
+    }
+#endif // BOOST_HTTP_DETAIL_AVX2
+
+#ifdef BOOST_HTTP_DETAIL_SSE2
+    __m128i mask128 = _mm_set1_epi32(word);
+    for ( ; n - i >= 16 ; i += 16) {
+        __m128i *p = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), mask128));
+    }
+#endif // BOOST_HTTP_DETAIL_SSE2
+
+    uint64_t mask64;
+    std::memcpy(&mask64, k, 8);
+    for ( ; n - i >= 8 ; i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, data + i, 8);
+        chunk ^= mask64;
+        std::memcpy(data + i, &chunk, 8);
+    }
+
+    for ( ; i != n ; ++i)
+        data[i] ^= k[i % 4];
+}
+
+} // namespace detail
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_DETAIL_SIMD_HPP
@@ -0,0 +1,80 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_HPACK_FIELD_HPP
+#define BOOST_HTTP_HPACK_FIELD_HPP
+
+namespace boost {
+namespace http {
+
+/* The field names of the HPACK static table (appendix A of RFC7541), in table
+   order. Fields whose name comes from the static table are identified without
+   any string comparison. */
+struct hpack_field
+{
+    enum value
+    {
+        // any other field name
+        unknown,
+        authority,
+        method,
+        path,
+        scheme,
+        status,
+        accept_charset,
+        accept_encoding,
+        accept_language,
+        accept_ranges,
+        accept,
+        access_control_allow_origin,
+        age,
+        allow,
+        authorization,
+        cache_control,
+        content_disposition,
+        content_encoding,
+        content_language,
+        content_length,
+        content_location,
+        content_range,
+        content_type,
+        cookie,
+        date,
+        etag,
+        expect,
+        expires,
+        from,
+        host,
+        if_match,
+        if_modified_since,
+        if_none_match,
+        if_range,
+        if_unmodified_since,
+        last_modified,
+        link,
+        location,
+        max_forwards,
+        proxy_authenticate,
+        proxy_authorization,
+        range,
+        referer,
+        refresh,
+        retry_after,
+        server,
+        set_cookie,
+        strict_transport_security,
+        transfer_encoding,
+        user_agent,
+        vary,
+        via,
+        www_authenticate
+    };
+};
+
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_HPACK_FIELD_HPP
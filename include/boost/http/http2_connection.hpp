@@ -0,0 +1,336 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_HTTP2_CONNECTION_HPP
+#define BOOST_HTTP_HTTP2_CONNECTION_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include <boost/http/detail/big_endian.hpp>
+#include <boost/http/syntax/structured_field.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/http/token.hpp>
+#include <boost/http/reader/http2_frame.hpp>
+
+namespace boost {
+namespace http {
+
+/* The connection layer of HTTP/2 (section 5 of RFC9113), without any I/O.
+   The tokens of `reader::http2_frame` are given as they come and the frames
+   the connection has to send (SETTINGS and PING acknowledgements,
+   WINDOW_UPDATE, RST_STREAM and GOAWAY, plus the HEADERS written by the user)
+   pile up in `output()`.
+
+   Stream states and flow-control windows live in a flat array of streams
+   found through an open addressing table on the stream identifier. DATA
+   frames are scheduled following the extensible priorities of RFC9218: lower
+   urgencies first, non-incremental streams one at a time (in stream order) and
+   incremental ones in round-robin, one frame each. Payloads never go through
+   the connection: it only tells which stream sends how many bytes next. */
+class http2_connection
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef boost::string_view view_type;
+    typedef reader::http2_frame::role role;
+
+    // section 7 of RFC9113
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(error_code)
+    {
+        no_error = 0x0,
+        protocol_error = 0x1,
+        internal_error = 0x2,
+        flow_control_error = 0x3,
+        settings_timeout = 0x4,
+        stream_closed = 0x5,
+        frame_size_error = 0x6,
+        refused_stream = 0x7,
+        cancel = 0x8,
+        compression_error = 0x9,
+        connect_error = 0xa,
+        enhance_your_calm = 0xb,
+        inadequate_security = 0xc,
+        http_1_1_required = 0xd
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(error_code)
+
+    // section 5.1 of RFC9113 (no reserved states as push isn't supported)
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(stream_state)
+    {
+        idle,
+        open,
+        half_closed_local,
+        half_closed_remote,
+        closed
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(stream_state)
+
+    // The next DATA frame to send
+    struct data_frame
+    {
+        uint_least32_t stream_id;
+        // Bytes of the stream's body that must follow `header`
+        size_type size;
+        bool end_stream;
+        unsigned char header[9];
+    };
+
+    // Initial value of SETTINGS_INITIAL_WINDOW_SIZE
+    static const uint_least32_t default_window_size = 65535;
+
+    // Largest flow-control window (section 6.9.1 of RFC9113)
+    static const uint_least32_t max_window_size = 0x7FFFFFFF;
+
+    // Largest stream identifier (section 5.1.1 of RFC9113)
+    static const uint_least32_t max_stream_id = 0x7FFFFFFF;
+
+    // Default urgency of RFC9218
+    static const unsigned default_urgency = 3;
+
+    /* `max_concurrent_streams` and `initial_window_size` are advertised in the
+       SETTINGS frame that starts `output()` (clients also get the connection
+       preface and disable server push). */
+    explicit http2_connection(role r = role::server,
+                              uint_least32_t max_concurrent_streams = 100,
+                              uint_least32_t initial_window_size
+                              = default_window_size);
+
+    /* Feeds the current token of `parser`. Returns `false` when the token must
+       be ignored by the application: the tokens of frames on streams that were
+       reset (header block fragments still have to go through the HPACK decoder
+       so its dynamic table doesn't go out of sync) and every token after a
+       connection error. */
+    bool receive(const reader::http2_frame &parser);
+
+    // The connection error found so far (`no_error` if none)
+    error_code error() const;
+
+    // Frames waiting to be sent
+    asio::const_buffer output() const;
+    void consume_output(size_type n);
+
+    stream_state state(uint_least32_t stream_id) const;
+
+    /* Number of open and half-closed streams (plus the streams from
+       `open_stream()` whose HEADERS weren't written yet) */
+    size_type active_streams() const;
+
+    /* Opens a stream initiated by this endpoint (clients only). The stream is
+       idle until `write_headers()` is called. Returns 0 if the peer doesn't
+       allow more concurrent streams, it sent GOAWAY or the stream identifiers
+       are exhausted. */
+    uint_least32_t open_stream();
+
+    /* Writes a HEADERS frame (plus CONTINUATION frames, as needed by the
+       peer's SETTINGS_MAX_FRAME_SIZE) carrying `header_block` into
+       `output()`. Trailers can only be written once the data queued on the
+       stream was sent. Returns `false` (and writes nothing) if the stream is
+       gone, e.g. the peer reset it or GOAWAY closed it. Check `state()` before
+       encoding the block, as a dropped block would desync the peer's HPACK
+       decoder. */
+    bool write_headers(uint_least32_t stream_id,
+                       asio::const_buffer header_block, bool end_stream);
+
+    /* Queues `size` more bytes of the stream's body. They're handed out by
+       `next_data_frame()` as flow control and the priorities allow. Returns
+       `false` (and queues nothing) if the stream is gone. The stream's HEADERS
+       must have been written already. */
+    bool write_data(uint_least32_t stream_id, size_type size,
+                    bool end_stream);
+
+    /* Picks the next DATA frame to send. Returns `false` if no stream can
+       send anything (no queued data or flow control blocks every stream).
+       Frames in `output()` must be sent before the frame. */
+    bool next_data_frame(data_frame &out);
+
+    // The stream's priority (i.e. from the Priority header field)
+    void set_priority(uint_least32_t stream_id, unsigned urgency,
+                      bool incremental);
+
+    /* Parses a Priority field value (section 4 of RFC9218). Unknown or
+       invalid parameters leave the values untouched. Returns `false` if the
+       value isn't a valid dictionary. */
+    static bool parse_priority(view_type value, unsigned &urgency,
+                               bool &incremental);
+
+    /* The application is done with `n` bytes of the stream's DATA, so the
+       peer may send more (WINDOW_UPDATE frames are written once half of a
+       window is consumed). */
+    void consume(uint_least32_t stream_id, size_type n);
+
+    // Writes RST_STREAM and closes the stream
+    void reset_stream(uint_least32_t stream_id, error_code e);
+
+    /* Writes GOAWAY. New streams from the peer are refused from now on.
+       Anything other than `no_error` is a connection error. */
+    void shutdown(error_code e = error_code::no_error);
+
+    bool goaway_received() const;
+
+    // Highest stream identifier the peer initiated
+    uint_least32_t last_peer_stream_id() const;
+
+    /* Flow-control windows (connection and streams) for the frames we send.
+       Streams that are gone have none (0). */
+    int_least64_t send_window() const;
+    int_least64_t send_window(uint_least32_t stream_id) const;
+
+    // Settings advertised by the peer
+    uint_least32_t peer_header_table_size() const;
+    uint_least32_t peer_max_concurrent_streams() const;
+    uint_least32_t peer_max_frame_size() const;
+
+private:
+    // non-copyable
+    http2_connection(const http2_connection&);
+    http2_connection &operator=(const http2_connection&);
+
+    // section 7.1 of RFC9218
+    static const uint_least8_t priority_update_frame = 0x10;
+
+    // No stream (e.g. the end of a scheduler queue)
+    static const size_type npos = static_cast<size_type>(-1);
+
+    struct stream
+    {
+        uint_least32_t id;
+        stream_state state;
+        int_least64_t send_window;
+        int_least64_t recv_window;
+        // Received bytes the application consumed but weren't given back
+        uint_least32_t recv_credit;
+        // Queued bytes not yet handed out
+        size_type pending;
+        bool end_pending;
+        unsigned char urgency;
+        bool incremental;
+        // Scheduler queue links (positions within `streams`)
+        bool queued;
+        size_type prev;
+        size_type next;
+    };
+
+    struct slot
+    {
+        // 0 for empty slots
+        uint_least32_t id;
+        size_type index;
+    };
+
+    void on_frame(const token::http2_frame::type &f);
+    void on_data();
+    void on_headers();
+    void on_rst_stream();
+    void on_window_update();
+    void on_goaway();
+    void on_settings_ack();
+    void on_setting(const token::http2_setting::type &s);
+    void on_chunk(asio::const_buffer chunk);
+    void on_end_of_frame();
+
+    bool local_stream(uint_least32_t id) const;
+    bool idle(uint_least32_t id) const;
+
+    // Stream table {{{
+
+    size_type find(uint_least32_t id) const;
+    size_type hash(uint_least32_t id) const;
+    size_type insert(uint_least32_t id);
+    void remove(size_type idx);
+    void close_local(size_type idx);
+    void close_remote(size_type idx);
+
+    // }}}
+
+    // Scheduler {{{
+
+    void enqueue(size_type idx);
+    void dequeue(size_type idx);
+
+    // }}}
+
+    void credit(size_type idx, uint_least32_t n);
+    void stream_error(uint_least32_t id, error_code e);
+    void fail(error_code e);
+
+    void write_frame_header(uint_least32_t length, uint_least8_t type,
+                            uint_least8_t flags, uint_least32_t stream_id);
+    void write_rst_stream(uint_least32_t id, error_code e);
+    void write_window_update(uint_least32_t id, uint_least32_t increment);
+    void write_goaway(error_code e);
+
+    role role_;
+    error_code error_;
+
+    uint_least32_t max_concurrent_streams;
+
+    /* Our SETTINGS_INITIAL_WINDOW_SIZE only applies to the streams once the
+       peer acknowledges it */
+    uint_least32_t initial_window_size;
+    uint_least32_t acked_window_size;
+
+    // Current frame
+    token::http2_frame::type frame;
+    bool ignore_frame;
+    bool ignore_header_block;
+    // Payload of PING and PRIORITY_UPDATE frames
+    unsigned char frame_payload[64];
+    size_type frame_payload_size;
+
+    uint_least32_t last_peer_id;
+    uint_least32_t last_local_id;
+    size_type peer_streams;
+    size_type local_streams;
+    bool goaway_received_;
+    bool goaway_sent;
+
+    // Settings advertised by the peer
+    uint_least32_t peer_header_table_size_;
+    uint_least32_t peer_max_concurrent_streams_;
+    uint_least32_t peer_initial_window_size;
+    uint_least32_t peer_max_frame_size_;
+
+    // Connection flow-control windows
+    int_least64_t send_window_;
+    int_least64_t recv_window;
+    uint_least32_t recv_credit;
+
+    // Stream table {{{
+
+    std::vector<stream> streams;
+    // Unused positions within `streams`
+    std::vector<size_type> free_streams;
+    // Linear probing on the stream identifier (power-of-two size)
+    std::vector<slot> slots;
+
+    // }}}
+
+    // Scheduler queues (per urgency, non-incremental then incremental)
+    size_type queue_head[8][2];
+    size_type queue_tail[8][2];
+
+    std::vector<unsigned char> output_;
+    size_type output_begin;
+};
+
+} // namespace http
+} // namespace boost
+
+#include "http2_connection.ipp"
+
+#endif // BOOST_HTTP_HTTP2_CONNECTION_HPP
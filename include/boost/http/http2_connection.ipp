@@ -0,0 +1,949 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+inline
+http2_connection::http2_connection(role r,
+                                   uint_least32_t max_concurrent_streams,
+                                   uint_least32_t initial_window_size)
+    : role_(r)
+    , error_(error_code::no_error)
+    , max_concurrent_streams(max_concurrent_streams)
+    , initial_window_size(initial_window_size)
+    , acked_window_size(default_window_size)
+    , ignore_frame(false)
+    , ignore_header_block(false)
+    , frame_payload_size(0)
+    , last_peer_id(0)
+    , last_local_id(0)
+    , peer_streams(0)
+    , local_streams(0)
+    , goaway_received_(false)
+    , goaway_sent(false)
+    , peer_header_table_size_(4096)
+    // No limit until the peer says otherwise (section 6.5.2 of RFC9113)
+    , peer_max_concurrent_streams_(0xFFFFFFFF)
+    , peer_initial_window_size(default_window_size)
+    , peer_max_frame_size_(reader::http2_frame::default_max_frame_size)
+    , send_window_(default_window_size)
+    , recv_window(default_window_size)
+    , recv_credit(0)
+    , slots(16)
+    , output_begin(0)
+{
+    assert(initial_window_size <= max_window_size);
+
+    std::memset(&frame, 0, sizeof(frame));
+    for (int i = 0 ; i != 8 ; ++i) {
+        queue_head[i][0] = queue_head[i][1] = npos;
+        queue_tail[i][0] = queue_tail[i][1] = npos;
+    }
+
+    if (native_value(role_) == role::client) {
+        const char preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+        output_.insert(output_.end(), preface, preface + 24);
+    }
+
+    // section 6.5 of RFC9113
+    typedef token::http2_setting::identifier identifier;
+    unsigned char settings[18];
+    uint_least32_t n = 0;
+
+    http::detail::store_be16(settings + n, identifier::max_concurrent_streams);
+    http::detail::store_be32(settings + n + 2, max_concurrent_streams);
+    n += 6;
+
+    if (initial_window_size != default_window_size) {
+        http::detail::store_be16(settings + n, identifier::initial_window_size);
+        http::detail::store_be32(settings + n + 2, initial_window_size);
+        n += 6;
+    }
+
+    if (native_value(role_) == role::client) {
+        http::detail::store_be16(settings + n, identifier::enable_push);
+        http::detail::store_be32(settings + n + 2, 0);
+        n += 6;
+    }
+
+    write_frame_header(n, token::http2_frame::frame_type::settings, 0, 0);
+    output_.insert(output_.end(), settings, settings + n);
+}
+
+inline bool http2_connection::receive(const reader::http2_frame &parser)
+{
+    if (native_value(error_) != error_code::no_error)
+        return false;
+
+    switch (parser.code()) {
+    case token::code::error_invalid_data:
+        fail(error_code::protocol_error);
+        break;
+    case token::code::error_frame_too_big:
+        fail(error_code::frame_size_error);
+        break;
+    case token::code::http2_frame:
+        on_frame(parser.value<token::http2_frame>());
+        break;
+    case token::code::http2_setting:
+        on_setting(parser.value<token::http2_setting>());
+        break;
+    case token::code::body_chunk:
+        on_chunk(parser.value<token::body_chunk>());
+        break;
+    case token::code::end_of_message:
+        on_end_of_frame();
+        break;
+    default:
+        break;
+    }
+
+    return native_value(error_) == error_code::no_error && !ignore_frame;
+}
+
+inline http2_connection::error_code http2_connection::error() const
+{
+    return error_;
+}
+
+inline asio::const_buffer http2_connection::output() const
+{
+    if (output_begin == output_.size())
+        return asio::const_buffer();
+
+    return asio::const_buffer(&output_[0] + output_begin,
+                              output_.size() - output_begin);
+}
+
+inline void http2_connection::consume_output(size_type n)
+{
+    assert(n <= output_.size() - output_begin);
+
+    output_begin += n;
+    if (output_begin == output_.size()) {
+        output_.clear();
+        output_begin = 0;
+    }
+}
+
+inline http2_connection::stream_state
+http2_connection::state(uint_least32_t stream_id) const
+{
+    assert(stream_id != 0);
+
+    size_type idx = find(stream_id);
+    if (idx != npos)
+        return streams[idx].state;
+
+    return idle(stream_id) ? stream_state::idle : stream_state::closed;
+}
+
+inline http2_connection::size_type http2_connection::active_streams() const
+{
+    return peer_streams + local_streams;
+}
+
+inline uint_least32_t http2_connection::open_stream()
+{
+    assert(native_value(role_) == role::client);
+
+    if (goaway_received_ || local_streams >= peer_max_concurrent_streams_
+        || last_local_id >= max_stream_id - 1) {
+        return 0;
+    }
+
+    last_local_id = (last_local_id == 0) ? 1 : last_local_id + 2;
+
+    // The stream stays idle until its HEADERS are written
+    size_type idx = insert(last_local_id);
+    streams[idx].state = stream_state::idle;
+    return last_local_id;
+}
+
+inline bool http2_connection::write_headers(uint_least32_t stream_id,
+                                            asio::const_buffer header_block,
+                                            bool end_stream)
+{
+    typedef token::http2_frame::frame_type frame_type;
+    typedef token::http2_frame::flags flags;
+
+    // The peer may have closed the stream in the meantime
+    size_type idx = find(stream_id);
+    if (idx == npos)
+        return false;
+
+    assert(streams[idx].pending == 0 && !streams[idx].end_pending);
+    assert(native_value(streams[idx].state) != stream_state::half_closed_local);
+
+    if (native_value(streams[idx].state) == stream_state::idle)
+        streams[idx].state = stream_state::open;
+
+    const unsigned char *p
+        = static_cast<const unsigned char*>(header_block.data());
+    size_type size = header_block.size();
+    uint_least8_t type = frame_type::headers;
+    do {
+        size_type n = std::min(size, size_type(peer_max_frame_size_));
+        uint_least8_t f = (n == size) ? flags::end_headers : 0;
+        if (type == frame_type::headers && end_stream)
+            f |= flags::end_stream;
+
+        write_frame_header(n, type, f, stream_id);
+        output_.insert(output_.end(), p, p + n);
+        p += n;
+        size -= n;
+        type = frame_type::continuation;
+    } while (size != 0);
+
+    if (end_stream)
+        close_local(idx);
+    return true;
+}
+
+inline bool http2_connection::write_data(uint_least32_t stream_id,
+                                         size_type size, bool end_stream)
+{
+    size_type idx = find(stream_id);
+    if (idx == npos)
+        return false;
+
+    stream &s = streams[idx];
+    assert(!s.end_pending);
+    assert(native_value(s.state) != stream_state::idle);
+    assert(native_value(s.state) != stream_state::half_closed_local);
+
+    s.pending += size;
+    s.end_pending = end_stream;
+    enqueue(idx);
+    return true;
+}
+
+inline bool http2_connection::next_data_frame(data_frame &out)
+{
+    if (native_value(error_) != error_code::no_error)
+        return false;
+
+    for (int u = 0 ; u != 8 ; ++u) {
+        for (int incremental = 0 ; incremental != 2 ; ++incremental) {
+            while (queue_head[u][incremental] != npos) {
+                size_type idx = queue_head[u][incremental];
+                stream &s = streams[idx];
+                size_type size = s.pending;
+
+                if (size != 0) {
+                    /* Blocked by its own window (e.g. SETTINGS shrank it). A
+                       WINDOW_UPDATE queues it again. */
+                    if (s.send_window <= 0) {
+                        dequeue(idx);
+                        continue;
+                    }
+
+                    // Every other stream is blocked as well
+                    if (send_window_ <= 0)
+                        return false;
+
+                    size = std::min(size, size_type(std::min(s.send_window,
+                                                             send_window_)));
+                    size = std::min(size, size_type(peer_max_frame_size_));
+                }
+
+                s.pending -= size;
+                s.send_window -= size;
+                send_window_ -= size;
+
+                out.stream_id = s.id;
+                out.size = size;
+                out.end_stream = s.pending == 0 && s.end_pending;
+                http::detail::store_be24(out.header,
+                                         static_cast<uint_least32_t>(size));
+                out.header[3] = token::http2_frame::frame_type::data;
+                out.header[4] = out.end_stream
+                    ? token::http2_frame::flags::end_stream : 0;
+                http::detail::store_be32(out.header + 5, s.id);
+
+                // Incremental streams go to the back of the queue
+                dequeue(idx);
+                if (out.end_stream) {
+                    s.end_pending = false;
+                    close_local(idx);
+                } else {
+                    enqueue(idx);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline void http2_connection::set_priority(uint_least32_t stream_id,
+                                           unsigned urgency, bool incremental)
+{
+    assert(urgency < 8);
+
+    size_type idx = find(stream_id);
+    if (idx == npos)
+        return;
+
+    dequeue(idx);
+    streams[idx].urgency = static_cast<unsigned char>(urgency);
+    streams[idx].incremental = incremental;
+    enqueue(idx);
+}
+
+inline bool http2_connection::parse_priority(view_type value,
+                                             unsigned &urgency,
+                                             bool &incremental)
+{
+    typedef syntax::structured_field<char> sf;
+
+    sf::node nodes[16];
+    std::size_t nnodes;
+    if (native_value(sf::parse_dictionary(value, nodes, 16, nnodes))
+        != sf::result::ok) {
+        return false;
+    }
+
+    const sf::node *u = sf::find_member(nodes, nnodes, "u");
+    if (u && native_value(u->type) == sf::node_type::integer
+        && u->number >= 0 && u->number <= 7) {
+        urgency = static_cast<unsigned>(u->number);
+    }
+
+    const sf::node *i = sf::find_member(nodes, nnodes, "i");
+    if (i && native_value(i->type) == sf::node_type::boolean)
+        incremental = i->number != 0;
+
+    return true;
+}
+
+inline void http2_connection::consume(uint_least32_t stream_id, size_type n)
+{
+    credit(find(stream_id), static_cast<uint_least32_t>(n));
+}
+
+inline void http2_connection::reset_stream(uint_least32_t stream_id,
+                                           error_code e)
+{
+    write_rst_stream(stream_id, e);
+
+    size_type idx = find(stream_id);
+    if (idx != npos)
+        remove(idx);
+}
+
+inline void http2_connection::shutdown(error_code e)
+{
+    if (native_value(e) != error_code::no_error)
+        return fail(e);
+
+    write_goaway(e);
+    goaway_sent = true;
+}
+
+inline bool http2_connection::goaway_received() const
+{
+    return goaway_received_;
+}
+
+inline uint_least32_t http2_connection::last_peer_stream_id() const
+{
+    return last_peer_id;
+}
+
+inline int_least64_t http2_connection::send_window() const
+{
+    return send_window_;
+}
+
+inline int_least64_t
+http2_connection::send_window(uint_least32_t stream_id) const
+{
+    size_type idx = find(stream_id);
+    return (idx == npos) ? 0 : streams[idx].send_window;
+}
+
+inline uint_least32_t http2_connection::peer_header_table_size() const
+{
+    return peer_header_table_size_;
+}
+
+inline uint_least32_t http2_connection::peer_max_concurrent_streams() const
+{
+    return peer_max_concurrent_streams_;
+}
+
+inline uint_least32_t http2_connection::peer_max_frame_size() const
+{
+    return peer_max_frame_size_;
+}
+
+inline void http2_connection::on_frame(const token::http2_frame::type &f)
+{
+    typedef token::http2_frame::frame_type frame_type;
+
+    frame = f;
+    ignore_frame = false;
+    frame_payload_size = 0;
+
+    switch (f.frame_type) {
+    case frame_type::data:
+        on_data();
+        break;
+    case frame_type::headers:
+        on_headers();
+        ignore_header_block = ignore_frame;
+        break;
+    case frame_type::continuation:
+        ignore_frame = ignore_header_block;
+        break;
+    case frame_type::rst_stream:
+        on_rst_stream();
+        break;
+    case frame_type::settings:
+        if (f.flags & token::http2_frame::flags::ack)
+            on_settings_ack();
+        break;
+    case frame_type::push_promise:
+        // Clients disable server push (and servers never accept PUSH_PROMISE)
+        fail(error_code::protocol_error);
+        break;
+    case frame_type::goaway:
+        on_goaway();
+        break;
+    case frame_type::window_update:
+        on_window_update();
+        break;
+    case priority_update_frame:
+        // Only sent by clients and on stream 0 (section 7.1 of RFC9218)
+        if (native_value(role_) == role::client || f.stream_id != 0)
+            fail(error_code::protocol_error);
+        break;
+    default:
+        // PRIORITY (deprecated), PING and frames of unknown types
+        break;
+    }
+}
+
+inline void http2_connection::on_data()
+{
+    // Padding counts against the windows too (section 6.9.1 of RFC9113)
+    uint_least32_t length = frame.payload_size;
+    if (frame.flags & token::http2_frame::flags::padded)
+        length += frame.pad_length + 1;
+
+    if (length > recv_window)
+        return fail(error_code::flow_control_error);
+    recv_window -= length;
+
+    if (idle(frame.stream_id))
+        return fail(error_code::protocol_error);
+
+    size_type idx = find(frame.stream_id);
+    if (idx == npos
+        || native_value(streams[idx].state) == stream_state::half_closed_remote) {
+        // The connection window is given back right away
+        credit(npos, length);
+        return stream_error(frame.stream_id, error_code::stream_closed);
+    }
+
+    stream &s = streams[idx];
+    if (length > s.recv_window) {
+        credit(npos, length);
+        return stream_error(frame.stream_id, error_code::flow_control_error);
+    }
+    s.recv_window -= length;
+
+    // The application never sees the padding
+    credit(idx, length - frame.payload_size);
+
+    if (frame.flags & token::http2_frame::flags::end_stream)
+        close_remote(idx);
+}
+
+inline void http2_connection::on_headers()
+{
+    uint_least32_t id = frame.stream_id;
+    size_type idx = find(id);
+
+    if (idx == npos) {
+        // Only the peer opens streams of its own parity (section 5.1.1)
+        if (local_stream(id)) {
+            if (idle(id))
+                return fail(error_code::protocol_error);
+            return stream_error(id, error_code::stream_closed);
+        }
+
+        if (!idle(id))
+            return stream_error(id, error_code::stream_closed);
+
+        last_peer_id = id;
+        if (goaway_sent || peer_streams >= max_concurrent_streams)
+            return stream_error(id, error_code::refused_stream);
+
+        idx = insert(id);
+    } else if (native_value(streams[idx].state) == stream_state::idle) {
+        return fail(error_code::protocol_error);
+    } else if (native_value(streams[idx].state)
+               == stream_state::half_closed_remote) {
+        return stream_error(id, error_code::stream_closed);
+    }
+
+    if (frame.flags & token::http2_frame::flags::end_stream)
+        close_remote(idx);
+}
+
+inline void http2_connection::on_rst_stream()
+{
+    if (idle(frame.stream_id))
+        return fail(error_code::protocol_error);
+
+    size_type idx = find(frame.stream_id);
+    if (idx != npos)
+        remove(idx);
+}
+
+inline void http2_connection::on_window_update()
+{
+    uint_least32_t increment = frame.window_size_increment;
+
+    if (frame.stream_id == 0) {
+        if (increment == 0)
+            return fail(error_code::protocol_error);
+        if (send_window_ + increment > max_window_size)
+            return fail(error_code::flow_control_error);
+
+        send_window_ += increment;
+        return;
+    }
+
+    if (idle(frame.stream_id))
+        return fail(error_code::protocol_error);
+
+    size_type idx = find(frame.stream_id);
+    // Frames in flight after the stream was closed
+    if (idx == npos)
+        return;
+
+    if (increment == 0)
+        return stream_error(frame.stream_id, error_code::protocol_error);
+
+    stream &s = streams[idx];
+    if (s.send_window + increment > max_window_size)
+        return stream_error(frame.stream_id, error_code::flow_control_error);
+
+    s.send_window += increment;
+    enqueue(idx);
+}
+
+inline void http2_connection::on_goaway()
+{
+    goaway_received_ = true;
+
+    // Our streams above `last_stream_id` weren't processed at all
+    for (size_type i = 0 ; i != streams.size() ; ++i) {
+        if (streams[i].id != 0 && local_stream(streams[i].id)
+            && streams[i].id > frame.last_stream_id) {
+            remove(i);
+        }
+    }
+}
+
+inline void http2_connection::on_settings_ack()
+{
+    // Only the SETTINGS frame written at construction is ever acknowledged
+    int_least64_t delta = int_least64_t(initial_window_size)
+        - acked_window_size;
+    acked_window_size = initial_window_size;
+
+    for (size_type i = 0 ; i != streams.size() ; ++i) {
+        if (streams[i].id != 0)
+            streams[i].recv_window += delta;
+    }
+}
+
+inline void http2_connection::on_setting(const token::http2_setting::type &s)
+{
+    typedef token::http2_setting::identifier identifier;
+
+    switch (s.identifier) {
+    case identifier::header_table_size:
+        peer_header_table_size_ = s.value;
+        break;
+    case identifier::max_concurrent_streams:
+        peer_max_concurrent_streams_ = s.value;
+        break;
+    case identifier::initial_window_size:
+        {
+            if (s.value > max_window_size)
+                return fail(error_code::flow_control_error);
+
+            // Applies to every stream (section 6.9.2 of RFC9113)
+            int_least64_t delta = int_least64_t(s.value)
+                - peer_initial_window_size;
+            peer_initial_window_size = s.value;
+
+            for (size_type i = 0 ; i != streams.size() ; ++i) {
+                if (streams[i].id == 0)
+                    continue;
+
+                streams[i].send_window += delta;
+                if (streams[i].send_window > max_window_size)
+                    return fail(error_code::flow_control_error);
+                enqueue(i);
+            }
+            break;
+        }
+    case identifier::max_frame_size:
+        peer_max_frame_size_ = s.value;
+        break;
+    default:
+        // ENABLE_PUSH (we never push), MAX_HEADER_LIST_SIZE and unknown ones
+        break;
+    }
+}
+
+inline void http2_connection::on_chunk(asio::const_buffer chunk)
+{
+    if (frame.frame_type != token::http2_frame::frame_type::ping
+        && frame.frame_type != priority_update_frame) {
+        return;
+    }
+
+    size_type n = std::min(chunk.size(),
+                           sizeof(frame_payload) - frame_payload_size);
+    std::memcpy(frame_payload + frame_payload_size, chunk.data(), n);
+    frame_payload_size += n;
+}
+
+inline void http2_connection::on_end_of_frame()
+{
+    typedef token::http2_frame::frame_type frame_type;
+    typedef token::http2_frame::flags flags;
+
+    switch (frame.frame_type) {
+    case frame_type::settings:
+        if (!(frame.flags & flags::ack))
+            write_frame_header(0, frame_type::settings, flags::ack, 0);
+        break;
+    case frame_type::ping:
+        if (!(frame.flags & flags::ack)) {
+            write_frame_header(8, frame_type::ping, flags::ack, 0);
+            output_.insert(output_.end(), frame_payload, frame_payload + 8);
+        }
+        break;
+    case priority_update_frame:
+        {
+            // Field values too big for `frame_payload` are ignored
+            if (frame.payload_size < 4
+                || frame.payload_size > sizeof(frame_payload)) {
+                break;
+            }
+
+            uint_least32_t id = http::detail::load_be32(frame_payload)
+                & 0x7FFFFFFF;
+            if (id == 0)
+                return fail(error_code::protocol_error);
+
+            // The priorities of idle streams aren't kept
+            size_type idx = find(id);
+            if (idx == npos)
+                break;
+
+            unsigned urgency = streams[idx].urgency;
+            bool incremental = streams[idx].incremental;
+            view_type value(reinterpret_cast<const char*>(frame_payload) + 4,
+                            frame_payload_size - 4);
+            parse_priority(value, urgency, incremental);
+            set_priority(id, urgency, incremental);
+            break;
+        }
+    default:
+        break;
+    }
+}
+
+inline bool http2_connection::local_stream(uint_least32_t id) const
+{
+    // Clients initiate odd-numbered streams
+    return (id % 2 == 1) == (native_value(role_) == role::client);
+}
+
+inline bool http2_connection::idle(uint_least32_t id) const
+{
+    if (!local_stream(id))
+        return id > last_peer_id;
+
+    // `open_stream()` reserves streams before their HEADERS are written
+    if (id > last_local_id)
+        return true;
+
+    size_type idx = find(id);
+    return idx != npos
+        && native_value(streams[idx].state) == stream_state::idle;
+}
+
+inline http2_connection::size_type
+http2_connection::find(uint_least32_t id) const
+{
+    const size_type mask = slots.size() - 1;
+    for (size_type k = hash(id) ; slots[k].id != 0 ; k = (k + 1) & mask) {
+        if (slots[k].id == id)
+            return slots[k].index;
+    }
+    return npos;
+}
+
+inline http2_connection::size_type
+http2_connection::hash(uint_least32_t id) const
+{
+    // Fibonacci hashing spreads the (sequential) identifiers
+    uint_least32_t h = (id * 2654435761u) & 0xFFFFFFFF;
+    return (h ^ (h >> 16)) & (slots.size() - 1);
+}
+
+inline http2_connection::size_type
+http2_connection::insert(uint_least32_t id)
+{
+    // The load factor of the table never goes above 1/2
+    if (2 * (active_streams() + 1) > slots.size()) {
+        std::vector<slot> old(2 * slots.size());
+        old.swap(slots);
+        const size_type mask = slots.size() - 1;
+        for (size_type i = 0 ; i != old.size() ; ++i) {
+            if (old[i].id == 0)
+                continue;
+
+            size_type k = hash(old[i].id);
+            while (slots[k].id != 0)
+                k = (k + 1) & mask;
+            slots[k] = old[i];
+        }
+    }
+
+    size_type idx;
+    if (free_streams.empty()) {
+        idx = streams.size();
+        streams.resize(idx + 1);
+    } else {
+        idx = free_streams.back();
+        free_streams.pop_back();
+    }
+
+    stream &s = streams[idx];
+    s.id = id;
+    s.state = stream_state::open;
+    s.send_window = peer_initial_window_size;
+    s.recv_window = acked_window_size;
+    s.recv_credit = 0;
+    s.pending = 0;
+    s.end_pending = false;
+    s.urgency = default_urgency;
+    s.incremental = false;
+    s.queued = false;
+    s.prev = npos;
+    s.next = npos;
+
+    const size_type mask = slots.size() - 1;
+    size_type k = hash(id);
+    while (slots[k].id != 0)
+        k = (k + 1) & mask;
+    slots[k].id = id;
+    slots[k].index = idx;
+
+    if (local_stream(id))
+        ++local_streams;
+    else
+        ++peer_streams;
+
+    return idx;
+}
+
+inline void http2_connection::remove(size_type idx)
+{
+    stream &s = streams[idx];
+    dequeue(idx);
+
+    const size_type mask = slots.size() - 1;
+    size_type k = hash(s.id);
+    while (slots[k].id != s.id)
+        k = (k + 1) & mask;
+
+    /* Backward shift deletion: slots following the hole move into it unless
+       their home slot lies after the hole, so no probe sequence is broken. */
+    for (size_type j = (k + 1) & mask ; slots[j].id != 0
+             ; j = (j + 1) & mask) {
+        size_type home = hash(slots[j].id);
+        if (((j - home) & mask) >= ((j - k) & mask)) {
+            slots[k] = slots[j];
+            k = j;
+        }
+    }
+    slots[k].id = 0;
+
+    if (local_stream(s.id))
+        --local_streams;
+    else
+        --peer_streams;
+
+    s.id = 0;
+    free_streams.push_back(idx);
+}
+
+inline void http2_connection::close_local(size_type idx)
+{
+    if (native_value(streams[idx].state) == stream_state::half_closed_remote)
+        remove(idx);
+    else
+        streams[idx].state = stream_state::half_closed_local;
+}
+
+inline void http2_connection::close_remote(size_type idx)
+{
+    if (native_value(streams[idx].state) == stream_state::half_closed_local)
+        remove(idx);
+    else
+        streams[idx].state = stream_state::half_closed_remote;
+}
+
+inline void http2_connection::enqueue(size_type idx)
+{
+    stream &s = streams[idx];
+    if (s.queued)
+        return;
+
+    // Nothing to send or blocked by flow control
+    if (s.pending == 0 ? !s.end_pending : s.send_window <= 0)
+        return;
+
+    size_type &head = queue_head[s.urgency][s.incremental];
+    size_type &tail = queue_tail[s.urgency][s.incremental];
+
+    // Non-incremental streams are served in stream order
+    size_type after = tail;
+    if (!s.incremental) {
+        while (after != npos && streams[after].id > s.id)
+            after = streams[after].prev;
+    }
+
+    s.prev = after;
+    s.next = (after == npos) ? head : streams[after].next;
+    if (s.prev == npos)
+        head = idx;
+    else
+        streams[s.prev].next = idx;
+    if (s.next == npos)
+        tail = idx;
+    else
+        streams[s.next].prev = idx;
+    s.queued = true;
+}
+
+inline void http2_connection::dequeue(size_type idx)
+{
+    stream &s = streams[idx];
+    if (!s.queued)
+        return;
+
+    if (s.prev == npos)
+        queue_head[s.urgency][s.incremental] = s.next;
+    else
+        streams[s.prev].next = s.next;
+    if (s.next == npos)
+        queue_tail[s.urgency][s.incremental] = s.prev;
+    else
+        streams[s.next].prev = s.prev;
+    s.queued = false;
+}
+
+inline void http2_connection::credit(size_type idx, uint_least32_t n)
+{
+    if (n == 0)
+        return;
+
+    recv_credit += n;
+    if (recv_credit >= default_window_size / 2) {
+        write_window_update(0, recv_credit);
+        recv_window += recv_credit;
+        recv_credit = 0;
+    }
+
+    // The peer won't send anything else on half-closed (remote) streams
+    if (idx == npos
+        || native_value(streams[idx].state)
+        == stream_state::half_closed_remote) {
+        return;
+    }
+
+    stream &s = streams[idx];
+    s.recv_credit += n;
+    if (s.recv_credit >= acked_window_size / 2) {
+        write_window_update(s.id, s.recv_credit);
+        s.recv_window += s.recv_credit;
+        s.recv_credit = 0;
+    }
+}
+
+inline void http2_connection::stream_error(uint_least32_t id, error_code e)
+{
+    ignore_frame = true;
+    reset_stream(id, e);
+}
+
+inline void http2_connection::fail(error_code e)
+{
+    if (native_value(error_) != error_code::no_error)
+        return;
+
+    write_goaway(e);
+    goaway_sent = true;
+    error_ = e;
+}
+
+inline void http2_connection::write_frame_header(uint_least32_t length,
+                                                 uint_least8_t type,
+                                                 uint_least8_t flags,
+                                                 uint_least32_t stream_id)
+{
+    // section 4.1 of RFC9113
+    unsigned char header[9];
+    http::detail::store_be24(header, length);
+    header[3] = type;
+    header[4] = flags;
+    http::detail::store_be32(header + 5, stream_id);
+    output_.insert(output_.end(), header, header + 9);
+}
+
+inline void http2_connection::write_rst_stream(uint_least32_t id,
+                                               error_code e)
+{
+    unsigned char payload[4];
+    http::detail::store_be32(payload, native_value(e));
+    write_frame_header(4, token::http2_frame::frame_type::rst_stream, 0, id);
+    output_.insert(output_.end(), payload, payload + 4);
+}
+
+inline void http2_connection::write_window_update(uint_least32_t id,
+                                                  uint_least32_t increment)
+{
+    unsigned char payload[4];
+    http::detail::store_be32(payload, increment);
+    write_frame_header(4, token::http2_frame::frame_type::window_update, 0,
+                       id);
+    output_.insert(output_.end(), payload, payload + 4);
+}
+
+inline void http2_connection::write_goaway(error_code e)
+{
+    unsigned char payload[8];
+    http::detail::store_be32(payload, last_peer_id);
+    http::detail::store_be32(payload + 4, native_value(e));
+    write_frame_header(8, token::http2_frame::frame_type::goaway, 0, 0);
+    output_.insert(output_.end(), payload, payload + 8);
+}
+
+} // namespace http
+} // namespace boost
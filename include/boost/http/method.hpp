@@ -0,0 +1,43 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_METHOD_HPP
+#define BOOST_HTTP_METHOD_HPP
+
+#include <cstring>
+
+namespace boost {
+namespace http {
+
+struct method
+{
+    enum value
+    {
+        get,
+        head,
+        post,
+        put,
+        delete_,
+        connect,
+        options,
+        trace,
+        patch,
+        // any extension method
+        other
+    };
+
+    /* The method token is case-sensitive (section 3.1.1 of RFC7230), so no
+       case folding is done here. */
+    template<class StringView>
+    static value convert(const StringView &v);
+};
+
+} // namespace http
+} // namespace boost
+
+#include "method.ipp"
+
+#endif // BOOST_HTTP_METHOD_HPP
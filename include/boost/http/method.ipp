@@ -0,0 +1,47 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+template<class StringView>
+method::value method::convert(const StringView &v)
+{
+    // Dispatch on the size first, so at most two comparisons are done
+    switch (v.size()) {
+    case 3:
+        if (std::memcmp(v.data(), "GET", 3) == 0)
+            return get;
+        if (std::memcmp(v.data(), "PUT", 3) == 0)
+            return put;
+        break;
+    case 4:
+        if (std::memcmp(v.data(), "POST", 4) == 0)
+            return post;
+        if (std::memcmp(v.data(), "HEAD", 4) == 0)
+            return head;
+        break;
+    case 5:
+        if (std::memcmp(v.data(), "PATCH", 5) == 0)
+            return patch;
+        if (std::memcmp(v.data(), "TRACE", 5) == 0)
+            return trace;
+        break;
+    case 6:
+        if (std::memcmp(v.data(), "DELETE", 6) == 0)
+            return delete_;
+        break;
+    case 7:
+        if (std::memcmp(v.data(), "OPTIONS", 7) == 0)
+            return options;
+        if (std::memcmp(v.data(), "CONNECT", 7) == 0)
+            return connect;
+        break;
+    }
+    return other;
+}
+
+} // namespace http
+} // namespace boost
@@ -0,0 +1,55 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_PROTOCOL_HPP
+#define BOOST_HTTP_PROTOCOL_HPP
+
+// private
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/http/reader/detail/abnf.hpp>
+
+// public
+
+#include <boost/asio/buffer.hpp>
+
+namespace boost {
+namespace http {
+
+struct protocol
+{
+    enum value
+    {
+        // more bytes are needed to tell the protocols apart
+        insufficient_data,
+        // anything starting with a method token
+        http_1,
+        // the HTTP/2 connection preface (section 3.4 of RFC9113)
+        http_2,
+        // the PROXY protocol header (text and binary forms)
+        proxy_v1,
+        proxy_v2,
+        // a TLS record carrying a ClientHello
+        tls,
+        unknown
+    };
+
+    /* Classifies the first bytes received on a connection. Nothing is
+       consumed: the bytes are meant to be given next to the reader of the
+       detected protocol. No more than the first 24 bytes are ever looked at
+       and they're compared 8 at a time. */
+    static value sniff(asio::const_buffer in);
+};
+
+} // namespace http
+} // namespace boost
+
+#include "protocol.ipp"
+
+#endif // BOOST_HTTP_PROTOCOL_HPP
@@ -0,0 +1,94 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+namespace detail {
+
+// Up to 8 bytes as a single word (zero-padded, in native byte order)
+inline uint_least64_t sniff_load(const unsigned char *p, std::size_t n)
+{
+    uint_least64_t ret = 0;
+    std::memcpy(&ret, p, n);
+    return ret;
+}
+
+/* Returns 1 if `in` starts with `sig`, -1 if `in` is a proper prefix of `sig`
+   and 0 otherwise. */
+inline int sniff_prefix(const unsigned char *in, std::size_t size,
+                        const char *sig, std::size_t sig_size)
+{
+    const unsigned char *s = reinterpret_cast<const unsigned char*>(sig);
+    std::size_t n = std::min(size, sig_size);
+    for (std::size_t i = 0 ; i < n ; i += 8) {
+        std::size_t k = std::min(n - i, std::size_t(8));
+        if (sniff_load(in + i, k) != sniff_load(s + i, k))
+            return 0;
+    }
+    return (size >= sig_size) ? 1 : -1;
+}
+
+} // namespace detail
+
+inline protocol::value protocol::sniff(asio::const_buffer in)
+{
+    const unsigned char *p = static_cast<const unsigned char*>(in.data());
+    std::size_t size = in.size();
+
+    if (size == 0)
+        return insufficient_data;
+
+    switch (p[0]) {
+    case 0x16:
+        {
+            /* TLS record header (content type 22, handshake) followed by the
+               handshake header (type 1, ClientHello). The record version
+               major is always 3 (section 5.1 of RFC8446). */
+            if (size >= 2 && p[1] != 0x03)
+                return unknown;
+            if (size >= 6 && p[5] != 0x01)
+                return unknown;
+            return (size >= 6) ? tls : insufficient_data;
+        }
+    case '\r':
+        {
+            // section 2.2 of the PROXY protocol specification
+            static const char signature[] = "\r\n\r\n\0\r\nQUIT\n";
+            switch (detail::sniff_prefix(p, size, signature, 12)) {
+            case 1:
+                return proxy_v2;
+            case -1:
+                return insufficient_data;
+            default:
+                return unknown;
+            }
+        }
+    case 'P':
+        {
+            // "PUT", "POST", "PATCH", "PROPFIND"... share the first letters
+            static const char preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+            int h2 = detail::sniff_prefix(p, size, preface, 24);
+            if (h2 == 1)
+                return http_2;
+
+            // section 2.1 of the PROXY protocol specification
+            int proxy = detail::sniff_prefix(p, size, "PROXY ", 6);
+            if (proxy == 1)
+                return proxy_v1;
+
+            if (h2 == -1 || proxy == -1)
+                return insufficient_data;
+            return http_1;
+        }
+    default:
+        /* The request parser still has the final word, but nothing else
+           starts with a method token (section 3 of RFC9112) */
+        return reader::detail::is_tchar(p[0]) ? http_1 : unknown;
+    }
+}
+
+} // namespace http
+} // namespace boost
@@ -0,0 +1,139 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_CONTENT_DECODER_HPP
+#define BOOST_HTTP_READER_CONTENT_DECODER_HPP
+
+// private
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <zlib.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/http/algorithm/header/header_value_list.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Decodes the `body_chunk` data of a message encoded with gzip or deflate
+   (RFC7230 section 4.2) into caller-provided output windows.
+
+   The zlib stream is created once, on the first use, and reset for every new
+   message, so no allocation happens while decoding. Requires zlib. */
+class content_decoder
+{
+public:
+    // types
+    typedef std::size_t size_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(result)
+    {
+        // Call `decode` again with the rest of the input or a new output window
+        ok,
+        // The encoded stream is finished (trailing input is not consumed)
+        end_of_stream,
+        invalid_data,
+        // Output/input ratio above `max_ratio()`
+        ratio_exceeded,
+        // Decoded size above `max_size()`
+        size_exceeded
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(result)
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(coding)
+    {
+        identity,
+        gzip,
+        deflate
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(coding)
+
+    // The ratio limit is only enforced past this amount of decoded data
+    static const size_type ratio_threshold = 64 * 1024;
+
+    content_decoder();
+    ~content_decoder();
+
+    /* Selects the coding from the value of a Content-Encoding header field.
+       Returns false (and leaves the coding unchanged) if the field has unknown
+       codings or more than one non-identity coding. */
+    bool set_content_encoding(string_view field);
+
+    /* Same as `set_content_encoding`, but for a Transfer-Encoding header field
+       (the final `chunked` coding is handled by `reader::request`). */
+    bool set_transfer_encoding(string_view field);
+
+    // Starts a new message with the given coding
+    void reset(coding c = coding::identity);
+
+    coding get_coding() const;
+
+    // 0 disables the limit
+    void set_max_ratio(size_type ratio);
+    size_type max_ratio() const;
+
+    // 0 disables the limit
+    void set_max_size(uint_least64_t size);
+    uint_least64_t max_size() const;
+
+    /* Decodes as much of `in` as fits in `out`. `consumed` and `produced` are
+       set to the number of bytes read from `in` and written to `out`.
+
+       Once an error is returned, the object stays in the error state until
+       `reset` is called. */
+    result decode(asio::const_buffer in, asio::mutable_buffer out,
+                  size_type &consumed, size_type &produced);
+
+    uint_least64_t total_in() const;
+    uint_least64_t total_out() const;
+
+private:
+    enum State {
+        IDLE,
+        STREAMING,
+        FINISHED,
+        FAILED
+    };
+
+    // non-copyable
+    content_decoder(const content_decoder&);
+    content_decoder &operator=(const content_decoder&);
+
+    bool set_codings(string_view field, bool transfer_coding);
+    bool start(asio::const_buffer in);
+
+    z_stream stream;
+    bool initialized;
+    State state;
+    coding coding_;
+    result error;
+
+    size_type max_ratio_;
+    uint_least64_t max_size_;
+    uint_least64_t total_in_;
+    uint_least64_t total_out_;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "content_decoder.ipp"
+
+#endif // BOOST_HTTP_READER_CONTENT_DECODER_HPP
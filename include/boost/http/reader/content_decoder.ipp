@@ -0,0 +1,252 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline content_decoder::content_decoder()
+    : initialized(false)
+    , state(IDLE)
+    , coding_(coding::identity)
+    , error(result::ok)
+    , max_ratio_(100)
+    , max_size_(0)
+    , total_in_(0)
+    , total_out_(0)
+{}
+
+inline content_decoder::~content_decoder()
+{
+    if (initialized)
+        inflateEnd(&stream);
+}
+
+inline bool content_decoder::set_content_encoding(string_view field)
+{
+    return set_codings(field, false);
+}
+
+inline bool content_decoder::set_transfer_encoding(string_view field)
+{
+    return set_codings(field, true);
+}
+
+inline void content_decoder::reset(coding c)
+{
+    state = IDLE;
+    coding_ = c;
+    error = result::ok;
+    total_in_ = 0;
+    total_out_ = 0;
+}
+
+inline content_decoder::coding content_decoder::get_coding() const
+{
+    return coding_;
+}
+
+inline void content_decoder::set_max_ratio(size_type ratio)
+{
+    max_ratio_ = ratio;
+}
+
+inline content_decoder::size_type content_decoder::max_ratio() const
+{
+    return max_ratio_;
+}
+
+inline void content_decoder::set_max_size(uint_least64_t size)
+{
+    max_size_ = size;
+}
+
+inline uint_least64_t content_decoder::max_size() const
+{
+    return max_size_;
+}
+
+inline uint_least64_t content_decoder::total_in() const
+{
+    return total_in_;
+}
+
+inline uint_least64_t content_decoder::total_out() const
+{
+    return total_out_;
+}
+
+inline content_decoder::result
+content_decoder::decode(asio::const_buffer in, asio::mutable_buffer out,
+                        size_type &consumed, size_type &produced)
+{
+    consumed = 0;
+    produced = 0;
+
+    switch (state) {
+    case FAILED:
+        return error;
+    case FINISHED:
+        return result::end_of_stream;
+    case IDLE:
+    case STREAMING:
+        break;
+    }
+
+    /* Neither buffer size is allowed to overflow zlib's `uInt`, and the output
+       window never goes further than one byte past `max_size_`. */
+    uint_least64_t in_size = std::min<uint_least64_t>(in.size(), UINT_MAX);
+    uint_least64_t out_size = std::min<uint_least64_t>(out.size(), UINT_MAX);
+    if (max_size_ != 0 && total_out_ <= max_size_)
+        out_size = std::min(out_size, max_size_ - total_out_ + 1);
+
+    int ret = Z_OK;
+
+    if (native_value(coding_) == coding::identity) {
+        in_size = std::min(in_size, out_size);
+        if (in_size != 0)
+            std::memcpy(out.data(), in.data(), in_size);
+        consumed = in_size;
+        produced = in_size;
+    } else {
+        if (state == IDLE) {
+            if (in_size == 0)
+                return result::ok;
+
+            if (!start(in)) {
+                state = FAILED;
+                error = result::invalid_data;
+                return error;
+            }
+            state = STREAMING;
+        }
+
+        stream.next_in
+            = const_cast<Bytef*>(static_cast<const Bytef*>(in.data()));
+        stream.avail_in = static_cast<uInt>(in_size);
+        stream.next_out = static_cast<Bytef*>(out.data());
+        stream.avail_out = static_cast<uInt>(out_size);
+
+        ret = inflate(&stream, Z_NO_FLUSH);
+
+        consumed = in_size - stream.avail_in;
+        produced = out_size - stream.avail_out;
+    }
+
+    total_in_ += consumed;
+    total_out_ += produced;
+
+    switch (ret) {
+    case Z_OK:
+    case Z_STREAM_END:
+        break;
+    case Z_BUF_ERROR:
+        // No progress was possible (empty input or output window)
+        break;
+    default:
+        state = FAILED;
+        error = result::invalid_data;
+        return error;
+    }
+
+    if (max_size_ != 0 && total_out_ > max_size_) {
+        state = FAILED;
+        error = result::size_exceeded;
+        return error;
+    }
+
+    /* Decompression bombs have absurd ratios (e.g. 1000:1 for a run of
+       zeroes), but small messages can be legitimately very compressible too,
+       hence the threshold. */
+    if (max_ratio_ != 0 && total_out_ > ratio_threshold
+        && total_out_ / max_ratio_ > total_in_) {
+        state = FAILED;
+        error = result::ratio_exceeded;
+        return error;
+    }
+
+    if (ret == Z_STREAM_END) {
+        state = FINISHED;
+        return result::end_of_stream;
+    }
+
+    return result::ok;
+}
+
+inline bool content_decoder::set_codings(string_view field,
+                                         bool transfer_coding)
+{
+    using boost::algorithm::iequals;
+    typedef header_value_list<string_view>::const_iterator iterator;
+
+    header_value_list<string_view> codings(field, true);
+    coding c = coding::identity;
+
+    for (iterator it = codings.begin() ; it != codings.end() ; ++it) {
+        // Transfer codings may have parameters (section 4 of RFC7230)
+        string_view name = it->substr(0, it->find(';'));
+        name = syntax::detail::trim_ows(name.data(),
+                                        name.data() + name.size());
+
+        if (iequals(name, "identity")
+            || (transfer_coding && iequals(name, "chunked"))) {
+            continue;
+        }
+
+        if (native_value(c) != coding::identity)
+            return false;
+
+        /* A recipient SHOULD consider "x-gzip" to be equivalent to "gzip"
+           (section 4.2.3 of RFC7230). */
+        if (iequals(name, "gzip") || iequals(name, "x-gzip"))
+            c = coding::gzip;
+        else if (iequals(name, "deflate"))
+            c = coding::deflate;
+        else
+            return false;
+    }
+
+    reset(c);
+    return true;
+}
+
+inline bool content_decoder::start(asio::const_buffer in)
+{
+    int window_bits = MAX_WBITS;
+
+    switch (native_value(coding_)) {
+    case coding::gzip:
+        window_bits += 16;
+        break;
+    case coding::deflate:
+        {
+            /* The "deflate" coding is the zlib format (section 4.2.2 of
+               RFC7230), but some implementations wrongly send the raw deflate
+               format. The first byte of a zlib stream (CMF) tells the
+               compression method (8) in its low nibble and it's very unlikely
+               to start a raw deflate stream. */
+            unsigned char cmf = *static_cast<const unsigned char*>(in.data());
+            if ((cmf & 0x0F) != Z_DEFLATED || (cmf >> 4) > 7)
+                window_bits = -window_bits;
+            break;
+        }
+    case coding::identity:
+        BOOST_HTTP_DETAIL_UNREACHABLE("identity has no zlib stream");
+    }
+
+    if (initialized)
+        return inflateReset2(&stream, window_bits) == Z_OK;
+
+    std::memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, window_bits) != Z_OK)
+        return false;
+
+    initialized = true;
+    return true;
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
@@ -0,0 +1,141 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_DETAIL_BOUNDARY_SEARCHER_HPP
+#define BOOST_HTTP_READER_DETAIL_BOUNDARY_SEARCHER_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/reader/detail/abnf.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+namespace detail {
+
+inline bool is_bchar(unsigned char c)
+{
+    /* bcharsnospace := DIGIT / ALPHA / "'" / "(" / ")" /
+                        "+" / "_" / "," / "-" / "." /
+                        "/" / ":" / "=" / "?"
+
+       from section 5.1.1 of RFC2046 (space is also allowed, but not as the
+       last character). */
+    switch (c) {
+    case '\'': case '(': case ')': case '+': case '_': case ',': case '-':
+    case '.': case '/': case ':': case '=': case '?': case ' ':
+        return true;
+    default:
+        return isalpha(c) || isdigit(c);
+    }
+}
+
+/* Finds the multipart delimiter (CRLF "--" boundary) within a body.
+
+   Whole windows are scanned with Boyer-Moore-Horspool (the pattern is at least
+   5 bytes long and its bytes are mostly rare within the body, so most windows
+   are skipped by the full pattern length). Near the end of the haystack, where
+   only a prefix of the delimiter can fit, candidates are located with `memchr`
+   (vectorized by the C library) on the pattern's first byte. */
+class boundary_searcher
+{
+public:
+    // Boundaries have 1 to 70 characters (section 5.1.1 of RFC2046)
+    static const std::size_t max_boundary_size = 70;
+    static const std::size_t max_size = max_boundary_size + 4;
+
+    boundary_searcher()
+        : size_(0)
+    {}
+
+    // Returns false if `boundary` is not a valid multipart boundary
+    bool assign(boost::string_view boundary)
+    {
+        size_ = 0;
+
+        if (boundary.size() == 0 || boundary.size() > max_boundary_size
+            || boundary[boundary.size() - 1] == ' ') {
+            return false;
+        }
+
+        for (std::size_t i = 0 ; i != boundary.size() ; ++i) {
+            if (!is_bchar(boundary[i]))
+                return false;
+        }
+
+        pattern[0] = '\r';
+        pattern[1] = '\n';
+        pattern[2] = '-';
+        pattern[3] = '-';
+        std::memcpy(pattern + 4, boundary.data(), boundary.size());
+        size_ = boundary.size() + 4;
+
+        for (std::size_t i = 0 ; i != 256 ; ++i)
+            skip[i] = static_cast<unsigned char>(size_);
+        for (std::size_t i = 0 ; i != size_ - 1 ; ++i)
+            skip[pattern[i]] = static_cast<unsigned char>(size_ - 1 - i);
+
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    const unsigned char *data() const
+    {
+        return pattern;
+    }
+
+    /* Returns the offset of the first full match. If there is none, returns
+       the offset of the first proper prefix of the delimiter that runs until
+       the end of the haystack (i.e. a match that might complete once more data
+       arrives) or `n` if there is none. */
+    std::size_t find(const unsigned char *haystack, std::size_t n) const
+    {
+        if (n >= size_) {
+            const std::size_t last = size_ - 1;
+            const std::size_t end = n - size_;
+            std::size_t i = 0;
+            while (i <= end) {
+                unsigned char c = haystack[i + last];
+                if (c == pattern[last]
+                    && std::memcmp(haystack + i, pattern, last) == 0) {
+                    return i;
+                }
+                i += skip[c];
+            }
+        }
+
+        std::size_t i = (n >= size_) ? n - size_ + 1 : 0;
+        while (i != n) {
+            const void *p = std::memchr(haystack + i, pattern[0], n - i);
+            if (!p)
+                return n;
+
+            i = static_cast<const unsigned char*>(p) - haystack;
+            if (std::memcmp(haystack + i, pattern, n - i) == 0)
+                return i;
+            ++i;
+        }
+        return n;
+    }
+
+private:
+    unsigned char pattern[max_size];
+    std::size_t size_;
+    unsigned char skip[256];
+};
+
+} // namespace detail
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_READER_DETAIL_BOUNDARY_SEARCHER_HPP
@@ -8,7 +8,7 @@
 #define BOOST_HTTP_READER_DETAIL_TRANSFER_ENCODING_HPP
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/http/algorithm/header/header_value_any_of.hpp>
+#include <boost/http/algorithm/header/header_value_list.hpp>
 
 namespace boost {
 namespace http {
@@ -21,67 +21,39 @@ enum DecodeTransferEncodingResult {
     CHUNKED_INVALID
 };
 
-struct decode_transfer_encoding_p
+inline DecodeTransferEncodingResult decode_transfer_encoding(string_view field)
 {
-    struct state
-    {
-        state()
-            : count(0)
-            , res(CHUNKED_NOT_FOUND)
-        {}
-
-        unsigned count;
-        DecodeTransferEncodingResult res;
-    };
-
-    static const bool STOP_ITER = true;
-    static const bool PROC_ITER = false;
+    using boost::algorithm::iequals;
+    typedef header_value_list<string_view>::const_iterator iterator;
 
-    decode_transfer_encoding_p(state &s)
-        : count(s.count)
-        , res(s.res)
-    {}
-
-    bool operator()(string_view v) const
-    {
-        using boost::algorithm::iequals;
+    /* Transfer-coding parameters may hold quoted-strings, so commas within them
+       don't split codings. */
+    header_value_list<string_view> codings(field, true);
+    DecodeTransferEncodingResult res = CHUNKED_NOT_FOUND;
 
+    for (iterator it = codings.begin() ; it != codings.end() ; ++it) {
         // All transfer-coding names are case-insensitive (section 4 of RFC7230)
-        if (!iequals(v, "chunked")) {
-            if (count == 1) {
+        if (!iequals(*it, "chunked")) {
+            if (res == CHUNKED_AT_END) {
                 /* If any transfer coding other than chunked is applied to a
                    request payload body, the sender MUST apply chunked as the
                    final transfer coding (section 3.3.1 of RFC7230) */
-                res = CHUNKED_INVALID;
-                return STOP_ITER;
+                return CHUNKED_INVALID;
             }
 
-            return PROC_ITER;
+            continue;
         }
 
-        ++count;
-
-        if (count == 2) {
+        if (res == CHUNKED_AT_END) {
             /* A sender MUST NOT apply chunked more than once to a message body
                (section 3.3.1 of RFC7230) */
-            res = CHUNKED_INVALID;
-            return STOP_ITER;
+            return CHUNKED_INVALID;
         }
 
         res = CHUNKED_AT_END;
-        return PROC_ITER;
     }
 
-    unsigned &count;
-    DecodeTransferEncodingResult &res;
-};
-
-inline DecodeTransferEncodingResult decode_transfer_encoding(string_view field)
-{
-    decode_transfer_encoding_p::state p_state;
-    decode_transfer_encoding_p p(p_state);
-    header_value_any_of(field, p);
-    return p.res;
+    return res;
 }
 
 } // namespace detail
@@ -0,0 +1,176 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_HPACK_HPP
+#define BOOST_HTTP_READER_HPACK_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include <boost/http/detail/hpack.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/http/hpack_field.hpp>
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Decodes HPACK header blocks (RFC7541) into the same `field_name` and
+   `field_value` tokens delivered by `request`, followed by `end_of_headers`
+   once the block ends. Dynamic table size updates are reported as `skip`.
+
+   The dynamic table is kept in a ring buffer allocated once (twice the table
+   size, so entries never wrap and can be handed out as contiguous strings).
+   Huffman strings are decoded 4 bits at a time through a state table. */
+class hpack
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef const unsigned char value_type;
+    typedef value_type *pointer;
+    typedef boost::string_view view_type;
+
+    // Initial value of SETTINGS_HEADER_TABLE_SIZE
+    static const size_type default_max_table_size = 4096;
+
+    /* `max_table_size` is the SETTINGS_HEADER_TABLE_SIZE advertised by this
+       endpoint (i.e. the upper bound of the dynamic table size updates). */
+    explicit hpack(size_type max_table_size = default_max_table_size);
+
+    // Empties the dynamic table (i.e. a new connection)
+    void reset();
+
+    // Inspect current token
+    token::code::value code() const;
+    token::symbol::value symbol() const;
+    token::category::value category() const;
+    size_type token_size() const;
+    template<class T>
+    typename T::type value() const;
+
+    /* The static table name of the current field (also tracked through the
+       dynamic table entries whose name came from the static table) */
+    hpack_field::value field() const;
+
+    // The current field was sent as a never indexed literal (section 6.2.3)
+    bool never_indexed() const;
+
+    token::code::value expected_token() const;
+
+    // Consumes current element and goes to the next one
+    void next();
+
+    /**
+     * It's expected that unread bytes from previous buffer will be present at
+     * the beginning of \p inbuffer (i.e. you MUST NOT discard unread bytes from
+     * previous buffer).
+     *
+     * \p last tells that \p inbuffer holds the rest of the header block.
+     */
+    void set_buffer(asio::const_buffer inbuffer, bool last = true);
+
+    size_type parsed_count() const;
+
+    size_type max_table_size() const;
+
+    // Current size limit of the dynamic table (set by the encoder)
+    size_type table_capacity() const;
+
+    // Current size of the dynamic table (as defined in section 4.1)
+    size_type table_size() const;
+
+    // Number of entries in the dynamic table
+    size_type table_entries() const;
+
+private:
+    enum State {
+        ERRORED,
+        EXPECT_FIELD,
+        EXPECT_FIELD_VALUE
+    };
+
+    struct entry
+    {
+        // Position of the name within `storage` (the value follows it)
+        size_type offset;
+        size_type name_size;
+        size_type value_size;
+        hpack_field::value field;
+    };
+
+    void parse_field();
+    bool lookup(uint_least32_t index);
+    std::ptrdiff_t parse_string(pointer in, size_type size, bool &huffman,
+                                uint_least32_t &length);
+    bool decode_string(pointer in, bool huffman, uint_least32_t length,
+                       char *out, view_type &result);
+    void insert();
+    void evict(size_type capacity);
+    void fail(token::code::value code);
+
+    size_type max_table_size_;
+
+    State state;
+
+    token::code::value code_;
+
+    /* `idx` always point to the beginning of the currently being parsed token
+       in the buffer. */
+    size_type idx;
+
+    size_type token_size_;
+
+    bool last;
+
+    // Dynamic table size updates are only allowed at the start of a block
+    bool block_start;
+
+    // Current field
+    view_type name;
+    view_type value_;
+    hpack_field::value field_;
+    bool never_indexed_;
+
+    // Huffman decoded strings
+    std::vector<char> scratch;
+
+    // Dynamic table {{{
+
+    std::vector<char> storage;
+    // Where the next entry is written within `storage`
+    size_type storage_tail;
+
+    std::vector<entry> entries;
+    // Oldest entry within `entries`
+    size_type first;
+    size_type count;
+
+    size_type table_size_;
+    size_type table_capacity_;
+
+    // }}}
+
+    asio::const_buffer ibuffer;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "hpack.ipp"
+
+#endif // BOOST_HTTP_READER_HPACK_HPP
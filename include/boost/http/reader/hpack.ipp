@@ -0,0 +1,402 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline hpack::hpack(size_type max_table_size)
+    : max_table_size_(max_table_size)
+    , storage(2 * max_table_size)
+    , entries(max_table_size / http::detail::hpack_entry_overhead + 1)
+{
+    reset();
+}
+
+inline void hpack::reset()
+{
+    state = EXPECT_FIELD;
+    code_ = token::code::error_insufficient_data;
+    idx = 0;
+    token_size_ = 0;
+    last = false;
+    block_start = true;
+    name.clear();
+    value_.clear();
+    field_ = hpack_field::unknown;
+    never_indexed_ = false;
+    storage_tail = 0;
+    first = 0;
+    count = 0;
+    table_size_ = 0;
+    table_capacity_ = max_table_size_;
+    ibuffer = asio::const_buffer();
+}
+
+inline token::code::value hpack::code() const
+{
+    return code_;
+}
+
+inline token::symbol::value hpack::symbol() const
+{
+    return token::symbol::convert(code_);
+}
+
+inline token::category::value hpack::category() const
+{
+    return token::category::convert(code_);
+}
+
+inline hpack::size_type hpack::token_size() const
+{
+    return token_size_;
+}
+
+template<>
+inline hpack::view_type hpack::value<token::field_name>() const
+{
+    assert(code_ == token::field_name::code);
+    return name;
+}
+
+template<>
+inline hpack::view_type hpack::value<token::field_value>() const
+{
+    assert(code_ == token::field_value::code);
+    return value_;
+}
+
+inline hpack_field::value hpack::field() const
+{
+    assert(code_ == token::code::field_name
+           || code_ == token::code::field_value);
+    return field_;
+}
+
+inline bool hpack::never_indexed() const
+{
+    assert(code_ == token::code::field_name
+           || code_ == token::code::field_value);
+    return never_indexed_;
+}
+
+inline token::code::value hpack::expected_token() const
+{
+    switch (state) {
+    case ERRORED:
+        return code_;
+    case EXPECT_FIELD:
+        return (idx == ibuffer.size() && last) ? token::code::end_of_headers
+            : token::code::field_name;
+    case EXPECT_FIELD_VALUE:
+        return token::code::field_value;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void hpack::set_buffer(asio::const_buffer ibuffer, bool last)
+{
+    this->ibuffer = ibuffer;
+    this->last = last;
+    idx = 0;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline hpack::size_type hpack::parsed_count() const
+{
+    return idx;
+}
+
+inline hpack::size_type hpack::max_table_size() const
+{
+    return max_table_size_;
+}
+
+inline hpack::size_type hpack::table_capacity() const
+{
+    return table_capacity_;
+}
+
+inline hpack::size_type hpack::table_size() const
+{
+    return table_size_;
+}
+
+inline hpack::size_type hpack::table_entries() const
+{
+    return count;
+}
+
+inline void hpack::next()
+{
+    if (state == ERRORED)
+        return;
+
+    // This is a 0-sized token. Therefore, it is handled sooner.
+    if (state == EXPECT_FIELD_VALUE) {
+        state = EXPECT_FIELD;
+        code_ = token::code::field_value;
+        idx += token_size_;
+        token_size_ = 0;
+        return;
+    }
+
+    if (code_ != token::code::error_insufficient_data) {
+        idx += token_size_;
+        token_size_ = 0;
+        code_ = token::code::error_insufficient_data;
+    }
+
+    if (idx == ibuffer.size()) {
+        if (last) {
+            last = false;
+            block_start = true;
+            code_ = token::code::end_of_headers;
+        }
+        return;
+    }
+
+    parse_field();
+
+    // A representation can't span header blocks
+    if (code_ == token::code::error_insufficient_data && last)
+        fail(token::code::error_invalid_data);
+}
+
+inline void hpack::parse_field()
+{
+    pointer rest = static_cast<pointer>(ibuffer.data()) + idx;
+    size_type avail = ibuffer.size() - idx;
+    uint_least32_t index;
+
+    // Indexed header field (section 6.1 of RFC7541)
+    if (rest[0] & 0x80) {
+        std::ptrdiff_t n = http::detail::hpack_decode_integer(rest, avail, 7,
+                                                              index);
+        if (n == 0)
+            return;
+        if (n < 0 || !lookup(index))
+            return fail(token::code::error_invalid_data);
+
+        block_start = false;
+        never_indexed_ = false;
+        state = EXPECT_FIELD_VALUE;
+        code_ = token::code::field_name;
+        token_size_ = n;
+        return;
+    }
+
+    // Dynamic table size update (section 6.3 of RFC7541)
+    if ((rest[0] & 0xE0) == 0x20) {
+        uint_least32_t size;
+        std::ptrdiff_t n = http::detail::hpack_decode_integer(rest, avail, 5,
+                                                              size);
+        if (n == 0)
+            return;
+        if (n < 0 || !block_start || size > max_table_size_)
+            return fail(token::code::error_invalid_data);
+
+        evict(size);
+        table_capacity_ = size;
+        code_ = token::code::skip;
+        token_size_ = n;
+        return;
+    }
+
+    // Literal header field (section 6.2 of RFC7541)
+    bool indexing = (rest[0] & 0xC0) == 0x40;
+    std::ptrdiff_t n = http::detail::hpack_decode_integer(rest, avail,
+                                                          indexing ? 6 : 4,
+                                                          index);
+    if (n == 0)
+        return;
+    if (n < 0 || (index != 0 && !lookup(index)))
+        return fail(token::code::error_invalid_data);
+
+    size_type pos = n;
+
+    bool name_huffman = false;
+    uint_least32_t name_length = 0;
+    size_type name_pos = 0;
+    if (index == 0) {
+        n = parse_string(rest + pos, avail - pos, name_huffman, name_length);
+        if (n == 0)
+            return;
+        if (n < 0)
+            return fail(token::code::error_invalid_data);
+        name_pos = pos + n - name_length;
+        pos += n;
+    }
+
+    bool value_huffman;
+    uint_least32_t value_length;
+    n = parse_string(rest + pos, avail - pos, value_huffman, value_length);
+    if (n == 0)
+        return;
+    if (n < 0)
+        return fail(token::code::error_invalid_data);
+    size_type value_pos = pos + n - value_length;
+    pos += n;
+
+    /* The whole representation is available now. Names that refer to the
+       dynamic table are copied as the entry may be evicted by the
+       insertion. */
+    bool copy_name = indexing
+        && index > http::detail::hpack_static_table_size;
+    size_type name_room = name_huffman ? name_length * 8 / 5
+        : (copy_name ? name.size() : 0);
+    size_type value_room = value_huffman ? value_length * 8 / 5 : 0;
+    if (scratch.size() < name_room + value_room)
+        scratch.resize(name_room + value_room);
+    char *out = scratch.empty() ? NULL : &scratch[0];
+
+    if (index == 0) {
+        field_ = hpack_field::unknown;
+        if (!decode_string(rest + name_pos, name_huffman, name_length, out,
+                           name)) {
+            return fail(token::code::error_invalid_data);
+        }
+    } else if (copy_name) {
+        std::memcpy(out, name.data(), name.size());
+        name = view_type(out, name.size());
+    }
+
+    if (!decode_string(rest + value_pos, value_huffman, value_length,
+                       out + name_room, value_)) {
+        return fail(token::code::error_invalid_data);
+    }
+
+    if (indexing)
+        insert();
+
+    block_start = false;
+    never_indexed_ = (rest[0] & 0xF0) == 0x10;
+    state = EXPECT_FIELD_VALUE;
+    code_ = token::code::field_name;
+    token_size_ = pos;
+}
+
+inline bool hpack::lookup(uint_least32_t index)
+{
+    using http::detail::hpack_static_table_size;
+
+    if (index == 0)
+        return false;
+
+    if (index <= hpack_static_table_size) {
+        const http::detail::hpack_static_entry &e
+            = http::detail::hpack_static_table()[index - 1];
+        name = view_type(e.name, e.name_size);
+        value_ = view_type(e.value, e.value_size);
+        field_ = e.field;
+        return true;
+    }
+
+    // The newest entry has the lowest index (section 2.3.3 of RFC7541)
+    size_type i = index - hpack_static_table_size - 1;
+    if (i >= count)
+        return false;
+
+    const entry &e = entries[(first + count - 1 - i) % entries.size()];
+    name = view_type(&storage[e.offset], e.name_size);
+    value_ = view_type(&storage[e.offset] + e.name_size, e.value_size);
+    field_ = e.field;
+    return true;
+}
+
+inline std::ptrdiff_t hpack::parse_string(pointer in, size_type size,
+                                          bool &huffman,
+                                          uint_least32_t &length)
+{
+    // section 5.2 of RFC7541
+    std::ptrdiff_t n = http::detail::hpack_decode_integer(in, size, 7, length);
+    if (n <= 0)
+        return n;
+
+    if (size - n < length)
+        return 0;
+
+    huffman = in[0] & 0x80;
+    return n + length;
+}
+
+inline bool hpack::decode_string(pointer in, bool huffman,
+                                 uint_least32_t length, char *out,
+                                 view_type &result)
+{
+    if (!huffman) {
+        result = view_type(reinterpret_cast<const char*>(in), length);
+        return true;
+    }
+
+    std::ptrdiff_t n = http::detail::hpack_huffman_decode(in, length, out);
+    if (n < 0)
+        return false;
+
+    result = view_type(out, n);
+    return true;
+}
+
+inline void hpack::insert()
+{
+    // section 4.4 of RFC7541
+    size_type size = name.size() + value_.size()
+        + http::detail::hpack_entry_overhead;
+    if (size > table_capacity_) {
+        evict(0);
+        return;
+    }
+    evict(table_capacity_ - size);
+
+    /* `storage` is twice the table size, so there is always room for the new
+       entry either at the tail or at the beginning. */
+    size_type length = name.size() + value_.size();
+    if (storage.size() - storage_tail < length)
+        storage_tail = 0;
+    assert(count == 0 || entries[first].offset < storage_tail
+           || storage_tail + length <= entries[first].offset);
+
+    std::memcpy(&storage[0] + storage_tail, name.data(), name.size());
+    std::memcpy(&storage[0] + storage_tail + name.size(), value_.data(),
+                value_.size());
+
+    entry &e = entries[(first + count) % entries.size()];
+    e.offset = storage_tail;
+    e.name_size = name.size();
+    e.value_size = value_.size();
+    e.field = field_;
+    ++count;
+
+    storage_tail += length;
+    table_size_ += size;
+}
+
+inline void hpack::evict(size_type capacity)
+{
+    while (table_size_ > capacity) {
+        const entry &e = entries[first];
+        table_size_ -= e.name_size + e.value_size
+            + http::detail::hpack_entry_overhead;
+        first = (first + 1) % entries.size();
+        --count;
+    }
+
+    if (count == 0)
+        storage_tail = 0;
+}
+
+inline void hpack::fail(token::code::value code)
+{
+    state = ERRORED;
+    code_ = code;
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
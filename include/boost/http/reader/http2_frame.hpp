@@ -0,0 +1,158 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_HTTP2_FRAME_HPP
+#define BOOST_HTTP_READER_HTTP2_FRAME_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <boost/http/detail/big_endian.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Reads the HTTP/2 framing layer (section 4 of RFC9113).
+
+   Every frame is reported as a `http2_frame` token (the 9-byte frame header
+   plus the fixed fields of its type, such as the pad length or the priority
+   fields), followed by `body_chunk` tokens for the rest of the payload (e.g.
+   DATA contents or header block fragments) and `skip` tokens for the padding.
+   The entries of SETTINGS frames are reported as `http2_setting` tokens
+   instead. A `end_of_message` token closes every frame.
+
+   Chunks refer to the user's buffer and nothing is ever copied. The reader
+   only enforces the rules that can be checked on a single frame (plus the
+   CONTINUATION sequencing); stream states and flow control belong to the
+   connection. */
+class http2_frame
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef const unsigned char value_type;
+    typedef value_type *pointer;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(role)
+    {
+        // the connection starts with the client connection preface
+        server,
+        // the connection starts with the server's SETTINGS frame
+        client
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(role)
+
+    // Size of the frame header (section 4.1 of RFC9113)
+    static const size_type frame_header_size = 9;
+
+    // Largest `http2_frame` token (frame header plus GOAWAY fixed fields)
+    static const size_type max_header_size = 17;
+
+    // Initial (and smallest) value of SETTINGS_MAX_FRAME_SIZE
+    static const uint_least32_t default_max_frame_size = 16384;
+
+    // Largest value allowed for SETTINGS_MAX_FRAME_SIZE
+    static const uint_least32_t max_frame_size_limit = 16777215;
+
+    explicit http2_frame(role r = role::server);
+
+    // The role and the frame size limit are kept
+    void reset();
+
+    // Inspect current token
+    token::code::value code() const;
+    token::symbol::value symbol() const;
+    token::category::value category() const;
+    size_type token_size() const;
+    template<class T>
+    typename T::type value() const;
+
+    token::code::value expected_token() const;
+
+    // Consumes current element and goes to the next one
+    void next();
+
+    /**
+     * It's expected that unread bytes from previous buffer will be present at
+     * the beginning of \p inbuffer (i.e. you MUST NOT discard unread bytes from
+     * previous buffer).
+     */
+    void set_buffer(asio::const_buffer inbuffer);
+
+    size_type parsed_count() const;
+
+    /* The SETTINGS_MAX_FRAME_SIZE advertised by this endpoint. Frames with a
+       bigger payload are rejected with `error_frame_too_big` as soon as the
+       frame header is read. Only takes effect once the peer acknowledges the
+       setting, so it's up to the user to call it at the right time. */
+    void set_max_frame_size(uint_least32_t size);
+    uint_least32_t max_frame_size() const;
+
+private:
+    enum State {
+        ERRORED,
+        EXPECT_PREFACE,
+        EXPECT_FRAME,
+        EXPECT_PAYLOAD,
+        EXPECT_PADDING,
+        EXPECT_END_OF_MESSAGE
+    };
+
+    void parse_preface();
+    void parse_frame();
+    void parse_setting();
+    void fail(token::code::value code);
+
+    role role_;
+    uint_least32_t max_frame_size_;
+
+    State state;
+
+    token::code::value code_;
+
+    /* `idx` always point to the beginning of the currently being parsed token
+       in the buffer. */
+    size_type idx;
+
+    size_type token_size_;
+
+    // Current frame
+    token::http2_frame::type frame;
+
+    // Bytes of the current frame not yet delivered
+    uint_least32_t remaining;
+    uint_least32_t padding;
+
+    // The first frame must be a SETTINGS frame (section 3.4 of RFC9113)
+    bool expect_settings;
+
+    /* Stream of a header block still expecting CONTINUATION frames (0 when no
+       header block is open) */
+    uint_least32_t continuation_stream;
+
+    token::http2_setting::type setting;
+
+    asio::const_buffer ibuffer;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "http2_frame.ipp"
+
+#endif // BOOST_HTTP_READER_HTTP2_FRAME_HPP
@@ -0,0 +1,434 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline http2_frame::http2_frame(role r)
+    : role_(r)
+    , max_frame_size_(default_max_frame_size)
+{
+    reset();
+}
+
+inline void http2_frame::reset()
+{
+    state = (native_value(role_) == role::server) ? EXPECT_PREFACE
+        : EXPECT_FRAME;
+    code_ = token::code::error_insufficient_data;
+    idx = 0;
+    token_size_ = 0;
+    std::memset(&frame, 0, sizeof(frame));
+    remaining = 0;
+    padding = 0;
+    expect_settings = true;
+    continuation_stream = 0;
+    setting.identifier = 0;
+    setting.value = 0;
+    ibuffer = asio::const_buffer();
+}
+
+inline token::code::value http2_frame::code() const
+{
+    return code_;
+}
+
+inline token::symbol::value http2_frame::symbol() const
+{
+    return token::symbol::convert(code_);
+}
+
+inline token::category::value http2_frame::category() const
+{
+    return token::category::convert(code_);
+}
+
+inline http2_frame::size_type http2_frame::token_size() const
+{
+    return token_size_;
+}
+
+template<>
+inline token::http2_frame::type
+http2_frame::value<token::http2_frame>() const
+{
+    assert(code_ == token::http2_frame::code);
+    return frame;
+}
+
+template<>
+inline token::http2_setting::type
+http2_frame::value<token::http2_setting>() const
+{
+    assert(code_ == token::http2_setting::code);
+    return setting;
+}
+
+template<>
+inline asio::const_buffer http2_frame::value<token::body_chunk>() const
+{
+    assert(code_ == token::body_chunk::code);
+    return asio::buffer(static_cast<pointer>(ibuffer.data()) + idx,
+                        token_size_);
+}
+
+inline token::code::value http2_frame::expected_token() const
+{
+    switch (state) {
+    case ERRORED:
+        return code_;
+    case EXPECT_PREFACE:
+    case EXPECT_PADDING:
+        return token::code::skip;
+    case EXPECT_FRAME:
+        return token::code::http2_frame;
+    case EXPECT_PAYLOAD:
+        return (frame.frame_type == token::http2_frame::frame_type::settings)
+            ? token::code::http2_setting : token::code::body_chunk;
+    case EXPECT_END_OF_MESSAGE:
+        return token::code::end_of_message;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void http2_frame::set_buffer(asio::const_buffer ibuffer)
+{
+    this->ibuffer = ibuffer;
+    idx = 0;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline http2_frame::size_type http2_frame::parsed_count() const
+{
+    return idx;
+}
+
+inline void http2_frame::set_max_frame_size(uint_least32_t size)
+{
+    assert(size >= default_max_frame_size && size <= max_frame_size_limit);
+    max_frame_size_ = size;
+}
+
+inline uint_least32_t http2_frame::max_frame_size() const
+{
+    return max_frame_size_;
+}
+
+inline void http2_frame::next()
+{
+    if (state == ERRORED)
+        return;
+
+    // This is a 0-sized token. Therefore, it is handled sooner.
+    if (state == EXPECT_END_OF_MESSAGE) {
+        state = EXPECT_FRAME;
+        code_ = token::code::end_of_message;
+        idx += token_size_;
+        token_size_ = 0;
+        return;
+    }
+
+    if (code_ != token::code::error_insufficient_data) {
+        idx += token_size_;
+        token_size_ = 0;
+        code_ = token::code::error_insufficient_data;
+    }
+
+    switch (state) {
+    case EXPECT_PREFACE:
+        parse_preface();
+        return;
+    case EXPECT_FRAME:
+        parse_frame();
+        return;
+    case EXPECT_PAYLOAD:
+        {
+            if (remaining == 0) {
+                state = padding ? EXPECT_PADDING : EXPECT_END_OF_MESSAGE;
+                return next();
+            }
+
+            if (frame.frame_type == token::http2_frame::frame_type::settings)
+                return parse_setting();
+
+            size_type n = std::min<size_type>(remaining, ibuffer.size() - idx);
+            if (n == 0)
+                return;
+
+            remaining -= static_cast<uint_least32_t>(n);
+            code_ = token::code::body_chunk;
+            token_size_ = n;
+            return;
+        }
+    case EXPECT_PADDING:
+        {
+            if (padding == 0) {
+                state = EXPECT_END_OF_MESSAGE;
+                return next();
+            }
+
+            size_type n = std::min<size_type>(padding, ibuffer.size() - idx);
+            if (n == 0)
+                return;
+
+            padding -= static_cast<uint_least32_t>(n);
+            code_ = token::code::skip;
+            token_size_ = n;
+            return;
+        }
+    case EXPECT_END_OF_MESSAGE:
+    case ERRORED:
+        BOOST_HTTP_DETAIL_UNREACHABLE("This state is handled sooner");
+    }
+}
+
+inline void http2_frame::parse_preface()
+{
+    // section 3.4 of RFC9113
+    static const char preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+    const size_type preface_size = sizeof(preface) - 1;
+
+    pointer rest = static_cast<pointer>(ibuffer.data()) + idx;
+    size_type n = std::min(ibuffer.size() - idx, preface_size);
+
+    // A HTTP/1.x request is rejected as soon as its first byte arrives
+    if (std::memcmp(rest, preface, n) != 0)
+        return fail(token::code::error_invalid_data);
+
+    if (n != preface_size)
+        return;
+
+    state = EXPECT_FRAME;
+    code_ = token::code::skip;
+    token_size_ = preface_size;
+}
+
+inline void http2_frame::parse_frame()
+{
+    typedef token::http2_frame::frame_type frame_type;
+    typedef token::http2_frame::flags flags;
+
+    pointer rest = static_cast<pointer>(ibuffer.data()) + idx;
+    size_type avail = ibuffer.size() - idx;
+
+    if (avail < frame_header_size)
+        return;
+
+    uint_least32_t length = http::detail::load_be24(rest);
+    uint_least8_t type = rest[3];
+    uint_least8_t f = rest[4];
+    // The reserved bit is ignored (section 4.1 of RFC9113)
+    uint_least32_t stream_id = http::detail::load_be32(rest + 5) & 0x7FFFFFFF;
+
+    /* The frame header is enough to reject the frame, so there is no need to
+       wait for the payload (or to keep a huge frame in the buffer). */
+    if (length > max_frame_size_)
+        return fail(token::code::error_frame_too_big);
+
+    // section 6.10 of RFC9113
+    if (continuation_stream != 0
+        && (type != frame_type::continuation
+            || stream_id != continuation_stream)) {
+        return fail(token::code::error_invalid_data);
+    }
+
+    if (expect_settings && (type != frame_type::settings || (f & flags::ack)))
+        return fail(token::code::error_invalid_data);
+
+    bool padded = false;
+    // Size of the fields that precede the padded payload
+    size_type fixed = 0;
+
+    switch (type) {
+    case frame_type::data:
+        if (stream_id == 0)
+            return fail(token::code::error_invalid_data);
+        padded = f & flags::padded;
+        break;
+    case frame_type::headers:
+        if (stream_id == 0)
+            return fail(token::code::error_invalid_data);
+        padded = f & flags::padded;
+        if (f & flags::priority)
+            fixed = 5;
+        break;
+    case frame_type::priority:
+        if (stream_id == 0)
+            return fail(token::code::error_invalid_data);
+        if (length != 5)
+            return fail(token::code::error_frame_too_big);
+        fixed = 5;
+        break;
+    case frame_type::rst_stream:
+        if (stream_id == 0)
+            return fail(token::code::error_invalid_data);
+        if (length != 4)
+            return fail(token::code::error_frame_too_big);
+        fixed = 4;
+        break;
+    case frame_type::settings:
+        if (stream_id != 0)
+            return fail(token::code::error_invalid_data);
+        if (length % 6 != 0 || ((f & flags::ack) && length != 0))
+            return fail(token::code::error_frame_too_big);
+        break;
+    case frame_type::push_promise:
+        // Only servers push (section 8.4 of RFC9113)
+        if (stream_id == 0 || native_value(role_) == role::server)
+            return fail(token::code::error_invalid_data);
+        padded = f & flags::padded;
+        fixed = 4;
+        break;
+    case frame_type::ping:
+        if (stream_id != 0)
+            return fail(token::code::error_invalid_data);
+        if (length != 8)
+            return fail(token::code::error_frame_too_big);
+        break;
+    case frame_type::goaway:
+        if (stream_id != 0)
+            return fail(token::code::error_invalid_data);
+        if (length < 8)
+            return fail(token::code::error_frame_too_big);
+        fixed = 8;
+        break;
+    case frame_type::window_update:
+        if (length != 4)
+            return fail(token::code::error_frame_too_big);
+        fixed = 4;
+        break;
+    case frame_type::continuation:
+        if (continuation_stream == 0)
+            return fail(token::code::error_invalid_data);
+        break;
+    default:
+        // Unknown frame types are delivered as opaque payloads
+        break;
+    }
+
+    if (padded)
+        ++fixed;
+
+    if (length < fixed)
+        return fail(token::code::error_frame_too_big);
+
+    if (avail < frame_header_size + fixed)
+        return;
+
+    pointer p = rest + frame_header_size;
+    uint_least8_t pad_length = 0;
+    if (padded) {
+        pad_length = *p++;
+        // The padding can't eat the fields or go beyond the frame
+        if (pad_length > length - fixed)
+            return fail(token::code::error_invalid_data);
+    }
+
+    std::memset(&frame, 0, sizeof(frame));
+
+    switch (type) {
+    case frame_type::headers:
+        if (!(f & flags::priority))
+            break;
+        // fall through
+    case frame_type::priority:
+        {
+            uint_least32_t dependency = http::detail::load_be32(p);
+            frame.exclusive = dependency >> 31;
+            frame.stream_dependency = dependency & 0x7FFFFFFF;
+            frame.weight = p[4];
+
+            // section 5.3.1 of RFC7540
+            if (frame.stream_dependency == stream_id)
+                return fail(token::code::error_invalid_data);
+            break;
+        }
+    case frame_type::rst_stream:
+        frame.error_code = http::detail::load_be32(p);
+        break;
+    case frame_type::push_promise:
+        frame.promised_stream_id = http::detail::load_be32(p) & 0x7FFFFFFF;
+        break;
+    case frame_type::goaway:
+        frame.last_stream_id = http::detail::load_be32(p) & 0x7FFFFFFF;
+        frame.error_code = http::detail::load_be32(p + 4);
+        break;
+    case frame_type::window_update:
+        frame.window_size_increment = http::detail::load_be32(p) & 0x7FFFFFFF;
+        break;
+    }
+
+    switch (type) {
+    case frame_type::headers:
+    case frame_type::push_promise:
+        continuation_stream = (f & flags::end_headers) ? 0 : stream_id;
+        break;
+    case frame_type::continuation:
+        if (f & flags::end_headers)
+            continuation_stream = 0;
+        break;
+    }
+
+    expect_settings = false;
+
+    frame.frame_type = type;
+    frame.flags = f;
+    frame.stream_id = stream_id;
+    frame.pad_length = pad_length;
+    frame.payload_size = length - static_cast<uint_least32_t>(fixed)
+        - pad_length;
+    remaining = frame.payload_size;
+    padding = pad_length;
+
+    state = EXPECT_PAYLOAD;
+    code_ = token::code::http2_frame;
+    token_size_ = frame_header_size + fixed;
+}
+
+inline void http2_frame::parse_setting()
+{
+    typedef token::http2_setting::identifier identifier;
+
+    pointer rest = static_cast<pointer>(ibuffer.data()) + idx;
+
+    if (ibuffer.size() - idx < 6)
+        return;
+
+    setting.identifier = http::detail::load_be16(rest);
+    setting.value = http::detail::load_be32(rest + 2);
+
+    /* section 6.5.2 of RFC9113 (SETTINGS_INITIAL_WINDOW_SIZE overflows are
+       flow control errors, so they're left to the connection) */
+    switch (setting.identifier) {
+    case identifier::enable_push:
+        if (setting.value > 1)
+            return fail(token::code::error_invalid_data);
+        break;
+    case identifier::max_frame_size:
+        if (setting.value < default_max_frame_size
+            || setting.value > max_frame_size_limit) {
+            return fail(token::code::error_invalid_data);
+        }
+        break;
+    }
+
+    remaining -= 6;
+    code_ = token::code::http2_setting;
+    token_size_ = 6;
+}
+
+inline void http2_frame::fail(token::code::value code)
+{
+    state = ERRORED;
+    code_ = code;
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
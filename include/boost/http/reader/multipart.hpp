@@ -0,0 +1,120 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_MULTIPART_HPP
+#define BOOST_HTTP_READER_MULTIPART_HPP
+
+// private
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/http/syntax/crlf.hpp>
+#include <boost/http/syntax/ows.hpp>
+#include <boost/http/syntax/field_name.hpp>
+#include <boost/http/syntax/field_value.hpp>
+#include <boost/http/detail/macros.hpp>
+#include <boost/http/reader/detail/abnf.hpp>
+#include <boost/http/reader/detail/common.hpp>
+#include <boost/http/reader/detail/boundary_searcher.hpp>
+
+// public
+
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Reads a multipart body (RFC2046, RFC7578) out of the `body_chunk` tokens of
+   a message. Each part is reported as `field_name`/`field_value` tokens
+   followed by `end_of_headers`, `body_chunk` tokens and `end_of_body`. The
+   close delimiter is reported as `end_of_message` and the preamble/epilogue
+   are reported as `skip`.
+
+   Part data is never buffered: a `body_chunk` token is delivered as soon as
+   it's known not to be part of the delimiter, so the bytes left unread at the
+   end of the buffer are always fewer than the delimiter size. */
+class multipart
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef const char value_type;
+    typedef value_type *pointer;
+    typedef boost::string_view view_type;
+
+    /* `boundary` is copied, so it doesn't need to outlive the reader. An
+       invalid boundary puts the reader into the `error_invalid_data` state. */
+    explicit multipart(view_type boundary);
+
+    // The boundary is kept
+    void reset();
+
+    // Inspect current token
+    token::code::value code() const;
+    token::symbol::value symbol() const;
+    token::category::value category() const;
+    size_type token_size() const;
+    template<class T>
+    typename T::type value() const;
+
+    token::code::value expected_token() const;
+
+    // Consumes current element and goes to the next one
+    void next();
+
+    /**
+     * It's expected that unread bytes from previous buffer will be present at
+     * the beginning of \p inbuffer (i.e. you MUST NOT discard unread bytes from
+     * previous buffer).
+     */
+    void set_buffer(asio::const_buffer inbuffer);
+
+    size_type parsed_count() const;
+
+private:
+    enum State {
+        ERRORED,
+        EXPECT_FIRST_BOUNDARY,
+        EXPECT_PREAMBLE,
+        EXPECT_BOUNDARY_SUFFIX,
+        EXPECT_FIELD_NAME,
+        EXPECT_COLON,
+        EXPECT_OWS_AFTER_COLON,
+        EXPECT_FIELD_VALUE,
+        EXPECT_CRLF_AFTER_FIELD_VALUE,
+        EXPECT_CRLF_AFTER_HEADERS,
+        EXPECT_BODY,
+        EXPECT_DELIMITER,
+        EXPECT_END_OF_MESSAGE,
+        EXPECT_EPILOGUE
+    };
+
+    detail::boundary_searcher delimiter;
+
+    State state;
+
+    /* Once `next()` is called to start reading a new token, `code_` must
+       immediately change to `error_insufficient_data` and only change once the
+       new token has been completely read (or erroed).*/
+    token::code::value code_;
+
+    /* `idx` always point to the beginning of the currently being parsed token
+       in the buffer. */
+    size_type idx;
+
+    size_type token_size_;
+    boost::asio::const_buffer ibuffer;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "multipart.ipp"
+
+#endif // BOOST_HTTP_READER_MULTIPART_HPP
@@ -0,0 +1,392 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline multipart::multipart(view_type boundary)
+    : state(EXPECT_FIRST_BOUNDARY)
+    , code_(token::code::error_insufficient_data)
+    , idx(0)
+    , token_size_(0)
+{
+    if (!delimiter.assign(boundary)) {
+        state = ERRORED;
+        code_ = token::code::error_invalid_data;
+    }
+}
+
+inline void multipart::reset()
+{
+    if (delimiter.size() == 0)
+        return;
+
+    state = EXPECT_FIRST_BOUNDARY;
+    code_ = token::code::error_insufficient_data;
+    idx = 0;
+    token_size_ = 0;
+    ibuffer = asio::const_buffer();
+}
+
+inline token::code::value multipart::code() const
+{
+    return code_;
+}
+
+inline token::symbol::value multipart::symbol() const
+{
+    return token::symbol::convert(code_);
+}
+
+inline token::category::value multipart::category() const
+{
+    return token::category::convert(code_);
+}
+
+inline multipart::size_type multipart::token_size() const
+{
+    return token_size_;
+}
+
+template<>
+inline multipart::view_type multipart::value<token::field_name>() const
+{
+    assert(code_ == token::field_name::code);
+    return view_type(static_cast<const char*>(ibuffer.data()) + idx,
+                     token_size_);
+}
+
+template<>
+inline multipart::view_type multipart::value<token::field_value>() const
+{
+    assert(code_ == token::field_value::code);
+    view_type raw(static_cast<const char*>(ibuffer.data()) + idx, token_size_);
+    return detail::decode_field_value(raw);
+}
+
+template<>
+inline asio::const_buffer multipart::value<token::body_chunk>() const
+{
+    assert(code_ == token::body_chunk::code);
+    return asio::buffer(ibuffer + idx, token_size_);
+}
+
+inline token::code::value multipart::expected_token() const
+{
+    switch (state) {
+    case ERRORED:
+        return code_;
+    case EXPECT_FIRST_BOUNDARY:
+    case EXPECT_PREAMBLE:
+    case EXPECT_BOUNDARY_SUFFIX:
+    case EXPECT_COLON:
+    case EXPECT_OWS_AFTER_COLON:
+    case EXPECT_CRLF_AFTER_FIELD_VALUE:
+    case EXPECT_DELIMITER:
+    case EXPECT_EPILOGUE:
+        return token::code::skip;
+    case EXPECT_FIELD_NAME:
+        return token::code::field_name;
+    case EXPECT_FIELD_VALUE:
+        return token::code::field_value;
+    case EXPECT_CRLF_AFTER_HEADERS:
+        return token::code::end_of_headers;
+    case EXPECT_BODY:
+        return token::code::body_chunk;
+    case EXPECT_END_OF_MESSAGE:
+        return token::code::end_of_message;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void multipart::set_buffer(asio::const_buffer ibuffer)
+{
+    this->ibuffer = ibuffer;
+    idx = 0;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline multipart::size_type multipart::parsed_count() const
+{
+    return idx;
+}
+
+inline void multipart::next()
+{
+    if (state == ERRORED)
+        return;
+
+    // This is a 0-sized token. Therefore, it is handled sooner.
+    if (state == EXPECT_END_OF_MESSAGE) {
+        state = EXPECT_EPILOGUE;
+        code_ = token::code::end_of_message;
+        idx += token_size_;
+        token_size_ = 0;
+        return;
+    }
+
+    if (code_ != token::code::error_insufficient_data) {
+        idx += token_size_;
+        token_size_ = 0;
+        code_ = token::code::error_insufficient_data;
+    }
+
+    if (idx == ibuffer.size())
+        return;
+
+    asio::const_buffer rest_buf = ibuffer + idx;
+    basic_string_view<unsigned char>
+        rest_view(static_cast<const unsigned char*>(rest_buf.data()),
+                  rest_buf.size());
+
+    switch (state) {
+    case EXPECT_FIRST_BOUNDARY:
+        {
+            /* The first delimiter doesn't need to be preceded by CRLF if there
+               is no preamble. */
+            size_type n = delimiter.size() - 2;
+            size_type count = std::min(n, rest_view.size());
+            if (std::memcmp(rest_view.data(), delimiter.data() + 2, count)
+                != 0) {
+                state = EXPECT_PREAMBLE;
+                return next();
+            }
+
+            if (count != n)
+                return;
+
+            state = EXPECT_BOUNDARY_SUFFIX;
+            code_ = token::code::skip;
+            token_size_ = n;
+            return;
+        }
+    case EXPECT_PREAMBLE:
+        {
+            size_type i = delimiter.find(rest_view.data(), rest_view.size());
+
+            if (i != 0) {
+                code_ = token::code::skip;
+                token_size_ = i;
+                return;
+            }
+
+            if (rest_view.size() < delimiter.size())
+                return;
+
+            state = EXPECT_BOUNDARY_SUFFIX;
+            code_ = token::code::skip;
+            token_size_ = delimiter.size();
+            return;
+        }
+    case EXPECT_BOUNDARY_SUFFIX:
+        {
+            if (rest_view[0] == '-') {
+                if (rest_view.size() < 2)
+                    return;
+
+                if (rest_view[1] != '-') {
+                    state = ERRORED;
+                    code_ = token::code::error_invalid_data;
+                    return;
+                }
+
+                state = EXPECT_END_OF_MESSAGE;
+                code_ = token::code::skip;
+                token_size_ = 2;
+                return;
+            }
+
+            // transport-padding (section 5.1.1 of RFC2046)
+            typedef syntax::ows<unsigned char> ows;
+            typedef syntax::liberal_crlf<unsigned char> crlf;
+
+            std::size_t npadding = ows::match(rest_view);
+
+            switch (native_value(crlf::match(rest_view.substr(npadding)))) {
+            case crlf::result::crlf:
+                state = EXPECT_FIELD_NAME;
+                code_ = token::code::skip;
+                token_size_ = npadding + 2;
+                return;
+            case crlf::result::lf:
+                state = EXPECT_FIELD_NAME;
+                code_ = token::code::skip;
+                token_size_ = npadding + 1;
+                return;
+            case crlf::result::insufficient_data:
+                return;
+            case crlf::result::invalid_data:
+                state = ERRORED;
+                code_ = token::code::error_invalid_data;
+                return;
+            }
+            BOOST_HTTP_DETAIL_UNREACHABLE("The crlf switch is exhaustive");
+            return;
+        }
+    case EXPECT_FIELD_NAME:
+        {
+            typedef syntax::field_name<unsigned char> field_name;
+
+            std::size_t nmatched = field_name::match(rest_view);
+
+            if (nmatched == 0) {
+                state = EXPECT_CRLF_AFTER_HEADERS;
+                return next();
+            }
+
+            if (nmatched == rest_view.size())
+                return;
+
+            state = EXPECT_COLON;
+            code_ = token::code::field_name;
+            token_size_ = nmatched;
+            return;
+        }
+    case EXPECT_COLON:
+        {
+            unsigned char c
+                = static_cast<const unsigned char*>(ibuffer.data())[idx];
+            if (c != ':') {
+                state = ERRORED;
+                code_ = token::code::error_invalid_data;
+                return;
+            }
+            state = EXPECT_OWS_AFTER_COLON;
+            code_ = token::code::skip;
+
+            size_type i = idx + 1;
+            for ( ; i != ibuffer.size() ; ++i) {
+                unsigned char c
+                    = static_cast<const unsigned char*>(ibuffer.data())[i];
+                if (!detail::is_ows(c)) {
+                    state = EXPECT_FIELD_VALUE;
+                    break;
+                }
+            }
+            token_size_ = i - idx;
+            return;
+        }
+    case EXPECT_OWS_AFTER_COLON:
+        {
+            typedef syntax::ows<unsigned char> ows;
+
+            std::size_t nmatched = ows::match(rest_view);
+
+            if (nmatched == 0) {
+                state = EXPECT_FIELD_VALUE;
+                return next();
+            }
+
+            code_ = token::code::skip;
+            token_size_ = nmatched;
+            return;
+        }
+    case EXPECT_FIELD_VALUE:
+        {
+            typedef syntax::left_trimmed_field_value<unsigned char> field_value;
+
+            std::size_t nmatched = field_value::match(rest_view);
+
+            if (nmatched == rest_view.size())
+                return;
+
+            state = EXPECT_CRLF_AFTER_FIELD_VALUE;
+            code_ = token::code::field_value;
+            token_size_ = nmatched;
+            return;
+        }
+    case EXPECT_CRLF_AFTER_FIELD_VALUE:
+        {
+            typedef syntax::liberal_crlf<unsigned char> crlf;
+
+            switch (native_value(crlf::match(rest_view))) {
+            case crlf::result::crlf:
+                state = EXPECT_FIELD_NAME;
+                code_ = token::code::skip;
+                token_size_ = 2;
+                return;
+            case crlf::result::lf:
+                state = EXPECT_FIELD_NAME;
+                code_ = token::code::skip;
+                token_size_ = 1;
+                return;
+            case crlf::result::insufficient_data:
+                return;
+            case crlf::result::invalid_data:
+                state = ERRORED;
+                code_ = token::code::error_invalid_data;
+                return;
+            }
+            BOOST_HTTP_DETAIL_UNREACHABLE("The crlf switch is exhaustive");
+            return;
+        }
+    case EXPECT_CRLF_AFTER_HEADERS:
+        {
+            typedef syntax::liberal_crlf<unsigned char> crlf;
+
+            switch (native_value(crlf::match(rest_view))) {
+            case crlf::result::crlf:
+                token_size_ = 2;
+                break;
+            case crlf::result::lf:
+                token_size_ = 1;
+                break;
+            case crlf::result::insufficient_data:
+                return;
+            case crlf::result::invalid_data:
+                state = ERRORED;
+                code_ = token::code::error_invalid_data;
+                return;
+            }
+
+            state = EXPECT_BODY;
+            code_ = token::code::end_of_headers;
+            return;
+        }
+    case EXPECT_BODY:
+        {
+            size_type i = delimiter.find(rest_view.data(), rest_view.size());
+
+            if (i != 0) {
+                code_ = token::code::body_chunk;
+                token_size_ = i;
+                return;
+            }
+
+            // Only a prefix of the delimiter is available
+            if (rest_view.size() < delimiter.size())
+                return;
+
+            state = EXPECT_DELIMITER;
+            code_ = token::code::end_of_body;
+            return;
+        }
+    case EXPECT_DELIMITER:
+        if (rest_view.size() < delimiter.size())
+            return;
+
+        state = EXPECT_BOUNDARY_SUFFIX;
+        code_ = token::code::skip;
+        token_size_ = delimiter.size();
+        return;
+    case EXPECT_END_OF_MESSAGE:
+        BOOST_HTTP_DETAIL_UNREACHABLE("This state is handled sooner");
+        return;
+    case EXPECT_EPILOGUE:
+        code_ = token::code::skip;
+        token_size_ = rest_view.size();
+        return;
+    case ERRORED:
+        BOOST_HTTP_DETAIL_UNREACHABLE("This state is handled sooner");
+    }
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
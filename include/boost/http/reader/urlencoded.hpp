@@ -0,0 +1,114 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_URLENCODED_HPP
+#define BOOST_HTTP_READER_URLENCODED_HPP
+
+// private
+
+#include <boost/http/syntax/percent_decode.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Reads an application/x-www-form-urlencoded body incrementally. Every
+   `key=value` pair is reported as a `field_name` token followed by a
+   `field_value` token once the whole pair is available (i.e. once the next
+   `'&'` or the end of the input is found). The separators are reported as
+   `skip` and the end of the input as `end_of_message`.
+
+   Keys and values are percent-decoded in place (hence the mutable buffer), so
+   nothing is copied and nothing but the unfinished pair needs to be kept
+   around. */
+class urlencoded
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef char value_type;
+    typedef value_type *pointer;
+    typedef boost::string_view view_type;
+
+    urlencoded();
+
+    void reset();
+
+    // Inspect current token
+    token::code::value code() const;
+    token::symbol::value symbol() const;
+    token::category::value category() const;
+    size_type token_size() const;
+    template<class T>
+    typename T::type value() const;
+
+    token::code::value expected_token() const;
+
+    // Consumes current element and goes to the next one
+    void next();
+
+    /**
+     * It's expected that unread bytes from previous buffer will be present at
+     * the beginning of \p inbuffer (i.e. you MUST NOT discard unread bytes from
+     * previous buffer).
+     */
+    void set_buffer(asio::mutable_buffer inbuffer);
+
+    /* Signals that no more data follows the current buffer (e.g. the request
+       reader reached `end_of_body`), so the last pair can be delivered. The
+       reader goes back to its initial state after `end_of_message`. */
+    void put_eof();
+
+    size_type parsed_count() const;
+
+private:
+    enum State {
+        ERRORED,
+        EXPECT_FIELD_NAME,
+        EXPECT_EQUALS_SIGN,
+        EXPECT_FIELD_VALUE,
+        EXPECT_AMPERSAND,
+        EXPECT_END_OF_MESSAGE
+    };
+
+    bool decode(size_type size);
+
+    State state;
+    bool eof;
+
+    token::code::value code_;
+
+    /* `idx` always point to the beginning of the currently being parsed token
+       in the buffer. */
+    size_type idx;
+
+    /* if `code_ == error_insufficient_data`, token_size_ has the amount of data
+       already scanned for the `'&'` delimiter. Otherwise, it contains the token
+       size. */
+    size_type token_size_;
+
+    // Size of the current token after percent-decoding
+    size_type value_size;
+
+    // Bytes of the current pair that follow `idx`
+    size_type pair_size;
+
+    asio::mutable_buffer ibuffer;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "urlencoded.ipp"
+
+#endif // BOOST_HTTP_READER_URLENCODED_HPP
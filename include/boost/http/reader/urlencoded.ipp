@@ -0,0 +1,230 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline urlencoded::urlencoded()
+    : state(EXPECT_FIELD_NAME)
+    , eof(false)
+    , code_(token::code::error_insufficient_data)
+    , idx(0)
+    , token_size_(0)
+    , value_size(0)
+    , pair_size(0)
+{}
+
+inline void urlencoded::reset()
+{
+    state = EXPECT_FIELD_NAME;
+    eof = false;
+    code_ = token::code::error_insufficient_data;
+    idx = 0;
+    token_size_ = 0;
+    value_size = 0;
+    pair_size = 0;
+    ibuffer = asio::mutable_buffer();
+}
+
+inline token::code::value urlencoded::code() const
+{
+    return code_;
+}
+
+inline token::symbol::value urlencoded::symbol() const
+{
+    return token::symbol::convert(code_);
+}
+
+inline token::category::value urlencoded::category() const
+{
+    return token::category::convert(code_);
+}
+
+inline urlencoded::size_type urlencoded::token_size() const
+{
+    return token_size_;
+}
+
+template<>
+inline urlencoded::view_type urlencoded::value<token::field_name>() const
+{
+    assert(code_ == token::field_name::code);
+    return view_type(static_cast<const char*>(ibuffer.data()) + idx,
+                     value_size);
+}
+
+template<>
+inline urlencoded::view_type urlencoded::value<token::field_value>() const
+{
+    assert(code_ == token::field_value::code);
+    return view_type(static_cast<const char*>(ibuffer.data()) + idx,
+                     value_size);
+}
+
+inline token::code::value urlencoded::expected_token() const
+{
+    switch (state) {
+    case ERRORED:
+        return code_;
+    case EXPECT_FIELD_NAME:
+        return token::code::field_name;
+    case EXPECT_EQUALS_SIGN:
+    case EXPECT_AMPERSAND:
+        return token::code::skip;
+    case EXPECT_FIELD_VALUE:
+        return token::code::field_value;
+    case EXPECT_END_OF_MESSAGE:
+        return token::code::end_of_message;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void urlencoded::set_buffer(asio::mutable_buffer ibuffer)
+{
+    this->ibuffer = ibuffer;
+    idx = 0;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline void urlencoded::put_eof()
+{
+    eof = true;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline urlencoded::size_type urlencoded::parsed_count() const
+{
+    return idx;
+}
+
+inline bool urlencoded::decode(size_type size)
+{
+    typedef syntax::percent_decode<char> percent_decode;
+
+    char *data = static_cast<char*>(ibuffer.data()) + idx;
+
+    switch (native_value(percent_decode::decode_form(view_type(data, size),
+                                                     data, value_size))) {
+    case percent_decode::result::ok:
+        return true;
+    case percent_decode::result::invalid_escape:
+    case percent_decode::result::encoded_nul:
+        state = ERRORED;
+        code_ = token::code::error_invalid_data;
+        return false;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void urlencoded::next()
+{
+    if (state == ERRORED)
+        return;
+
+    // This is a 0-sized token. Therefore, it is handled sooner.
+    if (state == EXPECT_END_OF_MESSAGE) {
+        state = EXPECT_FIELD_NAME;
+        eof = false;
+        code_ = token::code::end_of_message;
+        idx += token_size_;
+        token_size_ = 0;
+        return;
+    }
+
+    if (code_ != token::code::error_insufficient_data) {
+        idx += token_size_;
+        token_size_ = 0;
+        code_ = token::code::error_insufficient_data;
+    }
+
+    const char *rest = static_cast<const char*>(ibuffer.data()) + idx;
+    const char *end = rest + (ibuffer.size() - idx);
+
+    switch (state) {
+    case EXPECT_FIELD_NAME:
+        {
+            // Bytes already scanned on a previous call are not scanned again
+            const char *amp = http::detail::find(rest + token_size_, end, '&');
+
+            if (amp == end) {
+                if (!eof) {
+                    token_size_ = end - rest;
+                    return;
+                }
+
+                if (rest == end) {
+                    state = EXPECT_END_OF_MESSAGE;
+                    return next();
+                }
+            }
+
+            pair_size = amp - rest;
+
+            // Empty pairs (e.g. "a=1&&b=2") are ignored
+            if (pair_size == 0) {
+                code_ = token::code::skip;
+                token_size_ = 1;
+                return;
+            }
+
+            const char *eq = http::detail::find(rest, amp, '=');
+            size_type key_size = eq - rest;
+
+            if (!decode(key_size))
+                return;
+
+            state = (eq == amp) ? EXPECT_FIELD_VALUE : EXPECT_EQUALS_SIGN;
+            code_ = token::code::field_name;
+            token_size_ = key_size;
+            pair_size -= key_size;
+            return;
+        }
+    case EXPECT_EQUALS_SIGN:
+        state = EXPECT_FIELD_VALUE;
+        code_ = token::code::skip;
+        token_size_ = 1;
+        --pair_size;
+        return;
+    case EXPECT_FIELD_VALUE:
+        // A pair without `'='` has an empty value
+        if (!decode(pair_size))
+            return;
+
+        state = EXPECT_AMPERSAND;
+        code_ = token::code::field_value;
+        token_size_ = pair_size;
+        pair_size = 0;
+        return;
+    case EXPECT_AMPERSAND:
+        if (rest == end) {
+            if (!eof)
+                return;
+
+            // The pair was delimited by the end of the input
+            state = EXPECT_END_OF_MESSAGE;
+            return next();
+        }
+
+        state = EXPECT_FIELD_NAME;
+        code_ = token::code::skip;
+        token_size_ = 1;
+        return;
+    case EXPECT_END_OF_MESSAGE:
+    case ERRORED:
+        BOOST_HTTP_DETAIL_UNREACHABLE("This state is handled sooner");
+    }
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
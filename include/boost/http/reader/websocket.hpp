@@ -0,0 +1,144 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_READER_WEBSOCKET_HPP
+#define BOOST_HTTP_READER_WEBSOCKET_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+namespace reader {
+
+/* Reads the WebSocket framing (section 5 of RFC6455) that follows a successful
+   upgrade (i.e. the bytes left in the buffer after the request reader's
+   `end_of_message` plus whatever comes next from the socket).
+
+   Every frame is reported as a `websocket_frame` token (the frame header),
+   followed by `body_chunk` tokens for the payload. A `end_of_message` token
+   follows the payload of every frame with the FIN bit set, so a fragmented
+   message is reported as a single message (control frames, which can't be
+   fragmented, are messages of their own and may appear between the fragments
+   of a data message).
+
+   Payloads of masked frames are unmasked in place (hence the mutable buffer)
+   before being delivered. Text payloads are not validated as UTF-8. */
+class websocket
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef unsigned char value_type;
+    typedef value_type *pointer;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(role)
+    {
+        // frames sent by clients are masked
+        server,
+        // frames sent by servers are not masked
+        client
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(role)
+
+    // Largest frame header (2 + 8 bytes of extended length + 4 bytes of mask)
+    static const size_type max_header_size = 14;
+
+    explicit websocket(role r = role::server);
+
+    // The role and the limits set by the user are kept
+    void reset();
+
+    // Inspect current token
+    token::code::value code() const;
+    token::symbol::value symbol() const;
+    token::category::value category() const;
+    size_type token_size() const;
+    template<class T>
+    typename T::type value() const;
+
+    token::code::value expected_token() const;
+
+    // Consumes current element and goes to the next one
+    void next();
+
+    /**
+     * It's expected that unread bytes from previous buffer will be present at
+     * the beginning of \p inbuffer (i.e. you MUST NOT discard unread bytes from
+     * previous buffer).
+     */
+    void set_buffer(asio::mutable_buffer inbuffer);
+
+    size_type parsed_count() const;
+
+    /* Frames whose payload is bigger than `size` are rejected with
+       `error_frame_too_big`. 0 (the default) means no limit. */
+    void set_max_payload_size(uint_least64_t size);
+    uint_least64_t max_payload_size() const;
+
+    /* Accepts the RSV1 bit on the first frame of data messages (the bit is
+       claimed by the permessage-deflate extension, section 6 of RFC7692). Any
+       other reserved bit is always an error. */
+    void set_rsv1_allowed(bool allowed);
+    bool rsv1_allowed() const;
+
+private:
+    enum State {
+        ERRORED,
+        EXPECT_FRAME,
+        EXPECT_PAYLOAD,
+        EXPECT_END_OF_MESSAGE
+    };
+
+    void parse_frame();
+    void fail(token::code::value code);
+
+    role role_;
+    uint_least64_t max_payload_size_;
+    bool rsv1_allowed_;
+
+    State state;
+
+    token::code::value code_;
+
+    /* `idx` always point to the beginning of the currently being parsed token
+       in the buffer. */
+    size_type idx;
+
+    size_type token_size_;
+
+    // Current frame
+    token::websocket_frame::type frame;
+    bool masked;
+    unsigned char mask[4];
+
+    // Payload bytes of the current frame not yet delivered
+    uint_least64_t remaining;
+
+    // A data message was started by a frame without the FIN bit
+    bool fragmented;
+
+    asio::mutable_buffer ibuffer;
+};
+
+} // namespace reader
+} // namespace http
+} // namespace boost
+
+#include "websocket.ipp"
+
+#endif // BOOST_HTTP_READER_WEBSOCKET_HPP
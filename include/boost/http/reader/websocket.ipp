@@ -0,0 +1,280 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace reader {
+
+inline websocket::websocket(role r)
+    : role_(r)
+    , max_payload_size_(0)
+    , rsv1_allowed_(false)
+    , state(EXPECT_FRAME)
+    , code_(token::code::error_insufficient_data)
+    , idx(0)
+    , token_size_(0)
+    , masked(false)
+    , remaining(0)
+    , fragmented(false)
+{
+    frame.fin = false;
+    frame.rsv1 = false;
+    frame.opcode = token::websocket_frame::opcode::continuation;
+    frame.payload_size = 0;
+}
+
+inline void websocket::reset()
+{
+    state = EXPECT_FRAME;
+    code_ = token::code::error_insufficient_data;
+    idx = 0;
+    token_size_ = 0;
+    remaining = 0;
+    fragmented = false;
+    ibuffer = asio::mutable_buffer();
+}
+
+inline token::code::value websocket::code() const
+{
+    return code_;
+}
+
+inline token::symbol::value websocket::symbol() const
+{
+    return token::symbol::convert(code_);
+}
+
+inline token::category::value websocket::category() const
+{
+    return token::category::convert(code_);
+}
+
+inline websocket::size_type websocket::token_size() const
+{
+    return token_size_;
+}
+
+template<>
+inline token::websocket_frame::type
+websocket::value<token::websocket_frame>() const
+{
+    assert(code_ == token::websocket_frame::code);
+    return frame;
+}
+
+template<>
+inline asio::const_buffer websocket::value<token::body_chunk>() const
+{
+    assert(code_ == token::body_chunk::code);
+    return asio::buffer(static_cast<const value_type*>(ibuffer.data()) + idx,
+                        token_size_);
+}
+
+inline token::code::value websocket::expected_token() const
+{
+    switch (state) {
+    case ERRORED:
+        return code_;
+    case EXPECT_FRAME:
+        return token::code::websocket_frame;
+    case EXPECT_PAYLOAD:
+        return token::code::body_chunk;
+    case EXPECT_END_OF_MESSAGE:
+        return token::code::end_of_message;
+    }
+
+    BOOST_HTTP_DETAIL_UNREACHABLE("");
+}
+
+inline void websocket::set_buffer(asio::mutable_buffer ibuffer)
+{
+    this->ibuffer = ibuffer;
+    idx = 0;
+
+    if (code_ == token::code::error_insufficient_data)
+        next();
+}
+
+inline websocket::size_type websocket::parsed_count() const
+{
+    return idx;
+}
+
+inline void websocket::set_max_payload_size(uint_least64_t size)
+{
+    max_payload_size_ = size;
+}
+
+inline uint_least64_t websocket::max_payload_size() const
+{
+    return max_payload_size_;
+}
+
+inline void websocket::set_rsv1_allowed(bool allowed)
+{
+    rsv1_allowed_ = allowed;
+}
+
+inline bool websocket::rsv1_allowed() const
+{
+    return rsv1_allowed_;
+}
+
+inline void websocket::next()
+{
+    if (state == ERRORED)
+        return;
+
+    // This is a 0-sized token. Therefore, it is handled sooner.
+    if (state == EXPECT_END_OF_MESSAGE) {
+        state = EXPECT_FRAME;
+        code_ = token::code::end_of_message;
+        idx += token_size_;
+        token_size_ = 0;
+        return;
+    }
+
+    if (code_ != token::code::error_insufficient_data) {
+        idx += token_size_;
+        token_size_ = 0;
+        code_ = token::code::error_insufficient_data;
+    }
+
+    switch (state) {
+    case EXPECT_FRAME:
+        parse_frame();
+        return;
+    case EXPECT_PAYLOAD:
+        {
+            if (remaining == 0) {
+                state = frame.fin ? EXPECT_END_OF_MESSAGE : EXPECT_FRAME;
+                return next();
+            }
+
+            size_type n = static_cast<size_type>(
+                std::min<uint_least64_t>(remaining, ibuffer.size() - idx));
+            if (n == 0)
+                return;
+
+            if (masked) {
+                // The key keeps rotating across the chunks of the same frame
+                value_type *data = static_cast<value_type*>(ibuffer.data())
+                    + idx;
+                http::detail::xor_mask(
+                    data, n, mask,
+                    static_cast<size_type>(frame.payload_size - remaining));
+            }
+
+            remaining -= n;
+            code_ = token::code::body_chunk;
+            token_size_ = n;
+            return;
+        }
+    case EXPECT_END_OF_MESSAGE:
+    case ERRORED:
+        BOOST_HTTP_DETAIL_UNREACHABLE("This state is handled sooner");
+    }
+}
+
+inline void websocket::parse_frame()
+{
+    typedef token::websocket_frame::opcode opcode;
+
+    const value_type *rest = static_cast<const value_type*>(ibuffer.data())
+        + idx;
+    size_type avail = ibuffer.size() - idx;
+
+    if (avail < 2)
+        return;
+
+    bool fin = rest[0] & 0x80;
+    bool rsv1 = rest[0] & 0x40;
+    unsigned op = rest[0] & 0x0F;
+    bool mask_bit = rest[1] & 0x80;
+    unsigned length7 = rest[1] & 0x7F;
+
+    /* The first two bytes are enough to reject most of the invalid frames, so
+       there is no need to wait for the rest of the header. */
+    if (rest[0] & 0x30)
+        return fail(token::code::error_invalid_data);
+
+    bool control = op & 0x8;
+
+    switch (op) {
+    case opcode::continuation:
+        if (!fragmented || rsv1)
+            return fail(token::code::error_invalid_data);
+        break;
+    case opcode::text:
+    case opcode::binary:
+        if (fragmented || (rsv1 && !rsv1_allowed_))
+            return fail(token::code::error_invalid_data);
+        break;
+    case opcode::close:
+    case opcode::ping:
+    case opcode::pong:
+        // section 5.5 of RFC6455
+        if (!fin || rsv1 || length7 > 125)
+            return fail(token::code::error_invalid_data);
+        break;
+    default:
+        return fail(token::code::error_invalid_data);
+    }
+
+    if (mask_bit != (native_value(role_) == role::server))
+        return fail(token::code::error_invalid_data);
+
+    size_type length_size = 0;
+    if (length7 == 126)
+        length_size = 2;
+    else if (length7 == 127)
+        length_size = 8;
+
+    size_type header_size = 2 + length_size + (mask_bit ? 4 : 0);
+
+    if (avail < header_size)
+        return;
+
+    uint_least64_t payload_size = length7;
+    if (length_size != 0) {
+        payload_size = 0;
+        for (size_type i = 0 ; i != length_size ; ++i)
+            payload_size = (payload_size << 8) | rest[2 + i];
+
+        // The most significant bit MUST be 0 (section 5.2 of RFC6455)
+        if (payload_size >> 63)
+            return fail(token::code::error_invalid_data);
+    }
+
+    if (max_payload_size_ != 0 && payload_size > max_payload_size_)
+        return fail(token::code::error_frame_too_big);
+
+    if (mask_bit)
+        std::copy(rest + 2 + length_size, rest + header_size, mask);
+
+    if (!control)
+        fragmented = !fin;
+
+    frame.fin = fin;
+    frame.rsv1 = rsv1;
+    frame.opcode = static_cast<opcode::value>(op);
+    frame.payload_size = payload_size;
+    masked = mask_bit;
+    remaining = payload_size;
+
+    state = EXPECT_PAYLOAD;
+    code_ = token::code::websocket_frame;
+    token_size_ = header_size;
+}
+
+inline void websocket::fail(token::code::value code)
+{
+    state = ERRORED;
+    code_ = code;
+}
+
+} // namespace reader
+} // namespace http
+} // namespace boost
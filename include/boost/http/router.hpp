@@ -0,0 +1,113 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_ROUTER_HPP
+#define BOOST_HTTP_ROUTER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/method.hpp>
+
+namespace boost {
+namespace http {
+
+/* A compressed radix tree mapping paths to handlers. Routes are added at setup
+   time (which allocates) and lookups never allocate. */
+template<class Handler>
+class router
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef boost::string_view view_type;
+
+    struct param
+    {
+        view_type name;
+        view_type value;
+    };
+
+    router();
+
+    /* `pattern` is an absolute path whose segments may be `{name}` captures
+       (e.g. "/users/{id}/posts"). It returns `false` if the pattern is invalid
+       or if it conflicts with a previously added route. */
+    bool add(method::value m, view_type pattern, const Handler &handler);
+
+    /* `target` is matched up to its query component, so the raw request target
+       may be used. Captures are views into `target`. `max_params` must be at
+       least `max_captures()`. */
+    const Handler *match(method::value m, view_type target, param *params,
+                         size_type max_params, size_type &nparams) const;
+
+    // Number of routes
+    size_type size() const;
+
+    // Number of captures of the route with the most captures
+    size_type max_captures() const;
+
+private:
+    static const size_type npos = size_type(-1);
+
+    struct node
+    {
+        node(size_type label_first, size_type label_size);
+
+        // Label of this node within `labels`
+        size_type label_first;
+        size_type label_size;
+
+        /* Static children within `child_bytes` and `child_nodes`. The first
+           byte of each child label is kept apart, so the child to follow is
+           found without touching the children nodes. */
+        size_type children_first;
+        size_type children_size;
+
+        size_type param_child;
+
+        // Per-method leaf table (indexes into `handlers`)
+        size_type leaves[method::other + 1];
+    };
+
+    view_type label(size_type n) const;
+
+    static bool valid_pattern(view_type pattern);
+    bool conflicts(method::value m, view_type pattern) const;
+
+    size_type new_node(view_type label);
+    void add_child(size_type n, char first_byte, size_type child);
+    size_type find_child(size_type n, char first_byte) const;
+    size_type find_static(size_type n, view_type s) const;
+    size_type insert_static(size_type n, view_type s);
+
+    bool match_node(size_type n, const char *first, const char *last,
+                    method::value m, param *params, size_type max_params,
+                    size_type depth, size_type &nparams,
+                    const Handler *&out) const;
+
+    std::string labels;
+    std::vector<node> nodes;
+    std::vector<Handler> handlers;
+
+    // The static children of every node (each node's children are contiguous)
+    std::string child_bytes;
+    std::vector<size_type> child_nodes;
+
+    size_type max_captures_;
+};
+
+} // namespace http
+} // namespace boost
+
+#include "router.ipp"
+
+#endif // BOOST_HTTP_ROUTER_HPP
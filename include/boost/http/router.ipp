@@ -0,0 +1,334 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+template<class Handler>
+const typename router<Handler>::size_type router<Handler>::npos;
+
+template<class Handler>
+router<Handler>::node::node(size_type label_first, size_type label_size)
+    : label_first(label_first)
+    , label_size(label_size)
+    , children_first(0)
+    , children_size(0)
+    , param_child(npos)
+{
+    for (int i = 0 ; i != method::other + 1 ; ++i)
+        leaves[i] = npos;
+}
+
+template<class Handler>
+router<Handler>::router()
+    : max_captures_(0)
+{
+    nodes.push_back(node(0, 0));
+}
+
+template<class Handler>
+bool router<Handler>::add(method::value m, view_type pattern,
+                          const Handler &handler)
+{
+    // The tree is only touched once the route is known to be accepted
+    if (!valid_pattern(pattern) || conflicts(m, pattern))
+        return false;
+
+    size_type n = 0;
+    size_type captures = 0;
+
+    while (pattern.size()) {
+        size_type brace = pattern.find('{');
+        n = insert_static(n, pattern.substr(0, brace));
+
+        if (brace == view_type::npos)
+            break;
+
+        size_type close = pattern.find('}', brace);
+        if (nodes[n].param_child == npos) {
+            size_type child
+                = new_node(pattern.substr(brace + 1, close - brace - 1));
+            nodes[n].param_child = child;
+        }
+        n = nodes[n].param_child;
+
+        pattern.remove_prefix(close + 1);
+        ++captures;
+    }
+
+    nodes[n].leaves[m] = handlers.size();
+    handlers.push_back(handler);
+    max_captures_ = std::max(max_captures_, captures);
+    return true;
+}
+
+template<class Handler>
+const Handler *router<Handler>::match(method::value m, view_type target,
+                                      param *params, size_type max_params,
+                                      size_type &nparams) const
+{
+    const char *first = target.data();
+    const char *last = http::detail::find(first, first + target.size(), '?');
+    const Handler *ret = 0;
+
+    assert(max_params >= max_captures_);
+
+    nparams = 0;
+    match_node(0, first, last, m, params, max_params, 0, nparams, ret);
+    return ret;
+}
+
+template<class Handler>
+typename router<Handler>::size_type router<Handler>::size() const
+{
+    return handlers.size();
+}
+
+template<class Handler>
+typename router<Handler>::size_type router<Handler>::max_captures() const
+{
+    return max_captures_;
+}
+
+template<class Handler>
+typename router<Handler>::view_type router<Handler>::label(size_type n) const
+{
+    return view_type(labels.data() + nodes[n].label_first,
+                     nodes[n].label_size);
+}
+
+template<class Handler>
+typename router<Handler>::size_type router<Handler>::new_node(view_type label)
+{
+    nodes.push_back(node(labels.size(), label.size()));
+    labels.append(label.data(), label.size());
+    return nodes.size() - 1;
+}
+
+template<class Handler>
+void router<Handler>::add_child(size_type n, char first_byte, size_type child)
+{
+    node &nd = nodes[n];
+
+    /* The children of a node must stay contiguous, so they're moved to the end
+       unless they're already there. This only happens while adding routes and
+       the old copy is left unused. */
+    if (nd.children_first + nd.children_size != child_nodes.size()) {
+        size_type first = child_nodes.size();
+        for (size_type i = 0 ; i != nd.children_size ; ++i) {
+            char byte = child_bytes[nd.children_first + i];
+            size_type index = child_nodes[nd.children_first + i];
+            child_bytes.push_back(byte);
+            child_nodes.push_back(index);
+        }
+        nd.children_first = first;
+    }
+
+    child_bytes.push_back(first_byte);
+    child_nodes.push_back(child);
+    ++nd.children_size;
+}
+
+template<class Handler>
+typename router<Handler>::size_type
+router<Handler>::find_child(size_type n, char first_byte) const
+{
+    const node &nd = nodes[n];
+    const char *bytes = child_bytes.data() + nd.children_first;
+    const char *it = http::detail::find(bytes, bytes + nd.children_size,
+                                        first_byte);
+    if (it == bytes + nd.children_size)
+        return npos;
+
+    return nd.children_first + (it - bytes);
+}
+
+template<class Handler>
+bool router<Handler>::valid_pattern(view_type pattern)
+{
+    if (pattern.size() == 0 || pattern[0] != '/')
+        return false;
+
+    while (pattern.size()) {
+        size_type brace = pattern.find('{');
+
+        if (brace == view_type::npos)
+            break;
+
+        // A capture must span a whole segment
+        if (brace == 0 || pattern[brace - 1] != '/')
+            return false;
+
+        size_type close = pattern.find('}', brace);
+        if (close == view_type::npos || close == brace + 1)
+            return false;
+
+        if (close + 1 != pattern.size() && pattern[close + 1] != '/')
+            return false;
+
+        view_type name = pattern.substr(brace + 1, close - brace - 1);
+        if (name.find('/') != view_type::npos
+            || name.find('{') != view_type::npos) {
+            return false;
+        }
+
+        pattern.remove_prefix(close + 1);
+    }
+
+    return true;
+}
+
+template<class Handler>
+bool router<Handler>::conflicts(method::value m, view_type pattern) const
+{
+    size_type n = 0;
+
+    while (pattern.size()) {
+        size_type brace = pattern.find('{');
+        n = find_static(n, pattern.substr(0, brace));
+
+        // The route takes a new branch of the tree
+        if (n == npos)
+            return false;
+
+        if (brace == view_type::npos)
+            break;
+
+        if (nodes[n].param_child == npos)
+            return false;
+
+        size_type close = pattern.find('}', brace);
+        n = nodes[n].param_child;
+
+        /* The same position must be captured under the same name by every
+           route. */
+        if (label(n) != pattern.substr(brace + 1, close - brace - 1))
+            return true;
+
+        pattern.remove_prefix(close + 1);
+    }
+
+    return nodes[n].leaves[m] != npos;
+}
+
+template<class Handler>
+typename router<Handler>::size_type
+router<Handler>::find_static(size_type n, view_type s) const
+{
+    while (s.size()) {
+        size_type pos = find_child(n, s[0]);
+        if (pos == npos)
+            return npos;
+
+        size_type child = child_nodes[pos];
+        view_type l = label(child);
+
+        // A partial match would split `child`, so the node doesn't exist yet
+        if (s.size() < l.size() || s.substr(0, l.size()) != l)
+            return npos;
+
+        s.remove_prefix(l.size());
+        n = child;
+    }
+    return n;
+}
+
+template<class Handler>
+typename router<Handler>::size_type
+router<Handler>::insert_static(size_type n, view_type s)
+{
+    while (s.size()) {
+        size_type pos = find_child(n, s[0]);
+
+        if (pos == npos) {
+            size_type child = new_node(s);
+            add_child(n, s[0], child);
+            return child;
+        }
+
+        size_type child = child_nodes[pos];
+        view_type l = label(child);
+
+        size_type common = 0;
+        while (common != l.size() && common != s.size()
+               && l[common] == s[common]) {
+            ++common;
+        }
+
+        if (common != l.size()) {
+            /* Split the child. Labels are never moved within `labels`, so both
+               halves keep referencing the old label. */
+            size_type split = nodes.size();
+            nodes.push_back(node(nodes[child].label_first, common));
+            add_child(split, l[common], child);
+
+            nodes[child].label_first += common;
+            nodes[child].label_size -= common;
+
+            child_nodes[pos] = split;
+            child = split;
+        }
+
+        s.remove_prefix(common);
+        n = child;
+    }
+    return n;
+}
+
+template<class Handler>
+bool router<Handler>::match_node(size_type n, const char *first,
+                                 const char *last, method::value m,
+                                 param *params, size_type max_params,
+                                 size_type depth, size_type &nparams,
+                                 const Handler *&out) const
+{
+    const node &nd = nodes[n];
+
+    if (first == last) {
+        if (nd.leaves[m] == npos)
+            return false;
+
+        nparams = depth;
+        out = &handlers[nd.leaves[m]];
+        return true;
+    }
+
+    // Static segments take precedence over captures
+    if (nd.children_size) {
+        size_type pos = find_child(n, *first);
+
+        if (pos != npos) {
+            size_type child = child_nodes[pos];
+            view_type l = label(child);
+
+            if (size_type(last - first) >= l.size()
+                && std::memcmp(first, l.data(), l.size()) == 0
+                && match_node(child, first + l.size(), last, m, params,
+                              max_params, depth, nparams, out)) {
+                return true;
+            }
+        }
+    }
+
+    // `depth != max_params` only fails if `match()`'s precondition was broken
+    if (nd.param_child != npos && depth != max_params) {
+        const char *segment_end = http::detail::find(first, last, '/');
+
+        if (segment_end != first) {
+            params[depth].name = label(nd.param_child);
+            params[depth].value = view_type(first, segment_end - first);
+
+            if (match_node(nd.param_child, segment_end, last, m, params,
+                           max_params, depth + 1, nparams, out)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace http
+} // namespace boost
@@ -0,0 +1,130 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+std::size_t accept<CharT>::decode(view_type in, element &out)
+{
+    /* Accept = #( media-range [ accept-params ] )
+
+       media-range    = ( "*" "/" "*"
+                        / ( type "/" "*" )
+                        / ( type "/" subtype )
+                        ) *( OWS ";" OWS parameter )
+       accept-params  = weight *( accept-ext )
+
+       Section 5.3.2 of RFC7231. Invalid media-ranges are skipped. */
+    std::size_t consumed = 0;
+    detail::weighted_element<CharT> e;
+
+    while (std::size_t n = detail::decode_weighted_element(in, e)) {
+        consumed += n;
+        in.remove_prefix(n);
+
+        if (split(e.value, out.type, out.subtype)) {
+            out.parameters = e.parameters;
+            out.weight = e.weight;
+            return consumed;
+        }
+    }
+
+    return 0;
+}
+
+template<class CharT>
+std::size_t accept<CharT>::negotiate(view_type in, const view_type *offers,
+                                     std::size_t noffers)
+{
+    std::size_t best = noffers;
+    unsigned best_weight = 0;
+
+    for (std::size_t i = 0 ; i != noffers ; ++i) {
+        unsigned w = weight(in, offers[i]);
+        if (w > best_weight) {
+            best = i;
+            best_weight = w;
+        }
+    }
+
+    return best;
+}
+
+template<class CharT>
+bool accept<CharT>::split(view_type media_range, view_type &type,
+                          view_type &subtype)
+{
+    const CharT *first = media_range.data();
+    const CharT *last = first + media_range.size();
+    const CharT *slash = http::detail::find(first, last, '/');
+
+    if (slash == first || slash == last || slash + 1 == last)
+        return false;
+
+    type = view_type(first, slash - first);
+    subtype = view_type(slash + 1, last - slash - 1);
+
+    // "*/subtype" isn't a valid media-range
+    return !(type.size() == 1 && type[0] == '*')
+        || (subtype.size() == 1 && subtype[0] == '*');
+}
+
+template<class CharT>
+unsigned accept<CharT>::weight(view_type in, view_type offer)
+{
+    view_type type, subtype, parameters;
+    {
+        const CharT *first = offer.data();
+        const CharT *last = first + offer.size();
+        const CharT *semicolon = http::detail::find(first, last, ';');
+
+        if (!split(detail::trim_ows(first, semicolon), type, subtype))
+            return 0;
+
+        if (semicolon != last)
+            parameters = detail::trim_ows(semicolon + 1, last);
+    }
+
+    /* The most specific media-range matching the offer determines its weight
+       (section 5.3.2 of RFC7231). Media type parameters are compared as a
+       whole and case-insensitively. */
+    int best_specificity = 0;
+    unsigned ret = 0;
+
+    element e;
+    while (std::size_t n = decode(in, e)) {
+        in.remove_prefix(n);
+
+        int specificity;
+        if (e.type.size() == 1 && e.type[0] == '*') {
+            specificity = 1;
+        } else if (!detail::ascii_iequals(e.type, type)) {
+            continue;
+        } else if (e.subtype.size() == 1 && e.subtype[0] == '*') {
+            specificity = 2;
+        } else if (!detail::ascii_iequals(e.subtype, subtype)) {
+            continue;
+        } else if (e.parameters.size() == 0) {
+            specificity = 3;
+        } else if (detail::ascii_iequals(e.parameters, parameters)) {
+            specificity = 4;
+        } else {
+            continue;
+        }
+
+        if (specificity > best_specificity) {
+            best_specificity = specificity;
+            ret = e.weight;
+        }
+    }
+
+    return ret;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,49 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_ACCEPT_ENCODING_HPP
+#define BOOST_HTTP_SYNTAX_ACCEPT_ENCODING_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/syntax/detail/ascii_iequals.hpp>
+#include <boost/http/syntax/detail/weighted_element.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct accept_encoding {
+    typedef basic_string_view<CharT> view_type;
+
+    struct element
+    {
+        view_type coding;
+
+        // in thousandths (from 0 to 1000)
+        unsigned weight;
+    };
+
+    /* Extracts the first element from `in` and returns the number of elements
+       consumed. Returns 0 if there are no elements left. */
+    static std::size_t decode(view_type in, element &out);
+
+    /* Returns the index of the best coding within `offers` (ties are broken in
+       favour of the earliest offer) or `noffers` if none is acceptable. */
+    static std::size_t negotiate(view_type in, const view_type *offers,
+                                 std::size_t noffers);
+
+private:
+    static unsigned weight(view_type in, view_type coding);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "accept_encoding.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_ACCEPT_ENCODING_HPP
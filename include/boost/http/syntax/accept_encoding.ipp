@@ -0,0 +1,80 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+std::size_t accept_encoding<CharT>::decode(view_type in, element &out)
+{
+    /* Accept-Encoding  = #( codings [ weight ] )
+       codings          = content-coding / "identity" / "*"
+
+       Section 5.3.4 of RFC7231. */
+    detail::weighted_element<CharT> e;
+    std::size_t ret = detail::decode_weighted_element(in, e);
+    if (ret != 0) {
+        out.coding = e.value;
+        out.weight = e.weight;
+    }
+    return ret;
+}
+
+template<class CharT>
+std::size_t accept_encoding<CharT>::negotiate(view_type in,
+                                              const view_type *offers,
+                                              std::size_t noffers)
+{
+    std::size_t best = noffers;
+    unsigned best_weight = 0;
+
+    for (std::size_t i = 0 ; i != noffers ; ++i) {
+        unsigned w = weight(in, offers[i]);
+        if (w > best_weight) {
+            best = i;
+            best_weight = w;
+        }
+    }
+
+    return best;
+}
+
+template<class CharT>
+unsigned accept_encoding<CharT>::weight(view_type in, view_type coding)
+{
+    const CharT identity[] = {'i', 'd', 'e', 'n', 't', 'i', 't', 'y'};
+    const CharT asterisk[] = {'*'};
+
+    bool has_asterisk = false;
+    unsigned asterisk_weight = 0;
+
+    element e;
+    while (std::size_t n = decode(in, e)) {
+        in.remove_prefix(n);
+
+        if (detail::ascii_iequals(e.coding, coding))
+            return e.weight;
+
+        if (!has_asterisk && e.coding == view_type(asterisk, 1)) {
+            has_asterisk = true;
+            asterisk_weight = e.weight;
+        }
+    }
+
+    if (has_asterisk)
+        return asterisk_weight;
+
+    /* The identity coding is always acceptable unless explicitly refused, but
+       only with the lowest non-zero weight. */
+    if (detail::ascii_iequals(coding, view_type(identity, 8)))
+        return 1;
+
+    return 0;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,78 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_CACHE_CONTROL_HPP
+#define BOOST_HTTP_SYNTAX_CACHE_CONTROL_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/algorithm/header/header_value_list.hpp>
+#include <boost/http/syntax/content_length.hpp>
+#include <boost/http/syntax/detail/ascii_iequals.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct cache_control {
+    typedef basic_string_view<CharT> view_type;
+
+    struct directive
+    {
+        enum value
+        {
+            max_age                = 1 << 0,
+            s_maxage               = 1 << 1,
+            max_stale              = 1 << 2,
+            min_fresh              = 1 << 3,
+            stale_while_revalidate = 1 << 4,
+            stale_if_error         = 1 << 5,
+            no_cache               = 1 << 6,
+            no_store               = 1 << 7,
+            no_transform           = 1 << 8,
+            only_if_cached         = 1 << 9,
+            must_revalidate        = 1 << 10,
+            must_understand        = 1 << 11,
+            proxy_revalidate       = 1 << 12,
+            public_                = 1 << 13,
+            private_               = 1 << 14,
+            immutable              = 1 << 15
+        };
+    };
+
+    // Largest delta-seconds (section 1.2.1 of RFC7234)
+    static const unsigned long max_delta_seconds = 2147483648ul;
+
+    struct directives
+    {
+        // bitwise OR of the `directive::value` found
+        unsigned mask;
+
+        // delta-seconds (only meaningful if the matching bit is set)
+        unsigned long max_age;
+        unsigned long s_maxage;
+        unsigned long max_stale;
+        unsigned long min_fresh;
+        unsigned long stale_while_revalidate;
+        unsigned long stale_if_error;
+    };
+
+    /* Decodes the known directives from `in` into `out`. Unknown directives
+       and directives with an invalid argument are ignored. */
+    static void decode(view_type in, directives &out);
+
+private:
+    static bool decode_delta_seconds(view_type in, unsigned long &out);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "cache_control.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_CACHE_CONTROL_HPP
@@ -0,0 +1,149 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+namespace detail {
+
+/* Entries follow the order of `cache_control::directive::value`, so the bit
+   of an entry is `1 << index`. Directives taking delta-seconds come first and
+   in the same order as their fields in `cache_control::directives`. */
+struct cache_directive_entry
+{
+    const char *name;
+    std::size_t size;
+
+    // whether the directive takes a delta-seconds argument
+    bool delta_seconds;
+};
+
+template<class T = void>
+struct basic_cache_directive_table
+{
+    static const cache_directive_entry entries[16];
+};
+
+template<class T>
+const cache_directive_entry basic_cache_directive_table<T>::entries[16] = {
+    { "max-age",                7,  true },
+    { "s-maxage",               8,  true },
+    { "max-stale",              9,  true },
+    { "min-fresh",              9,  true },
+    { "stale-while-revalidate", 22, true },
+    { "stale-if-error",         14, true },
+    { "no-cache",               8,  false },
+    { "no-store",               8,  false },
+    { "no-transform",           12, false },
+    { "only-if-cached",         14, false },
+    { "must-revalidate",        15, false },
+    { "must-understand",        15, false },
+    { "proxy-revalidate",       16, false },
+    { "public",                 6,  false },
+    { "private",                7,  false },
+    { "immutable",              9,  false }
+};
+
+typedef basic_cache_directive_table<> cache_directive_table;
+
+} // namespace detail
+
+template<class CharT>
+const unsigned long cache_control<CharT>::max_delta_seconds;
+
+template<class CharT>
+void cache_control<CharT>::decode(view_type in, directives &out)
+{
+    /* Cache-Control   = 1#cache-directive
+       cache-directive = token [ "=" ( token / quoted-string ) ]
+
+       Section 5.2 of RFC7234. */
+    typedef header_value_list<view_type> list_type;
+    typedef detail::cache_directive_table table;
+
+    unsigned long *arguments[] = {
+        &out.max_age,
+        &out.s_maxage,
+        &out.max_stale,
+        &out.min_fresh,
+        &out.stale_while_revalidate,
+        &out.stale_if_error
+    };
+
+    out.mask = 0;
+    for (int i = 0 ; i != 6 ; ++i)
+        *arguments[i] = 0;
+
+    list_type list(in, true);
+    for (typename list_type::const_iterator it = list.begin()
+             ; it != list.end() ; ++it) {
+        const CharT *first = it->data();
+        const CharT *last = first + it->size();
+        const CharT *eq = http::detail::find(first, last, '=');
+
+        view_type name = detail::trim_ows(first, eq);
+        view_type argument;
+        if (eq != last) {
+            argument = detail::trim_ows(eq + 1, last);
+            if (argument.size() >= 2 && argument[0] == '"'
+                && argument[argument.size() - 1] == '"') {
+                argument = argument.substr(1, argument.size() - 2);
+            }
+        }
+
+        for (int i = 0 ; i != 16 ; ++i) {
+            const detail::cache_directive_entry &e = table::entries[i];
+            if (!detail::ascii_iequals(name, string_view(e.name, e.size)))
+                continue;
+
+            unsigned bit = 1u << i;
+
+            if (e.delta_seconds) {
+                unsigned long &value = *arguments[i];
+
+                if (eq == last) {
+                    // max-stale without argument accepts any staleness
+                    if (bit != directive::max_stale)
+                        break;
+
+                    value = max_delta_seconds;
+                } else if (!decode_delta_seconds(argument, value)) {
+                    break;
+                }
+            }
+
+            out.mask |= bit;
+            break;
+        }
+    }
+}
+
+template<class CharT>
+bool cache_control<CharT>::decode_delta_seconds(view_type in,
+                                                unsigned long &out)
+{
+    // delta-seconds = 1*DIGIT
+    typedef content_length<CharT> number;
+    typedef typename number::result number_result;
+
+    unsigned long value;
+    number_result r = number::decode(in, value);
+
+    if (r == number_result::invalid)
+        return false;
+
+    /* Bigger values (or values that overflow) are considered to be 2^31
+       (section 1.2.1 of RFC7234). */
+    if (r == number_result::overflow || value > max_delta_seconds)
+        value = max_delta_seconds;
+
+    out = value;
+    return true;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,44 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_COOKIE_HPP
+#define BOOST_HTTP_SYNTAX_COOKIE_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+/* Splits the Cookie header field value (section 5.4 of RFC6265) into its
+   cookie-pairs. Returned views point into the input and nothing is
+   allocated. */
+template<class CharT>
+struct cookie {
+    typedef basic_string_view<CharT> view_type;
+
+    /* Extracts the first cookie-pair from `in` and returns the number of
+       elements consumed (including the `';'` delimiter, if any). Returns 0 if
+       there are no more cookie-pairs left. */
+    static std::size_t decode(view_type in, view_type &name, view_type &value);
+
+    /* Looks for the first cookie named `name` and stops as soon as it is
+       found. Values of the cookies skipped on the way aren't trimmed. */
+    static bool find(view_type in, view_type name, view_type &value);
+
+private:
+    static view_type unquote(view_type value);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "cookie.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_COOKIE_HPP
@@ -0,0 +1,80 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+std::size_t cookie<CharT>::decode(view_type in, view_type &name,
+                                  view_type &value)
+{
+    /* cookie-string = cookie-pair *( ";" SP cookie-pair )
+       cookie-pair   = cookie-name "=" cookie-value
+
+       Section 4.2.1 of RFC6265. Just like user agents do when they parse
+       Set-Cookie, pairs without `'='` or with an empty name are skipped and
+       OWS around names and values is ignored. */
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+
+    while (first != last) {
+        const CharT *semicolon = http::detail::find(first, last, ';');
+        const CharT *eq = http::detail::find(first, semicolon, '=');
+        const CharT *next = (semicolon == last) ? last : semicolon + 1;
+
+        if (eq != semicolon) {
+            name = detail::trim_ows(first, eq);
+            if (name.size() != 0) {
+                value = unquote(detail::trim_ows(eq + 1, semicolon));
+                return next - in.data();
+            }
+        }
+
+        first = next;
+    }
+
+    return 0;
+}
+
+template<class CharT>
+bool cookie<CharT>::find(view_type in, view_type name, view_type &value)
+{
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+
+    while (first != last) {
+        const CharT *semicolon = http::detail::find(first, last, ';');
+        const CharT *eq = http::detail::find(first, semicolon, '=');
+
+        /* The name is compared before any trimming is done on the value, so
+           only the matching pair pays for it. */
+        if (name.size() != 0 && eq != semicolon
+            && detail::trim_ows(first, eq) == name) {
+            value = unquote(detail::trim_ows(eq + 1, semicolon));
+            return true;
+        }
+
+        first = (semicolon == last) ? last : semicolon + 1;
+    }
+
+    return false;
+}
+
+template<class CharT>
+typename cookie<CharT>::view_type cookie<CharT>::unquote(view_type value)
+{
+    // cookie-value = *cookie-octet / ( DQUOTE *cookie-octet DQUOTE )
+    if (value.size() >= 2 && value[0] == '"'
+        && value[value.size() - 1] == '"') {
+        return value.substr(1, value.size() - 2);
+    }
+
+    return value;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,46 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_DETAIL_ASCII_IEQUALS_HPP
+#define BOOST_HTTP_SYNTAX_DETAIL_ASCII_IEQUALS_HPP
+
+#include <boost/utility/string_view.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+namespace detail {
+
+/* Tokens are compared case-insensitively (section 3.2.6 of RFC7230), but only
+   US-ASCII letters are folded. No locale is involved. */
+template<class CharT, class CharU>
+bool ascii_iequals(basic_string_view<CharT> a, basic_string_view<CharU> b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (std::size_t i = 0 ; i != a.size() ; ++i) {
+        CharT x = a[i];
+        CharU y = b[i];
+
+        if (x >= 'A' && x <= 'Z')
+            x += 'a' - 'A';
+
+        if (y >= 'A' && y <= 'Z')
+            y += 'a' - 'A';
+
+        if (x != y)
+            return false;
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_SYNTAX_DETAIL_ASCII_IEQUALS_HPP
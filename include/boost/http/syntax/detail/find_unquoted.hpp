@@ -0,0 +1,56 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_DETAIL_FIND_UNQUOTED_HPP
+#define BOOST_HTTP_SYNTAX_DETAIL_FIND_UNQUOTED_HPP
+
+#include <boost/http/detail/simd.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+namespace detail {
+
+/* Returns the first `c` within [first, last) that isn't part of a
+   quoted-string or `last` if there is none. */
+template<class CharT>
+const CharT *find_unquoted(const CharT *first, const CharT *last,
+                           unsigned char c)
+{
+    const unsigned char delimiters[] = {c, '"'};
+    static const unsigned char quoted_delimiters[] = {'"', '\\'};
+
+    for (;;) {
+        first = http::detail::find_first_of(first, last, delimiters);
+        if (first == last || *first == c)
+            return first;
+
+        /* quoted-string  = DQUOTE *( qdtext / quoted-pair ) DQUOTE
+
+           An unterminated quoted-string extends up to the end of the field. */
+        for (++first ; ; first += 2) {
+            first = http::detail::find_first_of(first, last,
+                                                quoted_delimiters);
+            if (first == last)
+                return last;
+
+            if (*first == '"') {
+                ++first;
+                break;
+            }
+
+            if (last - first < 2)
+                return last;
+        }
+    }
+}
+
+} // namespace detail
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_SYNTAX_DETAIL_FIND_UNQUOTED_HPP
@@ -0,0 +1,29 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_DETAIL_IS_ALPHA_HPP
+#define BOOST_HTTP_SYNTAX_DETAIL_IS_ALPHA_HPP
+
+namespace boost {
+namespace http {
+namespace syntax {
+namespace detail {
+
+template<class CharT>
+bool is_alpha(CharT c)
+{
+    /* ALPHA          =  %x41-5A / %x61-7A   ; A-Z / a-z
+
+       from Appendix B of RFC5234. */
+    return (c >= 0x41 && c <= 0x5A) || (c >= 0x61 && c <= 0x7A);
+}
+
+} // namespace detail
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_SYNTAX_DETAIL_IS_ALPHA_HPP
@@ -0,0 +1,35 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_DETAIL_TRIM_OWS_HPP
+#define BOOST_HTTP_SYNTAX_DETAIL_TRIM_OWS_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/syntax/detail/is_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+namespace detail {
+
+template<class CharT>
+basic_string_view<CharT> trim_ows(const CharT *first, const CharT *last)
+{
+    while (first != last && is_ows(*first))
+        ++first;
+
+    while (first != last && is_ows(*(last - 1)))
+        --last;
+
+    return basic_string_view<CharT>(first, last - first);
+}
+
+} // namespace detail
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_SYNTAX_DETAIL_TRIM_OWS_HPP
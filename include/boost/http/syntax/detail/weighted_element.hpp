@@ -0,0 +1,89 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_DETAIL_WEIGHTED_ELEMENT_HPP
+#define BOOST_HTTP_SYNTAX_DETAIL_WEIGHTED_ELEMENT_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/qvalue.hpp>
+#include <boost/http/syntax/detail/find_unquoted.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+namespace detail {
+
+template<class CharT>
+struct weighted_element
+{
+    basic_string_view<CharT> value;
+
+    // parameters found before the weight, without the leading `';'`
+    basic_string_view<CharT> parameters;
+
+    unsigned weight;
+};
+
+/* Extracts the first element of a list of `value *( OWS ";" OWS parameter )`
+   where the parameter named "q" is the weight (section 5.3.1 of RFC7231) and
+   returns the number of elements consumed from `in`. Returns 0 if there are no
+   elements left.
+
+   Empty elements and elements with an invalid weight are skipped. Parameters
+   after the weight (i.e. `accept-ext`) are ignored. */
+template<class CharT>
+std::size_t decode_weighted_element(basic_string_view<CharT> in,
+                                    weighted_element<CharT> &out)
+{
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+
+    while (first != last) {
+        const CharT *end = find_unquoted(first, last, ',');
+        const CharT *next = (end == last) ? last : end + 1;
+
+        const CharT *semicolon = http::detail::find(first, end, ';');
+        out.value = trim_ows(first, semicolon);
+
+        const CharT *parameters_first
+            = (semicolon == end) ? end : semicolon + 1;
+        const CharT *parameters_last = parameters_first;
+        bool valid = out.value.size() != 0;
+        out.weight = 1000;
+
+        for (const CharT *p = semicolon ; valid && p != end ; ) {
+            const CharT *param_first = p + 1;
+            p = find_unquoted(param_first, end, ';');
+
+            basic_string_view<CharT> param = trim_ows(param_first, p);
+            if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q')
+                && param[1] == '=') {
+                valid = qvalue<CharT>::decode(param.substr(2), out.weight);
+                break;
+            }
+
+            parameters_last = p;
+        }
+
+        if (valid) {
+            out.parameters = trim_ows(parameters_first, parameters_last);
+            return next - in.data();
+        }
+
+        first = next;
+    }
+
+    return 0;
+}
+
+} // namespace detail
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#endif // BOOST_HTTP_SYNTAX_DETAIL_WEIGHTED_ELEMENT_HPP
@@ -0,0 +1,55 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_ENTITY_TAG_HPP
+#define BOOST_HTTP_SYNTAX_ENTITY_TAG_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/detail/is_obs_text.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct entity_tag {
+    typedef basic_string_view<CharT> view_type;
+
+    /* Returns the size of the entity-tag found at the beginning of `in` or 0
+       if there is none. */
+    static std::size_t match(view_type in);
+
+    // `etag` must be a valid entity-tag
+    static bool is_weak(view_type etag);
+
+    /* Comparison functions from section 2.3.2 of RFC7232. Both arguments must
+       be valid entity-tags. */
+    static bool strong_compare(view_type a, view_type b);
+    static bool weak_compare(view_type a, view_type b);
+
+    /* Evaluate an If-Match (`strong_match`) or an If-None-Match (`weak_match`)
+       field value against the current entity-tag of the representation. Both
+       return true if the field value is "*" or if any of its entity-tags
+       matches. Invalid elements are skipped. */
+    static bool strong_match(view_type field, view_type etag);
+    static bool weak_match(view_type field, view_type etag);
+
+private:
+    static view_type opaque_tag(view_type etag);
+
+    template<bool Strong>
+    static bool any_of(view_type field, view_type etag);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "entity_tag.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_ENTITY_TAG_HPP
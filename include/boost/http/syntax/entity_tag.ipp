@@ -0,0 +1,122 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+std::size_t entity_tag<CharT>::match(view_type in)
+{
+    /* entity-tag = [ weak ] opaque-tag
+       weak       = %x57.2F ; "W/", case-sensitive
+       opaque-tag = DQUOTE *etagc DQUOTE
+       etagc      = %x21 / %x23-7E / obs-text
+
+       Section 2.3 of RFC7232. */
+    std::size_t i = 0;
+
+    if (in.size() >= 2 && in[0] == 'W' && in[1] == '/')
+        i = 2;
+
+    if (i == in.size() || in[i] != '"')
+        return 0;
+
+    for (++i ; i != in.size() ; ++i) {
+        unsigned char c = in[i];
+
+        if (c == '"')
+            return i + 1;
+
+        if (c != 0x21 && (c < 0x23 || c > 0x7E) && !detail::is_obs_text(c))
+            return 0;
+    }
+
+    return 0;
+}
+
+template<class CharT>
+bool entity_tag<CharT>::is_weak(view_type etag)
+{
+    return etag[0] == 'W';
+}
+
+template<class CharT>
+bool entity_tag<CharT>::strong_compare(view_type a, view_type b)
+{
+    return !is_weak(a) && !is_weak(b) && a == b;
+}
+
+template<class CharT>
+bool entity_tag<CharT>::weak_compare(view_type a, view_type b)
+{
+    return opaque_tag(a) == opaque_tag(b);
+}
+
+template<class CharT>
+bool entity_tag<CharT>::strong_match(view_type field, view_type etag)
+{
+    return any_of<true>(field, etag);
+}
+
+template<class CharT>
+bool entity_tag<CharT>::weak_match(view_type field, view_type etag)
+{
+    return any_of<false>(field, etag);
+}
+
+template<class CharT>
+typename entity_tag<CharT>::view_type
+entity_tag<CharT>::opaque_tag(view_type etag)
+{
+    return is_weak(etag) ? etag.substr(2) : etag;
+}
+
+template<class CharT>
+template<bool Strong>
+bool entity_tag<CharT>::any_of(view_type field, view_type etag)
+{
+    /* If-Match = "*" / 1#entity-tag
+
+       `header_value_list` can't split the list: entity-tags have no
+       quoted-pair and `'\'` is a valid etagc, so `"a\", "b"` holds two
+       entity-tags. Only a DQUOTE that starts an opaque-tag opens a quoted
+       section and the next DQUOTE always closes it. */
+    const CharT *first = field.data();
+    const CharT *last = first + field.size();
+
+    while (first != last) {
+        while (first != last && detail::is_ows(*first))
+            ++first;
+
+        const CharT *end = first;
+        if (last - end >= 2 && end[0] == 'W' && end[1] == '/')
+            end += 2;
+        if (end != last && *end == '"') {
+            end = http::detail::find(end + 1, last, '"');
+            if (end != last)
+                ++end;
+        }
+        end = http::detail::find(end, last, ',');
+
+        view_type e = detail::trim_ows(first, end);
+        first = (end == last) ? last : end + 1;
+
+        if (e.size() == 1 && e[0] == '*')
+            return true;
+
+        if (e.size() == 0 || match(e) != e.size())
+            continue;
+
+        if (Strong ? strong_compare(e, etag) : weak_compare(e, etag))
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,105 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_MEDIA_TYPE_HPP
+#define BOOST_HTTP_SYNTAX_MEDIA_TYPE_HPP
+
+#include <cstddef>
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/field_name.hpp>
+#include <boost/http/syntax/detail/ascii_iequals.hpp>
+#include <boost/http/syntax/detail/find_unquoted.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct media_type {
+    typedef basic_string_view<CharT> view_type;
+
+    // Common media types, so dispatching doesn't need string comparisons
+    struct interned
+    {
+        enum value
+        {
+            unknown,
+            text_plain,
+            text_html,
+            text_css,
+            text_csv,
+            text_javascript,
+            text_event_stream,
+            application_json,
+            application_xml,
+            application_javascript,
+            application_octet_stream,
+            application_x_www_form_urlencoded,
+            application_grpc,
+            multipart_form_data,
+            multipart_byteranges,
+            multipart_mixed,
+            image_png,
+            image_jpeg,
+            image_gif,
+            image_webp,
+            image_svg_xml
+        };
+    };
+
+    struct components
+    {
+        view_type type;
+        view_type subtype;
+
+        // without the leading `';'`
+        view_type parameters;
+
+        typename interned::value id;
+    };
+
+    struct parameter
+    {
+        view_type name;
+        view_type value;
+
+        // `value` still holds quoted-pairs (i.e. it couldn't be unescaped)
+        bool escaped;
+    };
+
+    // Returns false if `in` isn't a valid media-type
+    static bool decode(view_type in, components &out);
+
+    /* Extracts the first parameter from `in` (i.e. `components::parameters`)
+       and returns the number of elements consumed. Returns 0 if there are no
+       parameters left.
+
+       Quoted values are unquoted. If they hold quoted-pairs, they're unescaped
+       into `scratch` (if it is big enough), which is reused by every call. */
+    static std::size_t decode_parameter(view_type in, parameter &out,
+                                        CharT *scratch = NULL,
+                                        std::size_t scratch_size = 0);
+
+    // Looks for the first parameter named `name` (case-insensitive)
+    static bool find_parameter(view_type in, view_type name, parameter &out,
+                               CharT *scratch = NULL,
+                               std::size_t scratch_size = 0);
+
+private:
+    static typename interned::value intern(view_type type, view_type subtype);
+    static bool is_token(view_type in);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "media_type.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_MEDIA_TYPE_HPP
@@ -0,0 +1,227 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+namespace detail {
+
+// Entries follow the order of `media_type::interned::value` (minus `unknown`)
+struct interned_media_type
+{
+    const char *type;
+    std::size_t type_size;
+    const char *subtype;
+    std::size_t subtype_size;
+};
+
+const std::size_t interned_media_type_max_subtype_size = 21;
+
+template<class T = void>
+struct basic_interned_media_types
+{
+    static const interned_media_type entries[20];
+
+    /* The entries (1-based) grouped by the size of the subtype (0-terminated).
+       Once the sizes are checked, a media type is compared against 2
+       candidates at most. */
+    static const unsigned char by_subtype_size[
+        interned_media_type_max_subtype_size + 1][6];
+};
+
+template<class T>
+const interned_media_type basic_interned_media_types<T>::entries[20] = {
+    { "text",         4, "plain",                  5 },
+    { "text",         4, "html",                   4 },
+    { "text",         4, "css",                    3 },
+    { "text",         4, "csv",                    3 },
+    { "text",         4, "javascript",            10 },
+    { "text",         4, "event-stream",          12 },
+    { "application", 11, "json",                   4 },
+    { "application", 11, "xml",                    3 },
+    { "application", 11, "javascript",            10 },
+    { "application", 11, "octet-stream",          12 },
+    { "application", 11, "x-www-form-urlencoded", 21 },
+    { "application", 11, "grpc",                   4 },
+    { "multipart",    9, "form-data",              9 },
+    { "multipart",    9, "byteranges",            10 },
+    { "multipart",    9, "mixed",                  5 },
+    { "image",        5, "png",                    3 },
+    { "image",        5, "jpeg",                   4 },
+    { "image",        5, "gif",                    3 },
+    { "image",        5, "webp",                   4 },
+    { "image",        5, "svg+xml",                7 }
+};
+
+template<class T>
+const unsigned char basic_interned_media_types<T>::by_subtype_size[
+    interned_media_type_max_subtype_size + 1][6] = {
+    {0}, {0}, {0},
+    {3, 4, 8, 16, 18, 0},
+    {2, 7, 12, 17, 19, 0},
+    {1, 15, 0},
+    {0},
+    {20, 0},
+    {0},
+    {13, 0},
+    {5, 9, 14, 0},
+    {0},
+    {6, 10, 0},
+    {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0},
+    {11, 0}
+};
+
+typedef basic_interned_media_types<> interned_media_types;
+
+} // namespace detail
+
+template<class CharT>
+bool media_type<CharT>::decode(view_type in, components &out)
+{
+    /* media-type = type "/" subtype *( OWS ";" OWS parameter )
+       type       = token
+       subtype    = token
+
+       Section 3.1.1.1 of RFC7231. */
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+    const CharT *semicolon = http::detail::find(first, last, ';');
+
+    view_type value = detail::trim_ows(first, semicolon);
+    std::size_t slash = value.find('/');
+    if (slash == view_type::npos)
+        return false;
+
+    out.type = value.substr(0, slash);
+    out.subtype = value.substr(slash + 1);
+
+    if (!is_token(out.type) || !is_token(out.subtype))
+        return false;
+
+    out.parameters = (semicolon == last)
+        ? view_type(last, 0) : detail::trim_ows(semicolon + 1, last);
+    out.id = intern(out.type, out.subtype);
+    return true;
+}
+
+template<class CharT>
+std::size_t media_type<CharT>::decode_parameter(view_type in, parameter &out,
+                                                CharT *scratch,
+                                                std::size_t scratch_size)
+{
+    // parameter = token "=" ( token / quoted-string )
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+
+    while (first != last) {
+        const CharT *end = detail::find_unquoted(first, last, ';');
+        const CharT *next = (end == last) ? last : end + 1;
+        const CharT *eq = http::detail::find(first, end, '=');
+
+        if (eq == end) {
+            first = next;
+            continue;
+        }
+
+        out.name = detail::trim_ows(first, eq);
+        if (out.name.size() == 0) {
+            first = next;
+            continue;
+        }
+
+        out.value = detail::trim_ows(eq + 1, end);
+        out.escaped = false;
+
+        if (out.value.size() >= 2 && out.value[0] == '"'
+            && out.value[out.value.size() - 1] == '"') {
+            view_type inner = out.value.substr(1, out.value.size() - 2);
+            out.value = inner;
+
+            std::size_t backslash = inner.find('\\');
+            if (backslash != view_type::npos) {
+                if (scratch && scratch_size >= inner.size()) {
+                    // quoted-pair = "\" ( HTAB / SP / VCHAR / obs-text )
+                    std::size_t size = 0;
+                    for (std::size_t i = 0 ; i != inner.size() ; ++i) {
+                        if (inner[i] == '\\' && i + 1 != inner.size())
+                            ++i;
+
+                        scratch[size++] = inner[i];
+                    }
+                    out.value = view_type(scratch, size);
+                } else {
+                    out.escaped = true;
+                }
+            }
+        }
+
+        return next - in.data();
+    }
+
+    return 0;
+}
+
+template<class CharT>
+bool media_type<CharT>::find_parameter(view_type in, view_type name,
+                                       parameter &out, CharT *scratch,
+                                       std::size_t scratch_size)
+{
+    // Only the matching parameter is unescaped
+    parameter p;
+    while (std::size_t n = decode_parameter(in, p)) {
+        if (detail::ascii_iequals(p.name, name)) {
+            decode_parameter(in, out, scratch, scratch_size);
+            return true;
+        }
+
+        in.remove_prefix(n);
+    }
+
+    return false;
+}
+
+template<class CharT>
+typename media_type<CharT>::interned::value
+media_type<CharT>::intern(view_type type, view_type subtype)
+{
+    typedef detail::interned_media_types table;
+
+    if (subtype.size() > detail::interned_media_type_max_subtype_size)
+        return interned::unknown;
+
+    for (const unsigned char *i = table::by_subtype_size[subtype.size()] ; *i
+             ; ++i) {
+        const detail::interned_media_type &e = table::entries[*i - 1];
+
+        if (e.type_size == type.size()
+            && detail::ascii_iequals(type, string_view(e.type, e.type_size))
+            && detail::ascii_iequals(subtype,
+                                     string_view(e.subtype,
+                                                 e.subtype_size))) {
+            return static_cast<typename interned::value>(*i);
+        }
+    }
+
+    return interned::unknown;
+}
+
+template<class CharT>
+bool media_type<CharT>::is_token(view_type in)
+{
+    if (in.size() == 0)
+        return false;
+
+    for (std::size_t i = 0 ; i != in.size() ; ++i) {
+        if (!detail::is_tchar(in[i]))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
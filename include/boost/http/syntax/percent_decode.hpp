@@ -0,0 +1,57 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_PERCENT_DECODE_HPP
+#define BOOST_HTTP_SYNTAX_PERCENT_DECODE_HPP
+
+#include <algorithm>
+
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/detail/hex_table.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct percent_decode {
+    typedef basic_string_view<CharT> view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(result)
+    {
+        ok,
+        invalid_escape,
+        encoded_nul
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(result)
+
+    // Returns the index of the first `'%'` or `in.size()` if there is none
+    static std::size_t find(view_type in);
+
+    /* `out` must have room for `in.size()` elements. It may point to
+       `in.data()` to decode in place (the output is never longer than the
+       input). */
+    static result decode(view_type in, CharT *out, std::size_t &out_size);
+
+    /* Same as `decode`, but `'+'` is decoded into a space as done by the
+       application/x-www-form-urlencoded serialization. */
+    static result decode_form(view_type in, CharT *out, std::size_t &out_size);
+
+private:
+    template<class Find>
+    static result decode_impl(view_type in, CharT *out, std::size_t &out_size,
+                              Find find);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "percent_decode.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_PERCENT_DECODE_HPP
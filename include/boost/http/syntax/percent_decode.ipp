@@ -0,0 +1,120 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+namespace detail {
+
+struct find_pct
+{
+    template<class CharT>
+    const CharT *operator()(const CharT *first, const CharT *last) const
+    {
+        return http::detail::find(first, last, '%');
+    }
+};
+
+struct find_pct_or_plus
+{
+    template<class CharT>
+    const CharT *operator()(const CharT *first, const CharT *last) const
+    {
+        static const unsigned char set[] = {'%', '+'};
+        return http::detail::find_first_of(first, last, set);
+    }
+};
+
+} // namespace detail
+
+template<class CharT>
+std::size_t percent_decode<CharT>::find(view_type in)
+{
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+    return http::detail::find(first, last, '%') - first;
+}
+
+template<class CharT>
+typename percent_decode<CharT>::result
+percent_decode<CharT>::decode(view_type in, CharT *out, std::size_t &out_size)
+{
+    return decode_impl(in, out, out_size, detail::find_pct());
+}
+
+template<class CharT>
+typename percent_decode<CharT>::result
+percent_decode<CharT>::decode_form(view_type in, CharT *out,
+                                   std::size_t &out_size)
+{
+    return decode_impl(in, out, out_size, detail::find_pct_or_plus());
+}
+
+template<class CharT>
+template<class Find>
+typename percent_decode<CharT>::result
+percent_decode<CharT>::decode_impl(view_type in, CharT *out,
+                                   std::size_t &out_size, Find find)
+{
+    /* pct-encoded = "%" HEXDIG HEXDIG
+
+       Section 2.1 of RFC3986. */
+    const unsigned char *hex = detail::hex_table::values;
+
+    const CharT *first = in.data();
+    const CharT *last = first + in.size();
+    CharT *o = out;
+
+    for (;;) {
+        const CharT *pct = find(first, last);
+
+        /* The output never gets ahead of the input, so a forward copy is safe
+           for in place decoding. And there is nothing to copy while no escape
+           has been found yet. */
+        if (o != first)
+            std::copy(first, pct, o);
+        o += pct - first;
+
+        if (pct == last)
+            break;
+
+        if (*pct == '+') {
+            *o++ = ' ';
+            first = pct + 1;
+            continue;
+        }
+
+        if (last - pct < 3) {
+            out_size = o - out;
+            return result::invalid_escape;
+        }
+
+        unsigned char hi = hex[static_cast<unsigned char>(pct[1])];
+        unsigned char lo = hex[static_cast<unsigned char>(pct[2])];
+
+        if ((hi | lo) & 0xF0) {
+            out_size = o - out;
+            return result::invalid_escape;
+        }
+
+        unsigned char c = (hi << 4) | lo;
+
+        if (c == 0) {
+            out_size = o - out;
+            return result::encoded_nul;
+        }
+
+        *o++ = c;
+        first = pct + 3;
+    }
+
+    out_size = o - out;
+    return result::ok;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
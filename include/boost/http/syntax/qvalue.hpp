@@ -0,0 +1,32 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_QVALUE_HPP
+#define BOOST_HTTP_SYNTAX_QVALUE_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/http/syntax/detail/is_digit.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct qvalue {
+    typedef basic_string_view<CharT> view_type;
+
+    /* Stores the weight as a fixed-point integer in thousandths (from 0 to
+       1000) in `out`. Returns false if `in` isn't a valid qvalue. */
+    static bool decode(view_type in, unsigned &out);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "qvalue.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_QVALUE_HPP
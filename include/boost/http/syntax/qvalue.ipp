@@ -0,0 +1,51 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+bool qvalue<CharT>::decode(view_type in, unsigned &out)
+{
+    /* qvalue = ( "0" [ "." 0*3DIGIT ] )
+              / ( "1" [ "." 0*3("0") ] )
+
+       Section 5.3.1 of RFC7231. */
+    if (in.size() == 0 || in.size() > 5)
+        return false;
+
+    if (in.size() > 1 && in[1] != '.')
+        return false;
+
+    switch (in[0]) {
+    case '0':
+        {
+            unsigned value = 0;
+            unsigned scale = 100;
+            for (std::size_t i = 2 ; i < in.size() ; ++i, scale /= 10) {
+                if (!detail::is_digit(in[i]))
+                    return false;
+
+                value += (in[i] - '0') * scale;
+            }
+            out = value;
+            return true;
+        }
+    case '1':
+        for (std::size_t i = 2 ; i < in.size() ; ++i) {
+            if (in[i] != '0')
+                return false;
+        }
+        out = 1000;
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,69 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_RANGE_HPP
+#define BOOST_HTTP_SYNTAX_RANGE_HPP
+
+#include <algorithm>
+#include <limits>
+
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/type_traits/type_identity.hpp>
+#include <boost/http/detail/simd.hpp>
+#include <boost/http/syntax/content_length.hpp>
+#include <boost/http/syntax/detail/ascii_iequals.hpp>
+#include <boost/http/syntax/detail/trim_ows.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+struct range {
+    typedef basic_string_view<CharT> view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(result)
+    {
+        // The Range header field must be ignored
+        invalid,
+        ok,
+        unsatisfiable,
+        too_many_ranges
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(result)
+
+    template<class Target>
+    struct byte_range
+    {
+        Target offset;
+        Target size;
+    };
+
+    /* Decodes the satisfiable ranges against a representation of `size`
+       bytes into `out`. Ranges are sorted and overlapping or adjacent ranges
+       are merged. At most `max_ranges` ranges are accepted (before merging),
+       so the work done is bounded by the caller. `Target` is only deduced from
+       `out`. */
+    template<class Target>
+    static result decode(view_type in,
+                         typename type_identity<Target>::type size,
+                         byte_range<Target> *out, std::size_t max_ranges,
+                         std::size_t &nranges);
+
+private:
+    template<class Target>
+    static bool offset_less(const byte_range<Target> &a,
+                            const byte_range<Target> &b);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "range.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_RANGE_HPP
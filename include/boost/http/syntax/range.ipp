@@ -0,0 +1,145 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+template<class CharT>
+template<class Target>
+typename range<CharT>::result
+range<CharT>::decode(view_type in, typename type_identity<Target>::type size,
+                     byte_range<Target> *out, std::size_t max_ranges,
+                     std::size_t &nranges)
+{
+    /* Range                   = byte-ranges-specifier / other-ranges-specifier
+       byte-ranges-specifier   = bytes-unit "=" byte-range-set
+       byte-range-set          = 1#( byte-range-spec / suffix-byte-range-spec )
+       byte-range-spec         = first-byte-pos "-" [ last-byte-pos ]
+       suffix-byte-range-spec  = "-" suffix-length
+
+       Sections 2.1 and 3.1 of RFC7233. */
+    typedef content_length<CharT> number;
+    typedef typename number::result number_result;
+
+    static const CharT bytes_unit[] = {'b', 'y', 't', 'e', 's', '='};
+
+    nranges = 0;
+
+    if (in.size() < 6
+        || !detail::ascii_iequals(in.substr(0, 6), view_type(bytes_unit, 6))) {
+        return result::invalid;
+    }
+
+    const CharT *first = in.data() + 6;
+    const CharT *last = in.data() + in.size();
+    bool empty = true;
+
+    while (first != last) {
+        const CharT *comma = http::detail::find(first, last, ',');
+        view_type spec = detail::trim_ows(first, comma);
+        first = (comma == last) ? last : comma + 1;
+
+        if (spec.size() == 0)
+            continue;
+
+        empty = false;
+
+        std::size_t dash = spec.find('-');
+        if (dash == view_type::npos)
+            return result::invalid;
+
+        view_type first_pos = spec.substr(0, dash);
+        view_type last_pos = spec.substr(dash + 1);
+        Target offset;
+        Target end;
+
+        if (first_pos.size() == 0) {
+            Target suffix_length;
+            number_result r = number::decode(last_pos, suffix_length);
+            if (r == number_result::invalid)
+                return result::invalid;
+
+            // An overflowing suffix-length covers the whole representation
+            if (r == number_result::overflow || suffix_length > size)
+                suffix_length = size;
+
+            if (suffix_length == 0)
+                continue;
+
+            offset = size - suffix_length;
+            end = size;
+        } else {
+            number_result r = number::decode(first_pos, offset);
+            if (r == number_result::invalid)
+                return result::invalid;
+
+            Target last_byte = std::numeric_limits<Target>::max();
+            if (last_pos.size() != 0) {
+                number_result r2 = number::decode(last_pos, last_byte);
+                if (r2 == number_result::invalid)
+                    return result::invalid;
+
+                if (r2 == number_result::ok
+                    && (r == number_result::overflow || last_byte < offset)) {
+                    return result::invalid;
+                }
+
+                if (r2 == number_result::overflow)
+                    last_byte = std::numeric_limits<Target>::max();
+            }
+
+            // Not satisfiable (section 2.1 of RFC7233)
+            if (r == number_result::overflow || offset >= size)
+                continue;
+
+            end = (last_byte >= size - 1) ? size : last_byte + 1;
+        }
+
+        if (nranges == max_ranges)
+            return result::too_many_ranges;
+
+        out[nranges].offset = offset;
+        out[nranges].size = end - offset;
+        ++nranges;
+    }
+
+    if (empty)
+        return result::invalid;
+
+    if (nranges == 0)
+        return result::unsatisfiable;
+
+    std::sort(out, out + nranges, offset_less<Target>);
+
+    std::size_t merged = 0;
+    for (std::size_t i = 1 ; i != nranges ; ++i) {
+        byte_range<Target> &prev = out[merged];
+        Target prev_end = prev.offset + prev.size;
+
+        if (out[i].offset <= prev_end) {
+            Target end = out[i].offset + out[i].size;
+            if (end > prev_end)
+                prev.size = end - prev.offset;
+        } else {
+            out[++merged] = out[i];
+        }
+    }
+    nranges = merged + 1;
+
+    return result::ok;
+}
+
+template<class CharT>
+template<class Target>
+bool range<CharT>::offset_less(const byte_range<Target> &a,
+                               const byte_range<Target> &b)
+{
+    return a.offset < b.offset;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,53 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_REQUEST_TARGET_HPP
+#define BOOST_HTTP_SYNTAX_REQUEST_TARGET_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/syntax/detail/is_alpha.hpp>
+#include <boost/http/syntax/detail/is_digit.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+/* Splits a request target already validated by `reader::request` (only valid
+   characters are present). No character is revalidated here, only the few
+   delimiters required to find each component are looked for. */
+template<class CharT>
+struct request_target {
+    typedef basic_string_view<CharT> view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(form)
+    {
+        invalid,
+        origin,
+        absolute,
+        authority,
+        asterisk
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(form)
+
+    struct components
+    {
+        view_type scheme;
+        view_type authority;
+        view_type path;
+        view_type query;
+    };
+
+    static form decode(view_type in, components &out);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "request_target.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_REQUEST_TARGET_HPP
@@ -0,0 +1,143 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+namespace detail {
+
+template<class CharT>
+bool is_scheme_char(CharT c)
+{
+    /* scheme      = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." )
+
+       Section 3.1 of RFC3986. */
+    switch (c) {
+    case '+': case '-': case '.':
+        return true;
+    default:
+        return is_alpha(c) || is_digit(c);
+    }
+}
+
+template<class View, class Components>
+void split_path_and_query(View in, Components &out)
+{
+    /* `'#'` is never accepted by the request reader (a fragment is not part of
+       the request target), so the first `'?'` is the only delimiter left. */
+    typename View::size_type q = in.find('?');
+    if (q == View::npos) {
+        out.path = in;
+        return;
+    }
+
+    out.path = in.substr(0, q);
+    out.query = in.substr(q + 1);
+}
+
+} // namespace detail
+
+template<class CharT>
+typename request_target<CharT>::form
+request_target<CharT>::decode(view_type in, components &out)
+{
+    /* request-target = origin-form
+                      / absolute-form
+                      / authority-form
+                      / asterisk-form
+
+       Section 5.3 of RFC7230. */
+    out = components();
+
+    if (in.size() == 0)
+        return form::invalid;
+
+    // origin-form    = absolute-path [ "?" query ]
+    if (in[0] == '/') {
+        detail::split_path_and_query(in, out);
+        return form::origin;
+    }
+
+    // asterisk-form  = "*"
+    if (in.size() == 1 && in[0] == '*')
+        return form::asterisk;
+
+    // absolute-form  = absolute-URI
+    std::size_t scheme_size = 0;
+    if (detail::is_alpha(in[0])) {
+        scheme_size = 1;
+        while (scheme_size != in.size()
+               && detail::is_scheme_char(in[scheme_size])) {
+            ++scheme_size;
+        }
+    }
+
+    if (scheme_size != 0 && scheme_size != in.size()
+        && in[scheme_size] == ':') {
+        view_type rest = in.substr(scheme_size + 1);
+
+        if (rest.size() >= 2 && rest[0] == '/' && rest[1] == '/') {
+            // hier-part   = "//" authority path-abempty / ...
+            rest.remove_prefix(2);
+
+            std::size_t i = 0;
+            while (i != rest.size() && rest[i] != '/' && rest[i] != '?')
+                ++i;
+
+            out.scheme = in.substr(0, scheme_size);
+            out.authority = rest.substr(0, i);
+            detail::split_path_and_query(rest.substr(i), out);
+            return form::absolute;
+        }
+
+        /* "host:port" is also a valid absolute-URI whose scheme is "host". We
+           pick authority-form when the remainder can only be a port. */
+        bool is_port = true;
+        for (std::size_t i = 0 ; i != rest.size() ; ++i) {
+            if (!detail::is_digit(rest[i])) {
+                is_port = false;
+                break;
+            }
+        }
+
+        if (!is_port) {
+            out.scheme = in.substr(0, scheme_size);
+            detail::split_path_and_query(rest, out);
+            return form::absolute;
+        }
+    }
+
+    /* authority-form = authority
+
+       The userinfo subcomponent is not allowed here (section 5.3 of
+       RFC7230). */
+    std::size_t colon = view_type::npos;
+    for (std::size_t i = 0 ; i != in.size() ; ++i) {
+        switch (in[i]) {
+        case '/': case '?': case '@':
+            return form::invalid;
+        case ':':
+            colon = i;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (colon != view_type::npos) {
+        for (std::size_t i = colon + 1 ; i != in.size() ; ++i) {
+            if (!detail::is_digit(in[i]))
+                return form::invalid;
+        }
+    }
+
+    out.authority = in;
+    return form::authority;
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
@@ -0,0 +1,153 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_SYNTAX_STRUCTURED_FIELD_HPP
+#define BOOST_HTTP_SYNTAX_STRUCTURED_FIELD_HPP
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/detail/macros.hpp>
+#include <boost/http/syntax/detail/is_alpha.hpp>
+#include <boost/http/syntax/detail/is_digit.hpp>
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+/* Structured Field Values for HTTP (RFC8941).
+
+   A parsed field is stored as a flat array of nodes in the order they appear
+   within the field value. Every member (an item or an inner list) is followed
+   by its children: the items of an inner list (each one followed by its own
+   parameters) and then its parameters. `node::size` tells how many nodes the
+   subtree spans (the node itself included), so siblings can be skipped in
+   constant time. */
+template<class CharT>
+struct structured_field {
+    typedef basic_string_view<CharT> view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(result)
+    {
+        ok,
+        invalid,
+        too_many_nodes
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(result)
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(node_type)
+    {
+        integer,
+        decimal,
+        string,
+        token,
+        byte_sequence,
+        boolean,
+        inner_list
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(node_type)
+
+    struct node
+    {
+        node_type type;
+
+        // Dictionary member or parameter key (empty otherwise)
+        view_type key;
+
+        /* Contents of strings (still escaped), tokens and byte sequences (still
+           base64-encoded) */
+        view_type text;
+
+        /* Value of integers, booleans (0 or 1) and decimals (a fixed-point
+           integer in thousandths) */
+        boost::int64_t number;
+
+        std::size_t size;
+        std::size_t nparams;
+    };
+
+    static result parse_item(view_type in, node *out, std::size_t max_nodes,
+                             std::size_t &nnodes);
+    static result parse_list(view_type in, node *out, std::size_t max_nodes,
+                             std::size_t &nnodes);
+    static result parse_dictionary(view_type in, node *out,
+                                   std::size_t max_nodes, std::size_t &nnodes);
+
+    /* The serializers write into `out` up to `out_size` elements and return
+       the number of elements the whole serialization needs (i.e. the output
+       was truncated if the return value is greater than `out_size`). Nodes
+       aren't validated. */
+    static std::size_t serialize_item(const node *nodes, std::size_t nnodes,
+                                      CharT *out, std::size_t out_size);
+    static std::size_t serialize_list(const node *nodes, std::size_t nnodes,
+                                      CharT *out, std::size_t out_size);
+    static std::size_t serialize_dictionary(const node *nodes,
+                                            std::size_t nnodes, CharT *out,
+                                            std::size_t out_size);
+
+    /* Returns the last dictionary member named `key` (later duplicates
+       override earlier ones) or null if there is none. */
+    static const node *find_member(const node *nodes, std::size_t nnodes,
+                                   view_type key);
+
+    // Same as `find_member`, but for the parameters of `member`
+    static const node *find_parameter(const node &member, view_type key);
+
+    /* Unescapes the text of a string node into `out`, which must have room
+       for `text.size()` elements, and returns the number of elements
+       written. */
+    static std::size_t unescape(view_type text, CharT *out);
+
+private:
+    struct parser
+    {
+        const CharT *first;
+        const CharT *last;
+        node *out;
+        std::size_t max_nodes;
+        std::size_t nnodes;
+    };
+
+    struct writer
+    {
+        void put(CharT c);
+        void put(view_type v);
+
+        CharT *out;
+        std::size_t out_size;
+        std::size_t size;
+    };
+
+    static result finish(parser &p, std::size_t &nnodes);
+    static result push(parser &p, view_type key, std::size_t &idx);
+    static result read_member(parser &p, view_type key);
+    static result read_item(parser &p, view_type key);
+    static result read_inner_list(parser &p, view_type key);
+    static result read_parameters(parser &p, std::size_t owner);
+    static bool read_bare_item(parser &p, node &n);
+    static bool read_number(parser &p, node &n);
+    static bool read_string(parser &p, node &n);
+    static bool read_token(parser &p, node &n);
+    static bool read_byte_sequence(parser &p, node &n);
+    static bool read_key(parser &p, view_type &key);
+    static void skip_sp(parser &p);
+    static void skip_ows(parser &p);
+
+    static void write_member(writer &w, const node *member);
+    static void write_bare_item(writer &w, const node &n);
+    static void write_parameters(writer &w, const node *member);
+    static void write_integer(writer &w, boost::uint64_t value);
+};
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
+
+#include "structured_field.ipp"
+
+#endif // BOOST_HTTP_SYNTAX_STRUCTURED_FIELD_HPP
@@ -0,0 +1,686 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace syntax {
+
+namespace detail {
+
+template<class CharT>
+bool is_lcalpha(CharT c)
+{
+    return c >= 'a' && c <= 'z';
+}
+
+template<class CharT>
+bool is_sf_tchar(CharT c)
+{
+    /* tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*"
+             / "+" / "-" / "." / "^" / "_" / "`" / "|" / "~"
+             / DIGIT / ALPHA
+
+       The token of a structured field also accepts ":" and "/". Unlike the
+       `is_tchar` used by `field_name`, no locale is involved. */
+    switch (c) {
+    case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+    case '+': case '-': case '.': case '^': case '_': case '`': case '|':
+    case '~': case ':': case '/':
+        return true;
+    default:
+        return is_alpha(c) || is_digit(c);
+    }
+}
+
+template<class CharT>
+bool is_base64_char(CharT c)
+{
+    return is_alpha(c) || is_digit(c) || c == '+' || c == '/' || c == '=';
+}
+
+} // namespace detail
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::parse_item(view_type in, node *out,
+                                    std::size_t max_nodes, std::size_t &nnodes)
+{
+    parser p = { in.data(), in.data() + in.size(), out, max_nodes, 0 };
+    nnodes = 0;
+
+    // Section 4.2 of RFC8941: leading and trailing SP are discarded
+    skip_sp(p);
+    while (p.last != p.first && *(p.last - 1) == ' ')
+        --p.last;
+
+    result r = read_item(p, view_type());
+    if (r != result::ok)
+        return r;
+
+    if (p.first != p.last)
+        return result::invalid;
+
+    return finish(p, nnodes);
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::parse_list(view_type in, node *out,
+                                    std::size_t max_nodes, std::size_t &nnodes)
+{
+    parser p = { in.data(), in.data() + in.size(), out, max_nodes, 0 };
+    nnodes = 0;
+
+    skip_sp(p);
+    while (p.last != p.first && *(p.last - 1) == ' ')
+        --p.last;
+
+    // An empty list is a valid list
+    if (p.first == p.last)
+        return finish(p, nnodes);
+
+    for (;;) {
+        result r = read_member(p, view_type());
+        if (r != result::ok)
+            return r;
+
+        skip_ows(p);
+        if (p.first == p.last)
+            return finish(p, nnodes);
+
+        if (*p.first != ',')
+            return result::invalid;
+
+        ++p.first;
+        skip_ows(p);
+
+        // trailing comma
+        if (p.first == p.last)
+            return result::invalid;
+    }
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::parse_dictionary(view_type in, node *out,
+                                          std::size_t max_nodes,
+                                          std::size_t &nnodes)
+{
+    parser p = { in.data(), in.data() + in.size(), out, max_nodes, 0 };
+    nnodes = 0;
+
+    skip_sp(p);
+    while (p.last != p.first && *(p.last - 1) == ' ')
+        --p.last;
+
+    if (p.first == p.last)
+        return finish(p, nnodes);
+
+    for (;;) {
+        view_type key;
+        if (!read_key(p, key))
+            return result::invalid;
+
+        result r;
+        if (p.first != p.last && *p.first == '=') {
+            ++p.first;
+            r = read_member(p, key);
+        } else {
+            // A member without value is the boolean true
+            std::size_t idx;
+            r = push(p, key, idx);
+            if (r == result::ok) {
+                p.out[idx].type = node_type::boolean;
+                p.out[idx].number = 1;
+                r = read_parameters(p, idx);
+            }
+        }
+        if (r != result::ok)
+            return r;
+
+        skip_ows(p);
+        if (p.first == p.last)
+            return finish(p, nnodes);
+
+        if (*p.first != ',')
+            return result::invalid;
+
+        ++p.first;
+        skip_ows(p);
+
+        if (p.first == p.last)
+            return result::invalid;
+    }
+}
+
+template<class CharT>
+std::size_t
+structured_field<CharT>::serialize_item(const node *nodes, std::size_t nnodes,
+                                        CharT *out, std::size_t out_size)
+{
+    writer w = { out, out_size, 0 };
+    if (nnodes != 0)
+        write_member(w, nodes);
+    return w.size;
+}
+
+template<class CharT>
+std::size_t
+structured_field<CharT>::serialize_list(const node *nodes, std::size_t nnodes,
+                                        CharT *out, std::size_t out_size)
+{
+    writer w = { out, out_size, 0 };
+    for (std::size_t i = 0 ; i < nnodes ; i += nodes[i].size) {
+        if (i != 0) {
+            w.put(',');
+            w.put(' ');
+        }
+        write_member(w, nodes + i);
+    }
+    return w.size;
+}
+
+template<class CharT>
+std::size_t
+structured_field<CharT>::serialize_dictionary(const node *nodes,
+                                              std::size_t nnodes, CharT *out,
+                                              std::size_t out_size)
+{
+    writer w = { out, out_size, 0 };
+    for (std::size_t i = 0 ; i < nnodes ; i += nodes[i].size) {
+        const node &member = nodes[i];
+
+        if (i != 0) {
+            w.put(',');
+            w.put(' ');
+        }
+
+        w.put(member.key);
+        if (member.type == node_type::boolean && member.number == 1) {
+            write_parameters(w, &member);
+        } else {
+            w.put('=');
+            write_member(w, &member);
+        }
+    }
+    return w.size;
+}
+
+template<class CharT>
+const typename structured_field<CharT>::node *
+structured_field<CharT>::find_member(const node *nodes, std::size_t nnodes,
+                                     view_type key)
+{
+    const node *ret = NULL;
+    for (std::size_t i = 0 ; i < nnodes ; i += nodes[i].size) {
+        if (nodes[i].key == key)
+            ret = nodes + i;
+    }
+    return ret;
+}
+
+template<class CharT>
+const typename structured_field<CharT>::node *
+structured_field<CharT>::find_parameter(const node &member, view_type key)
+{
+    const node *ret = NULL;
+    const node *last = &member + member.size;
+    for (const node *it = last - member.nparams ; it != last ; ++it) {
+        if (it->key == key)
+            ret = it;
+    }
+    return ret;
+}
+
+template<class CharT>
+std::size_t structured_field<CharT>::unescape(view_type text, CharT *out)
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0 ; i != text.size() ; ++i) {
+        if (text[i] == '\\' && i + 1 != text.size())
+            ++i;
+
+        out[size++] = text[i];
+    }
+    return size;
+}
+
+template<class CharT>
+void structured_field<CharT>::writer::put(CharT c)
+{
+    if (size < out_size)
+        out[size] = c;
+
+    ++size;
+}
+
+template<class CharT>
+void structured_field<CharT>::writer::put(view_type v)
+{
+    for (std::size_t i = 0 ; i != v.size() ; ++i)
+        put(v[i]);
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::finish(parser &p, std::size_t &nnodes)
+{
+    nnodes = p.nnodes;
+    return result::ok;
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::push(parser &p, view_type key, std::size_t &idx)
+{
+    if (p.nnodes == p.max_nodes)
+        return result::too_many_nodes;
+
+    idx = p.nnodes++;
+
+    node &n = p.out[idx];
+    n.key = key;
+    n.text = view_type();
+    n.number = 0;
+    n.size = 1;
+    n.nparams = 0;
+
+    return result::ok;
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::read_member(parser &p, view_type key)
+{
+    if (p.first != p.last && *p.first == '(')
+        return read_inner_list(p, key);
+
+    return read_item(p, key);
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::read_item(parser &p, view_type key)
+{
+    std::size_t idx;
+    result r = push(p, key, idx);
+    if (r != result::ok)
+        return r;
+
+    if (!read_bare_item(p, p.out[idx]))
+        return result::invalid;
+
+    return read_parameters(p, idx);
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::read_inner_list(parser &p, view_type key)
+{
+    std::size_t idx;
+    result r = push(p, key, idx);
+    if (r != result::ok)
+        return r;
+
+    p.out[idx].type = node_type::inner_list;
+
+    // '('
+    ++p.first;
+
+    for (;;) {
+        skip_sp(p);
+        if (p.first == p.last)
+            return result::invalid;
+
+        if (*p.first == ')') {
+            ++p.first;
+            return read_parameters(p, idx);
+        }
+
+        r = read_item(p, view_type());
+        if (r != result::ok)
+            return r;
+
+        if (p.first == p.last || (*p.first != ' ' && *p.first != ')'))
+            return result::invalid;
+    }
+}
+
+template<class CharT>
+typename structured_field<CharT>::result
+structured_field<CharT>::read_parameters(parser &p, std::size_t owner)
+{
+    while (p.first != p.last && *p.first == ';') {
+        ++p.first;
+        skip_sp(p);
+
+        view_type key;
+        if (!read_key(p, key))
+            return result::invalid;
+
+        std::size_t idx;
+        result r = push(p, key, idx);
+        if (r != result::ok)
+            return r;
+
+        node &n = p.out[idx];
+        if (p.first != p.last && *p.first == '=') {
+            ++p.first;
+            if (!read_bare_item(p, n))
+                return result::invalid;
+        } else {
+            n.type = node_type::boolean;
+            n.number = 1;
+        }
+
+        ++p.out[owner].nparams;
+    }
+
+    p.out[owner].size = p.nnodes - owner;
+    return result::ok;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_bare_item(parser &p, node &n)
+{
+    if (p.first == p.last)
+        return false;
+
+    CharT c = *p.first;
+
+    if (c == '-' || detail::is_digit(c))
+        return read_number(p, n);
+
+    if (c == '"')
+        return read_string(p, n);
+
+    if (c == '*' || detail::is_alpha(c))
+        return read_token(p, n);
+
+    if (c == ':')
+        return read_byte_sequence(p, n);
+
+    if (c == '?') {
+        ++p.first;
+        if (p.first == p.last || (*p.first != '0' && *p.first != '1'))
+            return false;
+
+        n.type = node_type::boolean;
+        n.number = *p.first - '0';
+        ++p.first;
+        return true;
+    }
+
+    return false;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_number(parser &p, node &n)
+{
+    /* Section 4.2.4 of RFC8941. Integers have at most 15 digits and decimals
+       at most 12 integral digits and 3 fractional digits. */
+    bool negative = false;
+    if (*p.first == '-') {
+        negative = true;
+        ++p.first;
+    }
+
+    if (p.first == p.last || !detail::is_digit(*p.first))
+        return false;
+
+    boost::int64_t value = 0;
+    int int_digits = 0;
+    for ( ; p.first != p.last && detail::is_digit(*p.first) ; ++p.first) {
+        if (++int_digits > 15)
+            return false;
+
+        value = value * 10 + (*p.first - '0');
+    }
+
+    if (p.first != p.last && *p.first == '.') {
+        if (int_digits > 12)
+            return false;
+
+        ++p.first;
+
+        int frac_digits = 0;
+        for ( ; p.first != p.last && detail::is_digit(*p.first) ; ++p.first) {
+            if (++frac_digits > 3)
+                return false;
+
+            value = value * 10 + (*p.first - '0');
+        }
+
+        if (frac_digits == 0)
+            return false;
+
+        for ( ; frac_digits != 3 ; ++frac_digits)
+            value *= 10;
+
+        n.type = node_type::decimal;
+    } else {
+        n.type = node_type::integer;
+    }
+
+    n.number = negative ? -value : value;
+    return true;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_string(parser &p, node &n)
+{
+    // DQUOTE
+    const CharT *begin = ++p.first;
+
+    while (p.first != p.last) {
+        unsigned char c = *p.first;
+
+        if (c == '\\') {
+            ++p.first;
+            if (p.first == p.last || (*p.first != '"' && *p.first != '\\'))
+                return false;
+
+            ++p.first;
+            continue;
+        }
+
+        if (c == '"') {
+            n.type = node_type::string;
+            n.text = view_type(begin, p.first - begin);
+            ++p.first;
+            return true;
+        }
+
+        if (c < 0x20 || c > 0x7E)
+            return false;
+
+        ++p.first;
+    }
+
+    return false;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_token(parser &p, node &n)
+{
+    const CharT *begin = p.first++;
+
+    while (p.first != p.last && detail::is_sf_tchar(*p.first))
+        ++p.first;
+
+    n.type = node_type::token;
+    n.text = view_type(begin, p.first - begin);
+    return true;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_byte_sequence(parser &p, node &n)
+{
+    // ':'
+    const CharT *begin = ++p.first;
+
+    while (p.first != p.last && *p.first != ':') {
+        if (!detail::is_base64_char(*p.first))
+            return false;
+
+        ++p.first;
+    }
+
+    if (p.first == p.last)
+        return false;
+
+    n.type = node_type::byte_sequence;
+    n.text = view_type(begin, p.first - begin);
+    ++p.first;
+    return true;
+}
+
+template<class CharT>
+bool structured_field<CharT>::read_key(parser &p, view_type &key)
+{
+    // key = ( lcalpha / "*" ) *( lcalpha / DIGIT / "_" / "-" / "." / "*" )
+    if (p.first == p.last
+        || !(detail::is_lcalpha(*p.first) || *p.first == '*')) {
+        return false;
+    }
+
+    const CharT *begin = p.first++;
+
+    for ( ; p.first != p.last ; ++p.first) {
+        CharT c = *p.first;
+        if (!(detail::is_lcalpha(c) || detail::is_digit(c) || c == '_'
+              || c == '-' || c == '.' || c == '*')) {
+            break;
+        }
+    }
+
+    key = view_type(begin, p.first - begin);
+    return true;
+}
+
+template<class CharT>
+void structured_field<CharT>::skip_sp(parser &p)
+{
+    while (p.first != p.last && *p.first == ' ')
+        ++p.first;
+}
+
+template<class CharT>
+void structured_field<CharT>::skip_ows(parser &p)
+{
+    while (p.first != p.last && (*p.first == ' ' || *p.first == '\t'))
+        ++p.first;
+}
+
+template<class CharT>
+void structured_field<CharT>::write_member(writer &w, const node *member)
+{
+    if (member->type == node_type::inner_list) {
+        w.put('(');
+
+        const node *first = member + 1;
+        const node *last = member + member->size - member->nparams;
+        for (const node *it = first ; it != last ; it += it->size) {
+            if (it != first)
+                w.put(' ');
+
+            write_bare_item(w, *it);
+            write_parameters(w, it);
+        }
+
+        w.put(')');
+    } else {
+        write_bare_item(w, *member);
+    }
+
+    write_parameters(w, member);
+}
+
+template<class CharT>
+void structured_field<CharT>::write_bare_item(writer &w, const node &n)
+{
+    switch (native_value(n.type)) {
+    case node_type::integer:
+        if (n.number < 0)
+            w.put('-');
+
+        write_integer(w, n.number < 0 ? -n.number : n.number);
+        break;
+    case node_type::decimal:
+        {
+            if (n.number < 0)
+                w.put('-');
+
+            boost::uint64_t value = n.number < 0 ? -n.number : n.number;
+            unsigned frac = value % 1000;
+
+            write_integer(w, value / 1000);
+            w.put('.');
+
+            // At least one fractional digit and no trailing zeros
+            w.put('0' + frac / 100);
+            if (frac % 100 != 0) {
+                w.put('0' + frac / 10 % 10);
+                if (frac % 10 != 0)
+                    w.put('0' + frac % 10);
+            }
+        }
+        break;
+    case node_type::string:
+        w.put('"');
+        w.put(n.text);
+        w.put('"');
+        break;
+    case node_type::token:
+        w.put(n.text);
+        break;
+    case node_type::byte_sequence:
+        w.put(':');
+        w.put(n.text);
+        w.put(':');
+        break;
+    case node_type::boolean:
+        w.put('?');
+        w.put(n.number ? '1' : '0');
+        break;
+    case node_type::inner_list:
+        BOOST_HTTP_DETAIL_UNREACHABLE("inner lists can't be nested");
+    }
+}
+
+template<class CharT>
+void structured_field<CharT>::write_parameters(writer &w, const node *member)
+{
+    const node *last = member + member->size;
+    for (const node *it = last - member->nparams ; it != last ; ++it) {
+        w.put(';');
+        w.put(it->key);
+
+        if (it->type == node_type::boolean && it->number == 1)
+            continue;
+
+        w.put('=');
+        write_bare_item(w, *it);
+    }
+}
+
+template<class CharT>
+void structured_field<CharT>::write_integer(writer &w, boost::uint64_t value)
+{
+    CharT digits[20];
+    int i = 0;
+
+    do {
+        digits[i++] = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+
+    while (i != 0)
+        w.put(digits[--i]);
+}
+
+} // namespace syntax
+} // namespace http
+} // namespace boost
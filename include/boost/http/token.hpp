@@ -29,6 +29,8 @@ struct code
         error_content_length_overflow,
         error_invalid_transfer_encoding,
         error_chunk_size_overflow,
+        // A frame (e.g. WebSocket) is bigger than the configured limit
+        error_frame_too_big,
         // used to skip unneeded bytes so user can keep buffer small when asking
         // for more data
         skip,
@@ -44,7 +46,10 @@ struct code
         end_of_body,
         trailer_name,
         trailer_value,
-        end_of_message
+        end_of_message,
+        websocket_frame,
+        http2_frame,
+        http2_setting
     };
 };
 
@@ -73,7 +78,12 @@ struct symbol
         trailer_name,
         trailer_value,
 
-        end_of_message
+        end_of_message,
+
+        websocket_frame,
+
+        http2_frame,
+        http2_setting
     };
 
     static value convert(code::value);
@@ -176,6 +186,124 @@ struct reason_phrase
     static const token::code::value code = token::code::reason_phrase;
 };
 
+struct websocket_frame
+{
+    // section 5.2 of RFC6455
+    struct opcode
+    {
+        enum value
+        {
+            continuation = 0x0,
+            text = 0x1,
+            binary = 0x2,
+            close = 0x8,
+            ping = 0x9,
+            pong = 0xA
+        };
+    };
+
+    struct type
+    {
+        bool fin;
+        // Set by extensions (e.g. permessage-deflate on compressed messages)
+        bool rsv1;
+        websocket_frame::opcode::value opcode;
+        uint_least64_t payload_size;
+    };
+
+    static const token::code::value code = token::code::websocket_frame;
+};
+
+struct http2_frame
+{
+    // section 6 of RFC9113
+    struct frame_type
+    {
+        enum value
+        {
+            data = 0x0,
+            headers = 0x1,
+            priority = 0x2,
+            rst_stream = 0x3,
+            settings = 0x4,
+            push_promise = 0x5,
+            ping = 0x6,
+            goaway = 0x7,
+            window_update = 0x8,
+            continuation = 0x9
+        };
+    };
+
+    struct flags
+    {
+        enum value
+        {
+            end_stream = 0x1,
+            ack = 0x1,
+            end_headers = 0x4,
+            padded = 0x8,
+            priority = 0x20
+        };
+    };
+
+    struct type
+    {
+        // Frames of unknown types are reported too (and must be ignored)
+        uint_least8_t frame_type;
+        uint_least8_t flags;
+        uint_least32_t stream_id;
+
+        /* Size of the payload reported through `body_chunk` tokens (i.e. the
+           frame length minus padding and the fields below) */
+        uint_least32_t payload_size;
+        uint_least8_t pad_length;
+
+        // HEADERS (with the PRIORITY flag) and PRIORITY
+        uint_least32_t stream_dependency;
+        bool exclusive;
+        uint_least8_t weight;
+
+        // RST_STREAM and GOAWAY
+        uint_least32_t error_code;
+
+        // PUSH_PROMISE
+        uint_least32_t promised_stream_id;
+
+        // GOAWAY
+        uint_least32_t last_stream_id;
+
+        // WINDOW_UPDATE
+        uint_least32_t window_size_increment;
+    };
+
+    static const token::code::value code = token::code::http2_frame;
+};
+
+struct http2_setting
+{
+    // section 6.5.2 of RFC9113
+    struct identifier
+    {
+        enum value
+        {
+            header_table_size = 0x1,
+            enable_push = 0x2,
+            max_concurrent_streams = 0x3,
+            initial_window_size = 0x4,
+            max_frame_size = 0x5,
+            max_header_list_size = 0x6
+        };
+    };
+
+    struct type
+    {
+        uint_least16_t identifier;
+        uint_least32_t value;
+    };
+
+    static const token::code::value code = token::code::http2_setting;
+};
+
 } // namespace token
 } // namespace http
 } // namespace boost
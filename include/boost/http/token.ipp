@@ -19,6 +19,7 @@ inline symbol::value symbol::convert(code::value v)
     case code::error_content_length_overflow:
     case code::error_invalid_transfer_encoding:
     case code::error_chunk_size_overflow:
+    case code::error_frame_too_big:
         return error;
     case code::skip:
         return skip;
@@ -48,6 +49,12 @@ inline symbol::value symbol::convert(code::value v)
         return trailer_value;
     case code::end_of_message:
         return end_of_message;
+    case code::websocket_frame:
+        return websocket_frame;
+    case code::http2_frame:
+        return http2_frame;
+    case code::http2_setting:
+        return http2_setting;
     }
 }
 
@@ -63,6 +70,7 @@ inline category::value category::convert(code::value v)
     case code::error_content_length_overflow:
     case code::error_invalid_transfer_encoding:
     case code::error_chunk_size_overflow:
+    case code::error_frame_too_big:
     case code::skip:
         return status;
     case code::method:
@@ -75,6 +83,9 @@ inline category::value category::convert(code::value v)
     case code::body_chunk:
     case code::trailer_name:
     case code::trailer_value:
+    case code::websocket_frame:
+    case code::http2_frame:
+    case code::http2_setting:
         return data;
     case code::end_of_headers:
     case code::end_of_body:
@@ -99,6 +110,9 @@ inline category::value category::convert(symbol::value v)
     case symbol::body_chunk:
     case symbol::trailer_name:
     case symbol::trailer_value:
+    case symbol::websocket_frame:
+    case symbol::http2_frame:
+    case symbol::http2_setting:
         return data;
     case symbol::end_of_headers:
     case symbol::end_of_body:
@@ -0,0 +1,130 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WEBSOCKET_HANDSHAKE_HPP
+#define BOOST_HTTP_WEBSOCKET_HANDSHAKE_HPP
+
+// private
+
+#include <cstring>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/http/algorithm/header/header_value_any_of.hpp>
+#include <boost/http/detail/sha1.hpp>
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/asio/buffer.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/token.hpp>
+
+namespace boost {
+namespace http {
+
+/* Server side of the WebSocket opening handshake (section 4.2 of RFC6455). The
+   tokens of the upgrade request are given as they come out of
+   `reader::request` and, once `end_of_headers` is seen, the outcome can be
+   queried and the response written into a caller-provided buffer.
+
+   Only the fields relevant to the handshake are looked at and nothing is
+   allocated. The subprotocol and extension negotiation
+   (Sec-WebSocket-Protocol and Sec-WebSocket-Extensions) is left to the
+   user. */
+class websocket_handshake
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef boost::string_view view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(result)
+    {
+        // `end_of_headers` wasn't seen yet
+        incomplete,
+        accepted,
+        // not a WebSocket upgrade (i.e. a plain HTTP request)
+        not_upgrade,
+        // a malformed upgrade (answer with 400)
+        bad_request,
+        // Sec-WebSocket-Version isn't 13 (answer with 426)
+        unsupported_version
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(result)
+
+    // Size of Sec-WebSocket-Key and of Sec-WebSocket-Accept
+    static const size_type key_size = 24;
+    static const size_type accept_size = 28;
+
+    // Size of the 101 response written by `write_response()`
+    static const size_type response_size = 129;
+
+    websocket_handshake();
+
+    void reset();
+
+    /* Inspects the current token of `parser` (e.g. a `reader::request`). Every
+       token of the request head must be given in order, up to
+       `end_of_headers`. */
+    template<class Reader>
+    void put(const Reader &parser);
+
+    result get_result() const;
+
+    /* Writes the response matching `get_result()` (only `accepted` and
+       `unsupported_version` have one) into `out` and returns its size. Returns
+       0 if `out` is too small. `extra_fields` is copied verbatim before the
+       empty line that ends the head (each field must end with CRLF). */
+    size_type write_response(asio::mutable_buffer out,
+                             view_type extra_fields = view_type()) const;
+
+    /* Computes the Sec-WebSocket-Accept value of `key` into `out`. */
+    static void accept_key(const char (&key)[key_size],
+                           char (&out)[accept_size]);
+
+private:
+    enum Field {
+        OTHER,
+        HOST,
+        UPGRADE,
+        CONNECTION,
+        KEY,
+        VERSION
+    };
+
+    void put_method(view_type method);
+    void put_version(int version);
+    void put_field_name(view_type name);
+    void put_field_value(view_type value);
+    void finish();
+
+    static bool is_valid_key(view_type key);
+
+    result result_;
+    Field field;
+
+    bool method_ok;
+    bool version_ok;
+    bool host;
+    bool upgrade;
+    bool connection;
+    // number of Sec-WebSocket-Key fields
+    int keys;
+    bool key_ok;
+    // number of Sec-WebSocket-Version fields
+    int versions;
+    bool version13;
+
+    char key[key_size];
+};
+
+} // namespace http
+} // namespace boost
+
+#include "websocket_handshake.ipp"
+
+#endif // BOOST_HTTP_WEBSOCKET_HANDSHAKE_HPP
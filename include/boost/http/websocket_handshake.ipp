@@ -0,0 +1,312 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+
+namespace detail {
+
+struct iequals_to
+{
+    explicit iequals_to(const char *s)
+        : s(s)
+    {}
+
+    bool operator()(string_view v) const
+    {
+        return boost::algorithm::iequals(v, s);
+    }
+
+    const char *s;
+};
+
+} // namespace detail
+
+inline websocket_handshake::websocket_handshake()
+{
+    reset();
+}
+
+inline void websocket_handshake::reset()
+{
+    result_ = result::incomplete;
+    field = OTHER;
+    method_ok = false;
+    version_ok = false;
+    host = false;
+    upgrade = false;
+    connection = false;
+    keys = 0;
+    key_ok = false;
+    versions = 0;
+    version13 = false;
+}
+
+template<class Reader>
+void websocket_handshake::put(const Reader &parser)
+{
+    if (result_ != result::incomplete)
+        return;
+
+    switch (parser.code()) {
+    case token::code::method:
+        put_method(parser.template value<token::method>());
+        break;
+    case token::code::version:
+        put_version(parser.template value<token::version>());
+        break;
+    case token::code::field_name:
+        put_field_name(parser.template value<token::field_name>());
+        break;
+    case token::code::field_value:
+        put_field_value(parser.template value<token::field_value>());
+        break;
+    case token::code::end_of_headers:
+        finish();
+        break;
+    default:
+        break;
+    }
+}
+
+inline websocket_handshake::result websocket_handshake::get_result() const
+{
+    return result_;
+}
+
+inline websocket_handshake::size_type
+websocket_handshake::write_response(asio::mutable_buffer out,
+                                    view_type extra_fields) const
+{
+    view_type head;
+    size_type size = 0;
+
+    switch (native_value(result_)) {
+    case result::accepted:
+        head = "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: ";
+        size = head.size() + accept_size + 2;
+        break;
+    case result::unsupported_version:
+        // section 4.4 of RFC6455
+        head = "HTTP/1.1 426 Upgrade Required\r\n"
+            "Sec-WebSocket-Version: 13\r\n"
+            "Content-Length: 0\r\n";
+        size = head.size();
+        break;
+    case result::incomplete:
+    case result::not_upgrade:
+    case result::bad_request:
+        return 0;
+    }
+
+    size += extra_fields.size() + 2;
+    if (out.size() < size)
+        return 0;
+
+    char *p = static_cast<char*>(out.data());
+
+    std::memcpy(p, head.data(), head.size());
+    p += head.size();
+
+    if (result_ == result::accepted) {
+        char accept[accept_size];
+        accept_key(key, accept);
+        std::memcpy(p, accept, accept_size);
+        p += accept_size;
+        std::memcpy(p, "\r\n", 2);
+        p += 2;
+    }
+
+    if (extra_fields.size() != 0) {
+        std::memcpy(p, extra_fields.data(), extra_fields.size());
+        p += extra_fields.size();
+    }
+
+    std::memcpy(p, "\r\n", 2);
+    return size;
+}
+
+inline void websocket_handshake::accept_key(const char (&key)[key_size],
+                                            char (&out)[accept_size])
+{
+    /* The input is the key followed by the GUID from section 1.3 of RFC6455
+       ("258EAFA5-E914-47DA-95CA-C5AB0DC85B11"). 60 bytes plus the padding
+       don't fit in a single block, but only the first 6 words of the message
+       depend on the key. */
+    static const uint32_t guid[9] = {
+        0x32353845, 0x41464135, 0x2D453931, 0x342D3437, 0x44412D39,
+        0x3543412D, 0x43354142, 0x30444338, 0x35423131
+    };
+
+    /* The second block holds nothing but the padding and the message length
+       (480 bits), so its message schedule is a constant. */
+    static const uint32_t padding[80] = {
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x000001E0,
+        0x00000000, 0x00000000, 0x000003C0, 0x00000000,
+        0x00000000, 0x00000780, 0x00000000, 0x000003C0,
+        0x00000F00, 0x00000000, 0x00000000, 0x00001E00,
+        0x00000000, 0x00000CC0, 0x00003C00, 0x00000440,
+        0x00000000, 0x00007800, 0x00000F00, 0x00003300,
+        0x0000F000, 0x00000F00, 0x00000000, 0x0001EF00,
+        0x00000000, 0x0000CC00, 0x0003C000, 0x00004380,
+        0x00000000, 0x00078F00, 0x0000FF00, 0x00032680,
+        0x000F0000, 0x0000F000, 0x00003300, 0x001EFF00,
+        0x00000000, 0x000CB800, 0x003C0000, 0x00040B00,
+        0x0000F000, 0x0078FF00, 0x000FF000, 0x00338700,
+        0x00F00000, 0x000FC300, 0x0000F000, 0x01EFBB00,
+        0x00000000, 0x00CC0000, 0x03C0F000, 0x00438000,
+        0x00000000, 0x078F0000, 0x00FF0000, 0x03269E00,
+        0x0F000000, 0x00F0F000, 0x00333C00, 0x1EFF8800,
+        0x00000000, 0x0CB88800, 0x3C00F000, 0x040A4A00
+    };
+
+    static const char alphabet[]
+        = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    uint32_t w[80];
+    for (int i = 0 ; i != 6 ; ++i) {
+        const unsigned char *k
+            = reinterpret_cast<const unsigned char*>(key) + i * 4;
+        w[i] = (uint32_t(k[0]) << 24) | (uint32_t(k[1]) << 16)
+            | (uint32_t(k[2]) << 8) | k[3];
+    }
+    std::memcpy(w + 6, guid, sizeof(guid));
+    w[15] = 0x80000000;
+    detail::sha1_expand(w);
+
+    uint32_t h[5];
+    detail::sha1_init(h);
+    detail::sha1_compress(h, w);
+    detail::sha1_compress(h, padding);
+
+    // 20 bytes of digest plus a zero byte to complete the last base64 group
+    unsigned char digest[21];
+    for (int i = 0 ; i != 20 ; ++i)
+        digest[i] = static_cast<unsigned char>(h[i / 4] >> (24 - i % 4 * 8));
+    digest[20] = 0;
+
+    for (int i = 0 ; i != 7 ; ++i) {
+        uint32_t group = (uint32_t(digest[i * 3]) << 16)
+            | (uint32_t(digest[i * 3 + 1]) << 8) | digest[i * 3 + 2];
+        out[i * 4] = alphabet[group >> 18];
+        out[i * 4 + 1] = alphabet[(group >> 12) & 0x3F];
+        out[i * 4 + 2] = alphabet[(group >> 6) & 0x3F];
+        out[i * 4 + 3] = alphabet[group & 0x3F];
+    }
+    out[27] = '=';
+}
+
+inline void websocket_handshake::put_method(view_type method)
+{
+    // The method is case-sensitive (section 4.1 of RFC7231)
+    method_ok = method == "GET";
+}
+
+inline void websocket_handshake::put_version(int version)
+{
+    // HTTP/1.1 or higher (section 4.1 of RFC6455)
+    version_ok = version >= 1;
+}
+
+inline void websocket_handshake::put_field_name(view_type name)
+{
+    using boost::algorithm::iequals;
+
+    if (iequals(name, "Host"))
+        field = HOST;
+    else if (iequals(name, "Upgrade"))
+        field = UPGRADE;
+    else if (iequals(name, "Connection"))
+        field = CONNECTION;
+    else if (iequals(name, "Sec-WebSocket-Key"))
+        field = KEY;
+    else if (iequals(name, "Sec-WebSocket-Version"))
+        field = VERSION;
+    else
+        field = OTHER;
+}
+
+inline void websocket_handshake::put_field_value(view_type value)
+{
+    switch (field) {
+    case OTHER:
+        break;
+    case HOST:
+        host = true;
+        break;
+    case UPGRADE:
+        if (header_value_any_of(value, detail::iequals_to("websocket")))
+            upgrade = true;
+        break;
+    case CONNECTION:
+        if (header_value_any_of(value, detail::iequals_to("upgrade")))
+            connection = true;
+        break;
+    case KEY:
+        ++keys;
+        key_ok = is_valid_key(value);
+        if (key_ok)
+            std::memcpy(key, value.data(), key_size);
+        break;
+    case VERSION:
+        ++versions;
+        version13 = value == "13";
+        break;
+    }
+}
+
+inline void websocket_handshake::finish()
+{
+    if (!upgrade) {
+        result_ = result::not_upgrade;
+    } else if (!method_ok || !version_ok || !host || !connection || keys != 1
+               || !key_ok || versions == 0) {
+        result_ = result::bad_request;
+    } else if (versions != 1 || !version13) {
+        result_ = result::unsupported_version;
+    } else {
+        result_ = result::accepted;
+    }
+}
+
+inline bool websocket_handshake::is_valid_key(view_type key)
+{
+    /* The base64 encoding of 16 bytes (section 4.1 of RFC6455): 21 characters
+       carrying 6 bits, a character carrying the last 2 bits (and 4 zeroed
+       bits) and the padding. */
+    if (key.size() != key_size || key.substr(22) != "==")
+        return false;
+
+    for (size_type i = 0 ; i != 22 ; ++i) {
+        unsigned char c = key[i];
+        unsigned v;
+        if (c >= 'A' && c <= 'Z')
+            v = c - 'A';
+        else if (c >= 'a' && c <= 'z')
+            v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9')
+            v = c - '0' + 52;
+        else if (c == '+')
+            v = 62;
+        else if (c == '/')
+            v = 63;
+        else
+            return false;
+
+        if (i == 21 && (v & 0xF) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace http
+} // namespace boost
@@ -0,0 +1,137 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WRITER_CONTENT_ENCODER_HPP
+#define BOOST_HTTP_WRITER_CONTENT_ENCODER_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+#include <boost/http/detail/macros.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/writer/deflate_pool.hpp>
+
+namespace boost {
+namespace http {
+namespace writer {
+
+/* Compresses a message body with the gzip or deflate codings (section 4.2 of
+   RFC7230) into output windows provided by the caller. Optionally, every
+   window is written as a complete chunk of the chunked transfer coding, so it
+   can be handed to the socket (or to `pipeline`) without any copy.
+
+   The deflate stream is taken from a `deflate_pool` when the body starts and
+   given back once it ends. Bodies known to be smaller than `min_size()` are
+   not compressed. Requires zlib. */
+class content_encoder
+{
+public:
+    // types
+    typedef std::size_t size_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(coding)
+    {
+        identity,
+        gzip,
+        deflate
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(coding)
+
+    // `chunk-size CRLF` (8 hexadecimal digits) written before chunk data
+    static const size_type chunk_header_size = 10;
+    // CRLF written after chunk data
+    static const size_type chunk_trailer_size = 2;
+    // `last-chunk CRLF`
+    static const size_type last_chunk_size = 5;
+
+    static const uint_least64_t unknown_size = uint_least64_t(-1);
+
+    explicit content_encoder(deflate_pool &pool, size_type min_size = 1024);
+    ~content_encoder();
+
+    /* Starts a new body and returns the coding that is going to be applied
+       (i.e. the Content-Encoding to announce). If `body_size` is smaller than
+       `min_size()` or no stream can be taken from the pool, the identity coding
+       is used instead of `c`.
+
+       If `chunked` is `true`, the output is framed with the chunked transfer
+       coding (trailers aren't supported). */
+    coding start(coding c, bool chunked, uint_least64_t body_size = unknown_size);
+
+    /* Encodes as much of `in` as fits in `out`. `consumed` and `produced` are
+       set to the number of bytes read from `in` and written to `out`.
+
+       `finish` tells that `in` holds the rest of the body. Returns `true` once
+       the whole output (including the gzip/zlib trailer and the last chunk)
+       was produced. Unless `finish` is given, `produced` might be 0 as the
+       compressor buffers data internally.
+
+       If the output is chunked, `out` must be greater than `chunk_header_size +
+       chunk_trailer_size`. */
+    bool encode(asio::const_buffer in, asio::mutable_buffer out, bool finish,
+                size_type &consumed, size_type &produced);
+
+    coding get_coding() const;
+    bool chunked() const;
+
+    void set_min_size(size_type size);
+    size_type min_size() const;
+
+private:
+    enum State {
+        IDLE,
+        ENCODING,
+        // the gzip/zlib trailer is being written
+        TRAILER,
+        // only the last chunk is missing
+        FINISHED,
+        DONE
+    };
+
+    // non-copyable
+    content_encoder(const content_encoder&);
+    content_encoder &operator=(const content_encoder&);
+
+    size_type fill(unsigned char *out, size_type out_size,
+                   asio::const_buffer in, bool finish, size_type &consumed);
+    size_type drain(unsigned char *out, size_type out_size);
+    void finish_stream();
+    void release();
+
+    deflate_pool &pool;
+    z_stream *stream;
+    size_type min_size_;
+
+    State state;
+    coding coding_;
+    bool chunked_;
+
+    // crc32 for gzip, adler32 for zlib
+    uLong checksum;
+    uint_least32_t in_size;
+
+    // gzip/zlib header or trailer not written yet
+    unsigned char pending[10];
+    size_type pending_idx;
+    size_type pending_size;
+};
+
+} // namespace writer
+} // namespace http
+} // namespace boost
+
+#include "content_encoder.ipp"
+
+#endif // BOOST_HTTP_WRITER_CONTENT_ENCODER_HPP
@@ -0,0 +1,261 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace writer {
+
+inline content_encoder::content_encoder(deflate_pool &pool, size_type min_size)
+    : pool(pool)
+    , stream(NULL)
+    , min_size_(min_size)
+    , state(IDLE)
+    , coding_(coding::identity)
+    , chunked_(false)
+    , checksum(0)
+    , in_size(0)
+    , pending_idx(0)
+    , pending_size(0)
+{}
+
+inline content_encoder::~content_encoder()
+{
+    release();
+}
+
+inline content_encoder::coding
+content_encoder::start(coding c, bool chunked, uint_least64_t body_size)
+{
+    release();
+
+    if (body_size != unknown_size && body_size < min_size_)
+        c = coding::identity;
+
+    if (native_value(c) != coding::identity) {
+        stream = pool.acquire();
+        if (!stream)
+            c = coding::identity;
+    }
+
+    state = ENCODING;
+    coding_ = c;
+    chunked_ = chunked;
+    in_size = 0;
+    pending_idx = 0;
+    pending_size = 0;
+
+    switch (native_value(c)) {
+    case coding::identity:
+        break;
+    case coding::gzip:
+        {
+            /* ID1 ID2 CM FLG MTIME(4) XFL OS (section 2.3 of RFC1952). No
+               flags, no modification time and an unknown OS. */
+            const unsigned char header[]
+                = {0x1F, 0x8B, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0xFF};
+            std::memcpy(pending, header, sizeof(header));
+            pending_size = sizeof(header);
+            checksum = crc32(0, Z_NULL, 0);
+            break;
+        }
+    case coding::deflate:
+        {
+            /* CMF FLG (section 2.2 of RFC1950). zlib never uses windows smaller
+               than 512 bytes. The default compression level is announced and
+               FCHECK makes the header a multiple of 31. */
+            int window_bits = std::max(pool.window_bits(), 9);
+            unsigned cmf = ((window_bits - 8) << 4) | Z_DEFLATED;
+            unsigned flg = 2 << 6;
+            flg |= (31 - (cmf * 256 + flg) % 31) % 31;
+            pending[0] = static_cast<unsigned char>(cmf);
+            pending[1] = static_cast<unsigned char>(flg);
+            pending_size = 2;
+            checksum = adler32(0, Z_NULL, 0);
+            break;
+        }
+    }
+
+    return c;
+}
+
+inline bool content_encoder::encode(asio::const_buffer in,
+                                    asio::mutable_buffer out, bool finish,
+                                    size_type &consumed, size_type &produced)
+{
+    assert(state != IDLE);
+
+    consumed = 0;
+    produced = 0;
+
+    if (state == DONE)
+        return true;
+
+    unsigned char *o = static_cast<unsigned char*>(out.data());
+
+    if (!chunked_) {
+        produced = fill(o, out.size(), in, finish, consumed);
+        if (state == FINISHED)
+            state = DONE;
+        return state == DONE;
+    }
+
+    if (state != FINISHED) {
+        assert(out.size() > chunk_header_size + chunk_trailer_size);
+
+        // The chunk size must fit in the 8 digits of the chunk header
+        size_type data_size = std::min<uint_least64_t>(
+            out.size() - chunk_header_size - chunk_trailer_size, UINT_MAX);
+        size_type n = fill(o + chunk_header_size, data_size, in, finish,
+                           consumed);
+
+        if (n != 0) {
+            /* Leading zeroes are allowed by the chunk-size rule (section 4.1
+               of RFC7230). */
+            static const char digits[] = "0123456789ABCDEF";
+            for (int i = 7 ; i >= 0 ; --i)
+                o[7 - i] = digits[(n >> (i * 4)) & 0xF];
+            o[8] = '\r';
+            o[9] = '\n';
+            o[chunk_header_size + n] = '\r';
+            o[chunk_header_size + n + 1] = '\n';
+            produced = n + chunk_header_size + chunk_trailer_size;
+        }
+    }
+
+    if (state == FINISHED && out.size() - produced >= last_chunk_size) {
+        std::memcpy(o + produced, "0\r\n\r\n", last_chunk_size);
+        produced += last_chunk_size;
+        state = DONE;
+    }
+
+    return state == DONE;
+}
+
+inline content_encoder::coding content_encoder::get_coding() const
+{
+    return coding_;
+}
+
+inline bool content_encoder::chunked() const
+{
+    return chunked_;
+}
+
+inline void content_encoder::set_min_size(size_type size)
+{
+    min_size_ = size;
+}
+
+inline content_encoder::size_type content_encoder::min_size() const
+{
+    return min_size_;
+}
+
+inline content_encoder::size_type
+content_encoder::fill(unsigned char *out, size_type out_size,
+                      asio::const_buffer in, bool finish, size_type &consumed)
+{
+    size_type n = drain(out, out_size);
+
+    if (state == ENCODING && pending_idx == pending_size) {
+        if (native_value(coding_) == coding::identity) {
+            consumed = std::min(in.size(), out_size - n);
+            if (consumed != 0)
+                std::memcpy(out + n, in.data(), consumed);
+            n += consumed;
+
+            if (finish && consumed == in.size())
+                state = FINISHED;
+
+            return n;
+        }
+
+        uInt avail_in = static_cast<uInt>(
+            std::min<uint_least64_t>(in.size(), UINT_MAX));
+        uInt avail_out = static_cast<uInt>(
+            std::min<uint_least64_t>(out_size - n, UINT_MAX));
+
+        // Z_FINISH must only be given once all the input is available to zlib
+        bool last = finish && avail_in == in.size();
+
+        stream->next_in
+            = const_cast<Bytef*>(static_cast<const Bytef*>(in.data()));
+        stream->avail_in = avail_in;
+        stream->next_out = out + n;
+        stream->avail_out = avail_out;
+
+        int ret = deflate(stream, last ? Z_FINISH : Z_NO_FLUSH);
+
+        consumed = avail_in - stream->avail_in;
+        n += avail_out - stream->avail_out;
+
+        if (consumed != 0) {
+            const Bytef *data = static_cast<const Bytef*>(in.data());
+            if (native_value(coding_) == coding::gzip)
+                checksum = crc32(checksum, data, static_cast<uInt>(consumed));
+            else
+                checksum = adler32(checksum, data, static_cast<uInt>(consumed));
+            in_size += consumed;
+        }
+
+        if (ret == Z_STREAM_END) {
+            finish_stream();
+            n += drain(out + n, out_size - n);
+        }
+    }
+
+    if (state == TRAILER && pending_idx == pending_size)
+        state = FINISHED;
+
+    return n;
+}
+
+inline content_encoder::size_type
+content_encoder::drain(unsigned char *out, size_type out_size)
+{
+    size_type n = std::min(pending_size - pending_idx, out_size);
+    std::memcpy(out, pending + pending_idx, n);
+    pending_idx += n;
+    return n;
+}
+
+inline void content_encoder::finish_stream()
+{
+    release();
+
+    state = TRAILER;
+    pending_idx = 0;
+
+    switch (native_value(coding_)) {
+    case coding::gzip:
+        // CRC32 ISIZE, both in little-endian (section 2.3.1 of RFC1952)
+        for (int i = 0 ; i != 4 ; ++i) {
+            pending[i] = static_cast<unsigned char>(checksum >> (i * 8));
+            pending[4 + i] = static_cast<unsigned char>(in_size >> (i * 8));
+        }
+        pending_size = 8;
+        break;
+    case coding::deflate:
+        // ADLER32 in network byte order (section 2.2 of RFC1950)
+        for (int i = 0 ; i != 4 ; ++i)
+            pending[i] = static_cast<unsigned char>(checksum >> (24 - i * 8));
+        pending_size = 4;
+        break;
+    case coding::identity:
+        BOOST_HTTP_DETAIL_UNREACHABLE("identity has no deflate stream");
+    }
+}
+
+inline void content_encoder::release()
+{
+    if (stream) {
+        pool.release(stream);
+        stream = NULL;
+    }
+}
+
+} // namespace writer
+} // namespace http
+} // namespace boost
@@ -0,0 +1,84 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WRITER_DEFLATE_POOL_HPP
+#define BOOST_HTTP_WRITER_DEFLATE_POOL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include <zlib.h>
+
+namespace boost {
+namespace http {
+namespace writer {
+
+/* Keeps idle raw deflate streams around, so compressing a message costs a
+   `deflateReset` instead of the allocation (about 256KiB with the default
+   settings) and initialization of a new stream. The framing (gzip, zlib or
+   none) is left to the user of the stream (e.g. `content_encoder`), so a
+   single pool serves every coding that shares the same parameters.
+
+   The pool is not thread-safe. Keep one per thread (e.g. one per
+   `io_context` running on a single thread). */
+class deflate_pool
+{
+public:
+    typedef std::size_t size_type;
+
+    /* `level`, `window_bits` (8 to 15) and `mem_level` are the same parameters
+       accepted by zlib's `deflateInit2`. At most `max_idle` idle streams are
+       kept. */
+    explicit deflate_pool(int level = Z_DEFAULT_COMPRESSION,
+                          int window_bits = MAX_WBITS, int mem_level = 8,
+                          size_type max_idle = 16);
+    ~deflate_pool();
+
+    /* Returns a stream ready to compress a new message or null if the stream
+       couldn't be allocated. */
+    z_stream *acquire();
+
+    // Gives the stream back to the pool (or frees it if the pool is full)
+    void release(z_stream *stream);
+
+    // Number of idle streams
+    size_type size() const;
+
+    int level() const;
+    int window_bits() const;
+    int mem_level() const;
+
+private:
+    struct node
+    {
+        z_stream stream;
+        node *next;
+    };
+
+    // non-copyable
+    deflate_pool(const deflate_pool&);
+    deflate_pool &operator=(const deflate_pool&);
+
+    static node *to_node(z_stream *stream);
+
+    int level_;
+    int window_bits_;
+    int mem_level_;
+    size_type max_idle;
+
+    // singly-linked list of idle streams
+    node *idle;
+    size_type idle_size;
+};
+
+} // namespace writer
+} // namespace http
+} // namespace boost
+
+#include "deflate_pool.ipp"
+
+#endif // BOOST_HTTP_WRITER_DEFLATE_POOL_HPP
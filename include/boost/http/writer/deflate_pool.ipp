@@ -0,0 +1,99 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace writer {
+
+inline deflate_pool::deflate_pool(int level, int window_bits, int mem_level,
+                                  size_type max_idle)
+    : level_(level)
+    , window_bits_(window_bits)
+    , mem_level_(mem_level)
+    , max_idle(max_idle)
+    , idle(NULL)
+    , idle_size(0)
+{}
+
+inline deflate_pool::~deflate_pool()
+{
+    while (idle) {
+        node *n = idle;
+        idle = n->next;
+        deflateEnd(&n->stream);
+        delete n;
+    }
+}
+
+inline z_stream *deflate_pool::acquire()
+{
+    if (idle) {
+        node *n = idle;
+        idle = n->next;
+        --idle_size;
+        return &n->stream;
+    }
+
+    node *n = new (std::nothrow) node;
+    if (!n)
+        return NULL;
+
+    std::memset(&n->stream, 0, sizeof(n->stream));
+
+    // Negative window bits select the raw deflate format
+    if (deflateInit2(&n->stream, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        delete n;
+        return NULL;
+    }
+
+    return &n->stream;
+}
+
+inline void deflate_pool::release(z_stream *stream)
+{
+    node *n = to_node(stream);
+
+    if (idle_size == max_idle) {
+        deflateEnd(stream);
+        delete n;
+        return;
+    }
+
+    deflateReset(stream);
+    n->next = idle;
+    idle = n;
+    ++idle_size;
+}
+
+inline deflate_pool::size_type deflate_pool::size() const
+{
+    return idle_size;
+}
+
+inline int deflate_pool::level() const
+{
+    return level_;
+}
+
+inline int deflate_pool::window_bits() const
+{
+    return window_bits_;
+}
+
+inline int deflate_pool::mem_level() const
+{
+    return mem_level_;
+}
+
+inline deflate_pool::node *deflate_pool::to_node(z_stream *stream)
+{
+    // `stream` is the first member of a standard-layout `node`
+    return reinterpret_cast<node*>(stream);
+}
+
+} // namespace writer
+} // namespace http
+} // namespace boost
@@ -0,0 +1,169 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WRITER_HPACK_HPP
+#define BOOST_HTTP_WRITER_HPACK_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include <boost/http/detail/hpack.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace boost {
+namespace http {
+namespace writer {
+
+/* Encodes HPACK header blocks (RFC7541) straight into the user's buffer, one
+   field representation at a time. Fields are indexed through the static table
+   whenever possible and through a bounded dynamic table (found through an open
+   addressing hash index on the field name) otherwise. Strings are
+   Huffman-encoded only when that makes them shorter. */
+class hpack
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef boost::string_view view_type;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(indexing)
+    {
+        // the field is added to the dynamic table (unless it's too big)
+        incremental,
+        // the field is not added to the dynamic table
+        none,
+        // sensitive field that no intermediary may add to a dynamic table
+        never
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(indexing)
+
+    // Initial value of SETTINGS_HEADER_TABLE_SIZE
+    static const size_type default_max_table_size = 4096;
+
+    /* `max_table_size` bounds the memory used by the dynamic table, whatever
+       the peer allows. */
+    explicit hpack(size_type max_table_size = default_max_table_size);
+
+    // Empties the dynamic table (i.e. a new connection)
+    void reset();
+
+    /* The SETTINGS_HEADER_TABLE_SIZE advertised by the peer. The dynamic table
+       is limited to the smallest of `size` and `max_table_size()` and the
+       change is signaled at the start of the next header block. */
+    void set_peer_max_table_size(size_type size);
+
+    // Fields are written into `outbuffer` from now on
+    void set_buffer(asio::mutable_buffer outbuffer);
+
+    /* Writes the representation of the field into the buffer. Returns `false`
+       (and writes nothing) if it doesn't fit in the rest of the buffer.
+
+       `name` must be in lowercase (section 8.2.1 of RFC9113). */
+    bool write_field(view_type name, view_type value,
+                     indexing i = indexing::incremental);
+
+    // The next field starts a new header block
+    void end_headers();
+
+    // Number of bytes written since `set_buffer` was last called
+    size_type size() const;
+
+    size_type max_table_size() const;
+
+    // Current size limit of the dynamic table
+    size_type table_capacity() const;
+
+    // Current size of the dynamic table (as defined in section 4.1)
+    size_type table_size() const;
+
+    // Number of entries in the dynamic table
+    size_type table_entries() const;
+
+private:
+    struct entry
+    {
+        // Position of the name within `storage` (the value follows it)
+        size_type offset;
+        size_type name_size;
+        size_type value_size;
+        uint_least32_t hash;
+    };
+
+    struct slot
+    {
+        // Position within `entries` plus one (0 for empty slots)
+        size_type entry;
+        uint_least32_t hash;
+    };
+
+    static uint_least32_t hash(view_type name);
+
+    /* Sets `index` to the HPACK index of the entry matching the whole field
+       and `name_index` to the HPACK index of an entry matching its name (0 if
+       there is none). */
+    void find(view_type name, view_type value, uint_least32_t h,
+              size_type &index, size_type &name_index) const;
+
+    // HPACK index of the entry at `pos` within `entries`
+    size_type dynamic_index(size_type pos) const;
+
+    // `huffman_size` is the size of `s` once Huffman-encoded
+    static size_type string_size(view_type s, size_type huffman_size);
+    static size_type write_string(unsigned char *out, view_type s,
+                                  size_type huffman_size);
+
+    void insert(view_type name, view_type value, uint_least32_t h);
+    void evict(size_type capacity);
+    void unlink(size_type pos);
+
+    size_type max_table_size_;
+
+    // Dynamic table size updates are only allowed at the start of a block
+    bool block_start;
+    bool update_pending;
+    // Smallest table size set since the last update was signaled
+    size_type update_min;
+
+    // Dynamic table {{{
+
+    std::vector<char> storage;
+    // Where the next entry is written within `storage`
+    size_type storage_tail;
+
+    std::vector<entry> entries;
+    // Oldest entry within `entries`
+    size_type first;
+    size_type count;
+
+    size_type table_size_;
+    size_type table_capacity_;
+
+    // Linear probing on the hash of the name (power-of-two size)
+    std::vector<slot> slots;
+
+    // }}}
+
+    asio::mutable_buffer obuffer;
+    size_type idx;
+};
+
+} // namespace writer
+} // namespace http
+} // namespace boost
+
+#include "hpack.ipp"
+
+#endif // BOOST_HTTP_WRITER_HPACK_HPP
@@ -0,0 +1,342 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace writer {
+
+inline hpack::hpack(size_type max_table_size)
+    : max_table_size_(max_table_size)
+    , storage(2 * max_table_size)
+    , entries(max_table_size / http::detail::hpack_entry_overhead + 1)
+{
+    // The load factor of the hash index never goes above 1/2
+    size_type nslots = 1;
+    while (nslots < 2 * entries.size())
+        nslots *= 2;
+    slots.resize(nslots);
+
+    reset();
+}
+
+inline void hpack::reset()
+{
+    block_start = true;
+    storage_tail = 0;
+    first = 0;
+    count = 0;
+    table_size_ = 0;
+    table_capacity_ = std::min(max_table_size_,
+                               size_type(default_max_table_size));
+    // A table smaller than the peer's initial limit is signaled too
+    update_pending = table_capacity_ != default_max_table_size;
+    update_min = table_capacity_;
+    std::fill(slots.begin(), slots.end(), slot());
+    obuffer = asio::mutable_buffer();
+    idx = 0;
+}
+
+inline void hpack::set_peer_max_table_size(size_type size)
+{
+    assert(block_start);
+
+    size_type capacity = std::min(size, max_table_size_);
+    if (capacity == table_capacity_)
+        return;
+
+    evict(capacity);
+    table_capacity_ = capacity;
+
+    /* The smallest size set in between two header blocks must be signaled too,
+       so the decoder evicts the same entries (section 4.2 of RFC7541). */
+    if (!update_pending || capacity < update_min)
+        update_min = capacity;
+    update_pending = true;
+}
+
+inline void hpack::set_buffer(asio::mutable_buffer outbuffer)
+{
+    obuffer = outbuffer;
+    idx = 0;
+}
+
+inline bool hpack::write_field(view_type name, view_type value, indexing i)
+{
+    using http::detail::hpack_integer_size;
+    using http::detail::hpack_encode_integer;
+    using http::detail::hpack_huffman_encoded_size;
+
+    uint_least32_t h = hash(name);
+    size_type index;
+    size_type name_index;
+    find(name, value, h, index, name_index);
+
+    bool indexed = index != 0 && native_value(i) != indexing::never;
+    bool add = false;
+    size_type name_huffman = 0;
+    size_type value_huffman = 0;
+    size_type n;
+
+    if (indexed) {
+        n = hpack_integer_size(7, index);
+    } else {
+        // An entry taking most of the table would just flush it
+        add = native_value(i) == indexing::incremental
+            && 4 * (name.size() + value.size()
+                    + http::detail::hpack_entry_overhead)
+            <= 3 * table_capacity_;
+        n = hpack_integer_size(add ? 6 : 4, name_index);
+        if (name_index == 0) {
+            name_huffman = hpack_huffman_encoded_size(name.data(),
+                                                      name.size());
+            n += string_size(name, name_huffman);
+        }
+        value_huffman = hpack_huffman_encoded_size(value.data(), value.size());
+        n += string_size(value, value_huffman);
+    }
+
+    bool update = block_start && update_pending;
+    if (update) {
+        if (update_min < table_capacity_)
+            n += hpack_integer_size(5, update_min);
+        n += hpack_integer_size(5, table_capacity_);
+    }
+
+    if (obuffer.size() - idx < n)
+        return false;
+
+    unsigned char *out = static_cast<unsigned char*>(obuffer.data()) + idx;
+    idx += n;
+
+    // Dynamic table size update (section 6.3 of RFC7541)
+    if (update) {
+        if (update_min < table_capacity_)
+            out += hpack_encode_integer(out, 5, 0x20, update_min);
+        out += hpack_encode_integer(out, 5, 0x20, table_capacity_);
+        update_pending = false;
+    }
+    block_start = false;
+
+    // Indexed header field (section 6.1 of RFC7541)
+    if (indexed) {
+        hpack_encode_integer(out, 7, 0x80, index);
+        return true;
+    }
+
+    // Literal header field (section 6.2 of RFC7541)
+    unsigned char flags = add ? 0x40
+        : (native_value(i) == indexing::never ? 0x10 : 0x00);
+    out += hpack_encode_integer(out, add ? 6 : 4, flags, name_index);
+    if (name_index == 0)
+        out += write_string(out, name, name_huffman);
+    write_string(out, value, value_huffman);
+
+    if (add)
+        insert(name, value, h);
+
+    return true;
+}
+
+inline void hpack::end_headers()
+{
+    block_start = true;
+}
+
+inline hpack::size_type hpack::size() const
+{
+    return idx;
+}
+
+inline hpack::size_type hpack::max_table_size() const
+{
+    return max_table_size_;
+}
+
+inline hpack::size_type hpack::table_capacity() const
+{
+    return table_capacity_;
+}
+
+inline hpack::size_type hpack::table_size() const
+{
+    return table_size_;
+}
+
+inline hpack::size_type hpack::table_entries() const
+{
+    return count;
+}
+
+inline uint_least32_t hpack::hash(view_type name)
+{
+    // FNV-1a
+    uint_least32_t h = 2166136261u;
+    for (view_type::const_iterator it = name.begin() ; it != name.end()
+             ; ++it) {
+        h ^= static_cast<unsigned char>(*it);
+        h = (h * 16777619u) & 0xFFFFFFFF;
+    }
+    return h;
+}
+
+inline void hpack::find(view_type name, view_type value, uint_least32_t h,
+                        size_type &index, size_type &name_index) const
+{
+    using http::detail::hpack_static_table_size;
+
+    index = 0;
+    name_index = http::detail::hpack_static_find_name(name.data(),
+                                                      name.size());
+
+    // The static entries sharing a name are contiguous
+    if (name_index != 0) {
+        const http::detail::hpack_static_entry *table
+            = http::detail::hpack_static_table();
+        hpack_field::value field = table[name_index - 1].field;
+        for (size_type j = name_index - 1
+                 ; j != hpack_static_table_size && table[j].field == field
+                 ; ++j) {
+            if (value == view_type(table[j].value, table[j].value_size)) {
+                index = j + 1;
+                return;
+            }
+        }
+    }
+
+    const size_type mask = slots.size() - 1;
+    for (size_type k = h & mask ; slots[k].entry != 0 ; k = (k + 1) & mask) {
+        if (slots[k].hash != h)
+            continue;
+
+        size_type pos = slots[k].entry - 1;
+        const entry &e = entries[pos];
+        const char *data = &storage[0] + e.offset;
+        if (name != view_type(data, e.name_size))
+            continue;
+
+        size_type i = dynamic_index(pos);
+        if (value == view_type(data + e.name_size, e.value_size)) {
+            index = i;
+            if (name_index == 0)
+                name_index = i;
+            return;
+        }
+
+        // Static indexes are smaller and newer entries live longer
+        if (name_index == 0
+            || (name_index > hpack_static_table_size && i < name_index)) {
+            name_index = i;
+        }
+    }
+}
+
+inline hpack::size_type hpack::dynamic_index(size_type pos) const
+{
+    // The newest entry has the lowest index (section 2.3.3 of RFC7541)
+    size_type newest = (first + count - 1) % entries.size();
+    return http::detail::hpack_static_table_size + 1
+        + (newest + entries.size() - pos) % entries.size();
+}
+
+inline hpack::size_type hpack::string_size(view_type s,
+                                           size_type huffman_size)
+{
+    // section 5.2 of RFC7541
+    size_type length = std::min(s.size(), huffman_size);
+    return http::detail::hpack_integer_size(7, length) + length;
+}
+
+inline hpack::size_type hpack::write_string(unsigned char *out, view_type s,
+                                            size_type huffman_size)
+{
+    size_type n;
+    if (huffman_size < s.size()) {
+        n = http::detail::hpack_encode_integer(out, 7, 0x80, huffman_size);
+        return n + http::detail::hpack_huffman_encode(s.data(), s.size(),
+                                                      out + n);
+    }
+
+    n = http::detail::hpack_encode_integer(out, 7, 0x00, s.size());
+    std::copy(s.begin(), s.end(), out + n);
+    return n + s.size();
+}
+
+inline void hpack::insert(view_type name, view_type value, uint_least32_t h)
+{
+    // section 4.4 of RFC7541
+    size_type size = name.size() + value.size()
+        + http::detail::hpack_entry_overhead;
+    assert(size <= table_capacity_);
+    evict(table_capacity_ - size);
+
+    /* `storage` is twice the table size, so there is always room for the new
+       entry either at the tail or at the beginning. */
+    size_type length = name.size() + value.size();
+    if (storage.size() - storage_tail < length)
+        storage_tail = 0;
+    assert(count == 0 || entries[first].offset < storage_tail
+           || storage_tail + length <= entries[first].offset);
+
+    std::copy(name.begin(), name.end(), storage.begin() + storage_tail);
+    std::copy(value.begin(), value.end(),
+              storage.begin() + storage_tail + name.size());
+
+    size_type pos = (first + count) % entries.size();
+    entry &e = entries[pos];
+    e.offset = storage_tail;
+    e.name_size = name.size();
+    e.value_size = value.size();
+    e.hash = h;
+    ++count;
+
+    const size_type mask = slots.size() - 1;
+    size_type k = h & mask;
+    while (slots[k].entry != 0)
+        k = (k + 1) & mask;
+    slots[k].entry = pos + 1;
+    slots[k].hash = h;
+
+    storage_tail += length;
+    table_size_ += size;
+}
+
+inline void hpack::evict(size_type capacity)
+{
+    while (table_size_ > capacity) {
+        const entry &e = entries[first];
+        table_size_ -= e.name_size + e.value_size
+            + http::detail::hpack_entry_overhead;
+        unlink(first);
+        first = (first + 1) % entries.size();
+        --count;
+    }
+
+    if (count == 0)
+        storage_tail = 0;
+}
+
+inline void hpack::unlink(size_type pos)
+{
+    const size_type mask = slots.size() - 1;
+    size_type k = entries[pos].hash & mask;
+    while (slots[k].entry != pos + 1)
+        k = (k + 1) & mask;
+
+    /* Backward shift deletion: slots following the hole move into it unless
+       their home slot lies after the hole, so no probe sequence is broken. */
+    for (size_type j = (k + 1) & mask ; slots[j].entry != 0
+             ; j = (j + 1) & mask) {
+        size_type home = slots[j].hash & mask;
+        if (((j - home) & mask) >= ((j - k) & mask)) {
+            slots[k] = slots[j];
+            k = j;
+        }
+    }
+    slots[k].entry = 0;
+}
+
+} // namespace writer
+} // namespace http
+} // namespace boost
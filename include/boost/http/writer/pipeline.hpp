@@ -0,0 +1,101 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WRITER_PIPELINE_HPP
+#define BOOST_HTTP_WRITER_PIPELINE_HPP
+
+#include <algorithm>
+#include <cassert>
+
+#include <boost/asio/buffer.hpp>
+
+namespace boost {
+namespace http {
+namespace writer {
+
+/* Keeps responses for pipelined requests in the order the requests were
+   received. A response may be completed out of order, but it'll only be handed
+   to the gather list once every response before it has been completed. */
+template<std::size_t Capacity>
+class pipeline
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef std::size_t ticket_type;
+
+    class const_buffers_type
+    {
+    public:
+        typedef asio::const_buffer value_type;
+        typedef const asio::const_buffer *const_iterator;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        friend class pipeline;
+
+        const_buffers_type(const_iterator first, const_iterator last);
+
+        const_iterator first;
+        const_iterator last;
+    };
+
+    pipeline();
+
+    void reset();
+
+    size_type size() const;
+    bool empty() const;
+    bool full() const;
+
+    // Reserves the slot for the next request in the pipeline
+    ticket_type reserve();
+
+    /* `head` and `body` must stay valid until they're consumed. An empty
+       response (both buffers empty) is retired immediately once it reaches the
+       front of the pipeline. */
+    void complete(ticket_type ticket, asio::const_buffer head,
+                  asio::const_buffer body = asio::const_buffer());
+
+    // Responses ready to be written in a single gather write
+    const_buffers_type data() const;
+
+    // Number of bytes within `data()`
+    size_type ready_size() const;
+
+    void consume(size_type n);
+
+private:
+    struct slot
+    {
+        asio::const_buffer head;
+        asio::const_buffer body;
+        bool ready;
+    };
+
+    void update_gather_list();
+
+    slot slots[Capacity];
+
+    // index of the oldest unretired slot
+    size_type first;
+    size_type count;
+    ticket_type first_ticket;
+
+    asio::const_buffer gather[Capacity * 2];
+    size_type gather_size;
+    size_type gather_bytes;
+};
+
+} // namespace writer
+} // namespace http
+} // namespace boost
+
+#include "pipeline.ipp"
+
+#endif // BOOST_HTTP_WRITER_PIPELINE_HPP
@@ -0,0 +1,168 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace writer {
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::const_buffers_type::const_iterator
+pipeline<Capacity>::const_buffers_type::begin() const
+{
+    return first;
+}
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::const_buffers_type::const_iterator
+pipeline<Capacity>::const_buffers_type::end() const
+{
+    return last;
+}
+
+template<std::size_t Capacity>
+pipeline<Capacity>::const_buffers_type
+::const_buffers_type(const_iterator first, const_iterator last)
+    : first(first)
+    , last(last)
+{}
+
+template<std::size_t Capacity>
+pipeline<Capacity>::pipeline()
+    : first(0)
+    , count(0)
+    , first_ticket(0)
+    , gather_size(0)
+    , gather_bytes(0)
+{}
+
+template<std::size_t Capacity>
+void pipeline<Capacity>::reset()
+{
+    first = 0;
+    count = 0;
+    first_ticket = 0;
+    gather_size = 0;
+    gather_bytes = 0;
+}
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::size_type pipeline<Capacity>::size() const
+{
+    return count;
+}
+
+template<std::size_t Capacity>
+bool pipeline<Capacity>::empty() const
+{
+    return count == 0;
+}
+
+template<std::size_t Capacity>
+bool pipeline<Capacity>::full() const
+{
+    return count == Capacity;
+}
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::ticket_type pipeline<Capacity>::reserve()
+{
+    assert(!full());
+
+    slot &s = slots[(first + count) % Capacity];
+    s.head = asio::const_buffer();
+    s.body = asio::const_buffer();
+    s.ready = false;
+
+    return first_ticket + count++;
+}
+
+template<std::size_t Capacity>
+void pipeline<Capacity>::complete(ticket_type ticket, asio::const_buffer head,
+                                  asio::const_buffer body)
+{
+    assert(ticket - first_ticket < count);
+
+    slot &s = slots[(first + (ticket - first_ticket)) % Capacity];
+    assert(!s.ready);
+    s.head = head;
+    s.body = body;
+    s.ready = true;
+
+    /* Only a response completed at the front of the pipeline can make more
+       data available for the next gather write. */
+    update_gather_list();
+}
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::const_buffers_type
+pipeline<Capacity>::data() const
+{
+    return const_buffers_type(gather, gather + gather_size);
+}
+
+template<std::size_t Capacity>
+typename pipeline<Capacity>::size_type pipeline<Capacity>::ready_size() const
+{
+    return gather_bytes;
+}
+
+template<std::size_t Capacity>
+void pipeline<Capacity>::consume(size_type n)
+{
+    assert(n <= gather_bytes);
+
+    for (size_type i = 0 ; n != 0 && i != count ; ++i) {
+        slot &s = slots[(first + i) % Capacity];
+        assert(s.ready);
+
+        size_type nhead = std::min(n, s.head.size());
+        s.head = s.head + nhead;
+        n -= nhead;
+
+        size_type nbody = std::min(n, s.body.size());
+        s.body = s.body + nbody;
+        n -= nbody;
+    }
+
+    update_gather_list();
+}
+
+template<std::size_t Capacity>
+void pipeline<Capacity>::update_gather_list()
+{
+    // Retire fully written responses first
+    while (count != 0) {
+        slot &s = slots[first];
+        if (!s.ready || s.head.size() != 0 || s.body.size() != 0)
+            break;
+
+        first = (first + 1) % Capacity;
+        --count;
+        ++first_ticket;
+    }
+
+    gather_size = 0;
+    gather_bytes = 0;
+
+    for (size_type i = 0 ; i != count ; ++i) {
+        const slot &s = slots[(first + i) % Capacity];
+        if (!s.ready)
+            break;
+
+        if (s.head.size() != 0) {
+            gather[gather_size++] = s.head;
+            gather_bytes += s.head.size();
+        }
+
+        if (s.body.size() != 0) {
+            gather[gather_size++] = s.body;
+            gather_bytes += s.body.size();
+        }
+    }
+}
+
+} // namespace writer
+} // namespace http
+} // namespace boost
@@ -0,0 +1,173 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+
+#ifndef BOOST_HTTP_WRITER_WEBSOCKET_HPP
+#define BOOST_HTTP_WRITER_WEBSOCKET_HPP
+
+// private
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+#include <boost/http/detail/simd.hpp>
+
+// public
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/scoped_enum.hpp>
+#include <boost/http/token.hpp>
+#include <boost/http/writer/deflate_pool.hpp>
+
+namespace boost {
+namespace http {
+namespace writer {
+
+/* Serializes WebSocket frames (section 5 of RFC6455). The frame header is
+   written into scratch space owned by this object and the frame is handed out
+   as a gather list (header plus payload), so payloads are never copied. Frames
+   written by a client are masked in place (hence the mutable buffers).
+
+   Messages can optionally be compressed with the permessage-deflate extension
+   (RFC7692) using streams taken from a `deflate_pool`. Requires zlib. */
+class websocket
+{
+public:
+    // types
+    typedef std::size_t size_type;
+    typedef token::websocket_frame::opcode opcode;
+
+    BOOST_SCOPED_ENUM_DECLARE_BEGIN(role)
+    {
+        // frames are not masked
+        server,
+        // frames are masked
+        client
+    }
+    BOOST_SCOPED_ENUM_DECLARE_END(role)
+
+    class const_buffers_type
+    {
+    public:
+        typedef asio::const_buffer value_type;
+        typedef const asio::const_buffer *const_iterator;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        friend class websocket;
+
+        const_buffers_type(const_iterator first, const_iterator last);
+
+        const_iterator first;
+        const_iterator last;
+    };
+
+    // Largest frame header (2 + 8 bytes of extended length + 4 bytes of mask)
+    static const size_type max_header_size = 14;
+
+    /* Smallest output buffer accepted by `write_compressed()`. zlib needs more
+       than 6 bytes to complete a flush without starting it over. */
+    static const size_type min_deflate_buffer_size = 7;
+
+    explicit websocket(role r = role::server);
+    ~websocket();
+
+    void reset();
+
+    /* The masking key used by the frames written from now on (only used by
+       clients). It must be changed before every frame and it must come from a
+       strong source of entropy (section 10.3 of RFC6455). */
+    void set_mask_key(const unsigned char (&key)[4]);
+
+    /* Writes a frame carrying `payload`. For data messages, `op` is the opcode
+       of the message and the continuation opcode is used by every frame after
+       the first one. The message ends with the frame where `fin` is true.
+       Control frames (close, ping and pong) can be written between the frames
+       of a data message.
+
+       `payload` must stay valid until the frame is written. The overload
+       taking a constant buffer can only be used by servers. */
+    void write_frame(opcode::value op, asio::const_buffer payload,
+                     bool fin = true);
+    void write_frame(opcode::value op, asio::mutable_buffer payload,
+                     bool fin = true);
+
+    /* Enables permessage-deflate. Streams are taken from `pool` (so it must
+       outlive this object). With `context_takeover`, the compressor keeps its
+       history across messages and the stream is kept until
+       `disable_deflate()`. Otherwise, the stream is given back to the pool at
+       the end of every message (i.e. the peer negotiated
+       `*_no_context_takeover`). */
+    void enable_deflate(deflate_pool &pool, bool context_takeover = true);
+    void disable_deflate();
+    bool deflate_enabled() const;
+
+    /* Compresses as much of `in` as fits in `out` and writes a frame carrying
+       the compressed data (`data()` is empty if no data is ready yet). `op` is
+       the opcode of the message. `consumed` is set to the number of bytes read
+       from `in`.
+
+       `finish` tells that `in` holds the rest of the message. Returns `true`
+       once the final frame of the message was written. `out` must stay valid
+       until the frame is written and it must hold at least
+       `min_deflate_buffer_size` bytes. */
+    bool write_compressed(opcode::value op, asio::const_buffer in,
+                          asio::mutable_buffer out, bool finish,
+                          size_type &consumed);
+
+    // The last frame written
+    const_buffers_type data() const;
+
+    // Number of bytes within `data()`
+    size_type size() const;
+
+private:
+    // non-copyable
+    websocket(const websocket&);
+    websocket &operator=(const websocket&);
+
+    void write_header(opcode::value op, bool fin, bool rsv1,
+                      uint_least64_t payload_size);
+    void begin(opcode::value &op, bool fin);
+    void release();
+
+    role role_;
+    unsigned char key[4];
+
+    // A data message was started and its final frame wasn't written yet
+    bool in_message;
+    // The current data message is compressed
+    bool compressed;
+
+    deflate_pool *pool;
+    z_stream *stream;
+    bool context_takeover;
+
+    unsigned char header[max_header_size];
+    asio::const_buffer gather[3];
+    size_type gather_size;
+    size_type gather_bytes;
+
+    /* The last bytes of the compressed output are held back, so the
+       `00 00 FF FF` trailer of the final flush can be removed even when it is
+       split across output buffers (section 7.2.1 of RFC7692). `prefix` holds
+       the bytes held back by the previous call. */
+    unsigned char prefix[4];
+    unsigned char tail[4];
+    size_type tail_size;
+};
+
+} // namespace writer
+} // namespace http
+} // namespace boost
+
+#include "websocket.ipp"
+
+#endif // BOOST_HTTP_WRITER_WEBSOCKET_HPP
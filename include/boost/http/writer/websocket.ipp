@@ -0,0 +1,300 @@
+/* Copyright (c) 2018 Vinícius dos Santos Oliveira
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt) */
+
+namespace boost {
+namespace http {
+namespace writer {
+
+inline
+websocket::const_buffers_type::const_iterator
+websocket::const_buffers_type::begin() const
+{
+    return first;
+}
+
+inline
+websocket::const_buffers_type::const_iterator
+websocket::const_buffers_type::end() const
+{
+    return last;
+}
+
+inline
+websocket::const_buffers_type::const_buffers_type(const_iterator first,
+                                                  const_iterator last)
+    : first(first)
+    , last(last)
+{}
+
+inline websocket::websocket(role r)
+    : role_(r)
+    , in_message(false)
+    , compressed(false)
+    , pool(NULL)
+    , stream(NULL)
+    , context_takeover(false)
+    , gather_size(0)
+    , gather_bytes(0)
+    , tail_size(0)
+{
+    std::memset(key, 0, sizeof(key));
+}
+
+inline websocket::~websocket()
+{
+    release();
+}
+
+inline void websocket::reset()
+{
+    // The compression history belongs to the previous connection
+    release();
+
+    in_message = false;
+    compressed = false;
+    gather_size = 0;
+    gather_bytes = 0;
+    tail_size = 0;
+}
+
+inline void websocket::set_mask_key(const unsigned char (&key)[4])
+{
+    std::memcpy(this->key, key, sizeof(this->key));
+}
+
+inline void websocket::write_frame(opcode::value op, asio::const_buffer payload,
+                                   bool fin)
+{
+    assert(native_value(role_) == role::server);
+    assert((op & 0x8) ? payload.size() <= 125 : !compressed);
+
+    begin(op, fin);
+    write_header(op, fin, false, payload.size());
+
+    if (payload.size() != 0) {
+        gather[gather_size++] = payload;
+        gather_bytes += payload.size();
+    }
+}
+
+inline void websocket::write_frame(opcode::value op,
+                                   asio::mutable_buffer payload, bool fin)
+{
+    assert((op & 0x8) ? payload.size() <= 125 : !compressed);
+
+    begin(op, fin);
+    write_header(op, fin, false, payload.size());
+
+    if (payload.size() == 0)
+        return;
+
+    if (native_value(role_) == role::client) {
+        http::detail::xor_mask(static_cast<unsigned char*>(payload.data()),
+                               payload.size(), key, 0);
+    }
+
+    gather[gather_size++] = payload;
+    gather_bytes += payload.size();
+}
+
+inline void websocket::enable_deflate(deflate_pool &pool,
+                                      bool context_takeover)
+{
+    assert(!compressed);
+
+    release();
+    this->pool = &pool;
+    this->context_takeover = context_takeover;
+}
+
+inline void websocket::disable_deflate()
+{
+    assert(!compressed);
+
+    release();
+    pool = NULL;
+}
+
+inline bool websocket::deflate_enabled() const
+{
+    return pool != NULL;
+}
+
+inline bool websocket::write_compressed(opcode::value op, asio::const_buffer in,
+                                        asio::mutable_buffer out, bool finish,
+                                        size_type &consumed)
+{
+    assert(pool);
+    assert(op == opcode::text || op == opcode::binary);
+    assert(out.size() >= min_deflate_buffer_size);
+
+    gather_size = 0;
+    gather_bytes = 0;
+    consumed = 0;
+
+    if (!compressed) {
+        assert(!in_message);
+        compressed = true;
+        tail_size = 0;
+        if (!stream)
+            stream = pool->acquire();
+    }
+
+    unsigned char *o = static_cast<unsigned char*>(out.data());
+    size_type produced;
+    bool done;
+
+    if (stream) {
+        uInt avail_in = static_cast<uInt>(
+            std::min<uint_least64_t>(in.size(), UINT_MAX));
+        uInt avail_out = static_cast<uInt>(
+            std::min<uint_least64_t>(out.size(), UINT_MAX));
+
+        // The flush must only be requested once all the input is given
+        bool last = finish && avail_in == in.size();
+
+        stream->next_in
+            = const_cast<Bytef*>(static_cast<const Bytef*>(in.data()));
+        stream->avail_in = avail_in;
+        stream->next_out = o;
+        stream->avail_out = avail_out;
+
+        // Z_BUF_ERROR only means no progress was possible
+        deflate(stream, last ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+
+        consumed = avail_in - stream->avail_in;
+        produced = avail_out - stream->avail_out;
+
+        // The flush is complete once deflate returns with room left
+        done = last && stream->avail_in == 0 && stream->avail_out != 0;
+    } else {
+        /* No stream could be allocated. The message is sent uncompressed,
+           which the extension allows (RSV1 unset). */
+        produced = std::min(in.size(), out.size());
+        if (produced != 0)
+            std::memcpy(o, in.data(), produced);
+        consumed = produced;
+        done = finish && consumed == in.size();
+    }
+
+    // The payload is `prefix` (held back by the previous call) plus `o`
+    size_type prefix_size = tail_size;
+    std::memcpy(prefix, tail, prefix_size);
+    size_type total = prefix_size + produced;
+    size_type payload_size = total;
+
+    if (stream) {
+        if (done) {
+            assert(total >= 4);
+            payload_size = total - 4;
+            tail_size = 0;
+        } else {
+            tail_size = std::min<size_type>(total, 4);
+            payload_size = total - tail_size;
+            for (size_type i = 0 ; i != tail_size ; ++i) {
+                size_type j = payload_size + i;
+                tail[i] = (j < prefix_size) ? prefix[j]
+                    : o[j - prefix_size];
+            }
+        }
+    }
+
+    if (payload_size == 0 && !done)
+        return false;
+
+    // Only the first frame of a compressed message has RSV1 set
+    bool rsv1 = !in_message && stream;
+    begin(op, done);
+    write_header(op, done, rsv1, payload_size);
+
+    size_type prefix_used = std::min(prefix_size, payload_size);
+    size_type out_used = payload_size - prefix_used;
+
+    if (native_value(role_) == role::client) {
+        http::detail::xor_mask(prefix, prefix_used, key, 0);
+        http::detail::xor_mask(o, out_used, key, prefix_used);
+    }
+
+    if (prefix_used != 0)
+        gather[gather_size++] = asio::buffer(prefix, prefix_used);
+    if (out_used != 0)
+        gather[gather_size++] = asio::buffer(o, out_used);
+    gather_bytes += payload_size;
+
+    if (done) {
+        compressed = false;
+        if (!context_takeover)
+            release();
+    }
+
+    return done;
+}
+
+inline websocket::const_buffers_type websocket::data() const
+{
+    return const_buffers_type(gather, gather + gather_size);
+}
+
+inline websocket::size_type websocket::size() const
+{
+    return gather_bytes;
+}
+
+inline void websocket::write_header(opcode::value op, bool fin, bool rsv1,
+                                    uint_least64_t payload_size)
+{
+    size_type n = 0;
+    header[n++] = static_cast<unsigned char>((fin ? 0x80 : 0)
+                                             | (rsv1 ? 0x40 : 0) | op);
+
+    unsigned char mask_bit = (native_value(role_) == role::client) ? 0x80 : 0;
+    if (payload_size < 126) {
+        header[n++] = static_cast<unsigned char>(mask_bit | payload_size);
+    } else if (payload_size <= 0xFFFF) {
+        header[n++] = mask_bit | 126;
+        header[n++] = static_cast<unsigned char>(payload_size >> 8);
+        header[n++] = static_cast<unsigned char>(payload_size);
+    } else {
+        header[n++] = mask_bit | 127;
+        for (int i = 7 ; i >= 0 ; --i)
+            header[n++] = static_cast<unsigned char>(payload_size >> (i * 8));
+    }
+
+    if (mask_bit) {
+        std::memcpy(header + n, key, 4);
+        n += 4;
+    }
+
+    gather[0] = asio::buffer(header, n);
+    gather_size = 1;
+    gather_bytes = n;
+}
+
+inline void websocket::begin(opcode::value &op, bool fin)
+{
+    if (op & 0x8) {
+        // section 5.5 of RFC6455
+        assert(fin);
+        return;
+    }
+
+    assert(op != opcode::continuation);
+
+    if (in_message)
+        op = opcode::continuation;
+    in_message = !fin;
+}
+
+inline void websocket::release()
+{
+    if (stream) {
+        pool->release(stream);
+        stream = NULL;
+    }
+}
+
+} // namespace writer
+} // namespace http
+} // namespace boost
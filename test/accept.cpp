@@ -0,0 +1,172 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/http/syntax/accept.hpp>
+#include <boost/http/syntax/accept_encoding.hpp>
+#include <boost/http/syntax/qvalue.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::qvalue<char> qvalue;
+typedef syntax::accept<char> accept;
+typedef syntax::accept_encoding<char> accept_encoding;
+
+bool decode_qvalue(boost::string_view in, unsigned expected)
+{
+    unsigned out = 1234;
+    return qvalue::decode(in, out) && out == expected;
+}
+
+std::vector<std::string> collect_codings(boost::string_view in)
+{
+    std::vector<std::string> ret;
+    accept_encoding::element e;
+    while (std::size_t n = accept_encoding::decode(in, e)) {
+        char weight[8];
+        std::sprintf(weight, "%u", e.weight);
+        ret.push_back(e.coding.to_string() + "|" + weight);
+        in.remove_prefix(n);
+    }
+    return ret;
+}
+
+std::vector<std::string> collect_ranges(boost::string_view in)
+{
+    std::vector<std::string> ret;
+    accept::element e;
+    while (std::size_t n = accept::decode(in, e)) {
+        char weight[8];
+        std::sprintf(weight, "%u", e.weight);
+        ret.push_back(e.type.to_string() + "/" + e.subtype.to_string() + "|"
+                      + e.parameters.to_string() + "|" + weight);
+        in.remove_prefix(n);
+    }
+    return ret;
+}
+
+TEST_CASE("qvalue", "[syntax]")
+{
+    CHECK(decode_qvalue("0", 0));
+    CHECK(decode_qvalue("0.", 0));
+    CHECK(decode_qvalue("0.5", 500));
+    CHECK(decode_qvalue("0.05", 50));
+    CHECK(decode_qvalue("0.123", 123));
+    CHECK(decode_qvalue("0.999", 999));
+    CHECK(decode_qvalue("1", 1000));
+    CHECK(decode_qvalue("1.", 1000));
+    CHECK(decode_qvalue("1.000", 1000));
+
+    unsigned out;
+    CHECK(!qvalue::decode("", out));
+    CHECK(!qvalue::decode(".5", out));
+    CHECK(!qvalue::decode("0.1234", out));
+    CHECK(!qvalue::decode("1.001", out));
+    CHECK(!qvalue::decode("2", out));
+    CHECK(!qvalue::decode("0,5", out));
+    CHECK(!qvalue::decode("0.5a", out));
+    CHECK(!qvalue::decode("-0", out));
+    CHECK(!qvalue::decode("1e0", out));
+}
+
+TEST_CASE("accept_encoding::decode", "[syntax]")
+{
+    std::vector<std::string> v;
+
+    CHECK(collect_codings("").empty());
+    CHECK(collect_codings(" , ,").empty());
+
+    v = collect_codings("gzip, deflate;q=0.5 ,br ; q=0.8,*;q=0,x;q=2,"
+                        "identity;Q=0.001");
+    REQUIRE(v.size() == 5);
+    CHECK(v[0] == "gzip|1000");
+    CHECK(v[1] == "deflate|500");
+    CHECK(v[2] == "br|800");
+    CHECK(v[3] == "*|0");
+    CHECK(v[4] == "identity|1");
+}
+
+TEST_CASE("accept_encoding::negotiate", "[syntax]")
+{
+    const boost::string_view offers[] = {"br", "gzip", "identity"};
+
+    CHECK(accept_encoding::negotiate("gzip, br", offers, 3) == 0);
+    CHECK(accept_encoding::negotiate("gzip, br;q=0.9", offers, 3) == 1);
+    CHECK(accept_encoding::negotiate("GZIP;q=0.1", offers, 3) == 1);
+    CHECK(accept_encoding::negotiate("compress", offers, 3) == 2);
+    CHECK(accept_encoding::negotiate("", offers, 3) == 2);
+    CHECK(accept_encoding::negotiate("*", offers, 3) == 0);
+    CHECK(accept_encoding::negotiate("*;q=0.5, br;q=0", offers, 3) == 1);
+    CHECK(accept_encoding::negotiate("identity;q=0", offers, 3) == 3);
+    CHECK(accept_encoding::negotiate("compress, *;q=0", offers, 3) == 3);
+    CHECK(accept_encoding::negotiate("identity;q=0.5, gzip;q=0.4", offers, 3)
+          == 2);
+
+    // explicit weights beat the implicit identity
+    CHECK(accept_encoding::negotiate("gzip;q=0.01", offers + 1, 2) == 0);
+
+    CHECK(accept_encoding::negotiate("gzip", offers, 0) == 0);
+}
+
+TEST_CASE("accept::decode", "[syntax]")
+{
+    std::vector<std::string> v;
+
+    CHECK(collect_ranges("").empty());
+    CHECK(collect_ranges("text, /html, text/, */html").empty());
+
+    v = collect_ranges("text/*;q=0.3, text/html;q=0.7, text/html;level=1,"
+                       " text/html;level=2;q=0.4;ext=1, */*;q=0.5,"
+                       " text/plain; format=\"a,b;c\" ; q=0.2");
+    REQUIRE(v.size() == 6);
+    CHECK(v[0] == "text/*||300");
+    CHECK(v[1] == "text/html||700");
+    CHECK(v[2] == "text/html|level=1|1000");
+    CHECK(v[3] == "text/html|level=2|400");
+    CHECK(v[4] == "*/*||500");
+    CHECK(v[5] == "text/plain|format=\"a,b;c\"|200");
+
+    // Invalid weights discard the media-range
+    v = collect_ranges("text/html;q=high, application/json");
+    REQUIRE(v.size() == 1);
+    CHECK(v[0] == "application/json||1000");
+}
+
+TEST_CASE("accept::negotiate", "[syntax]")
+{
+    const boost::string_view offers[] = {
+        "text/html;level=1",
+        "text/html",
+        "text/plain",
+        "image/jpeg",
+        "text/html;level=2",
+        "text/html;level=3"
+    };
+
+    // Example from section 5.3.2 of RFC7231
+    const char example[] = "text/*;q=0.3, text/html;q=0.7, text/html;level=1,"
+        " text/html;level=2;q=0.4, */*;q=0.5";
+
+    CHECK(accept::negotiate(example, offers, 6) == 0);
+    CHECK(accept::negotiate(example, offers + 1, 5) == 0);
+    CHECK(accept::negotiate(example, offers + 2, 4) == 3);
+    CHECK(accept::negotiate(example, offers + 2, 3) == 1);
+    CHECK(accept::negotiate(example, offers + 2, 1) == 0);
+    CHECK(accept::negotiate(example, offers + 4, 2) == 1);
+
+    CHECK(accept::negotiate("application/json", offers, 6) == 6);
+    CHECK(accept::negotiate("image/*, */*;q=0", offers, 6) == 3);
+    CHECK(accept::negotiate("TEXT/PLAIN", offers, 6) == 2);
+    CHECK(accept::negotiate("text/*", offers, 6) == 0);
+
+    const boost::string_view api[] = {"application/json", "application/xml"};
+    CHECK(accept::negotiate("application/xml, application/json;q=0.9", api, 2)
+          == 1);
+    CHECK(accept::negotiate("application/*", api, 2) == 0);
+}
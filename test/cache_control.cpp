@@ -0,0 +1,71 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <boost/http/syntax/cache_control.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::cache_control<char> cache_control;
+typedef cache_control::directive directive;
+
+TEST_CASE("cache_control::decode", "[syntax]")
+{
+    cache_control::directives d;
+
+    cache_control::decode("", d);
+    CHECK(d.mask == 0);
+
+    cache_control::decode("max-age=3600, public", d);
+    CHECK(d.mask == (directive::max_age | directive::public_));
+    CHECK(d.max_age == 3600);
+
+    cache_control::decode("No-Cache, no-store ,MUST-REVALIDATE,private=\"a, b\","
+                          " proxy-revalidate, no-transform, immutable,"
+                          " only-if-cached, must-understand", d);
+    CHECK(d.mask == (directive::no_cache | directive::no_store
+                     | directive::must_revalidate | directive::private_
+                     | directive::proxy_revalidate | directive::no_transform
+                     | directive::immutable | directive::only_if_cached
+                     | directive::must_understand));
+
+    cache_control::decode("s-maxage=\"60\", max-stale, min-fresh=0,"
+                          " stale-while-revalidate=30, stale-if-error=86400",
+                          d);
+    CHECK(d.mask == (directive::s_maxage | directive::max_stale
+                     | directive::min_fresh | directive::stale_while_revalidate
+                     | directive::stale_if_error));
+    CHECK(d.s_maxage == 60);
+    CHECK(d.max_stale == cache_control::max_delta_seconds);
+    CHECK(d.min_fresh == 0);
+    CHECK(d.stale_while_revalidate == 30);
+    CHECK(d.stale_if_error == 86400);
+
+    cache_control::decode("max-stale=10", d);
+    CHECK(d.mask == directive::max_stale);
+    CHECK(d.max_stale == 10);
+}
+
+TEST_CASE("cache_control::decode delta-seconds", "[syntax]")
+{
+    cache_control::directives d;
+
+    // Huge values are clamped to 2^31
+    cache_control::decode("max-age=99999999999999999999999999", d);
+    CHECK(d.mask == directive::max_age);
+    CHECK(d.max_age == 2147483648ul);
+
+    cache_control::decode("max-age=2147483649", d);
+    CHECK(d.max_age == 2147483648ul);
+
+    cache_control::decode("max-age=2147483647", d);
+    CHECK(d.max_age == 2147483647ul);
+
+    // Invalid arguments discard the directive
+    cache_control::decode("max-age, s-maxage=-1, min-fresh=1.5,"
+                          " stale-if-error=\"\", unknown=5, no-store", d);
+    CHECK(d.mask == directive::no_store);
+}
@@ -28,6 +28,8 @@ namespace Catch {
             return "error_invalid_transfer_encoding";
         case boost::http::token::code::error_chunk_size_overflow:
             return "error_chunk_size_overflow";
+        case boost::http::token::code::error_frame_too_big:
+            return "error_frame_too_big";
         case boost::http::token::code::field_name:
             return "field_name";
         case boost::http::token::code::field_value:
@@ -52,6 +54,12 @@ namespace Catch {
             return "status_code";
         case boost::http::token::code::reason_phrase:
             return "reason_phrase";
+        case boost::http::token::code::websocket_frame:
+            return "websocket_frame";
+        case boost::http::token::code::http2_frame:
+            return "http2_frame";
+        case boost::http::token::code::http2_setting:
+            return "http2_setting";
         }
     }
 }
@@ -0,0 +1,208 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <boost/http/reader/content_decoder.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::reader::content_decoder decoder;
+
+// window_bits as in deflateInit2: 31 for gzip, 15 for zlib, -15 for raw
+static std::string compress(const std::string &in, int window_bits)
+{
+    z_stream s;
+    std::memset(&s, 0, sizeof(s));
+    REQUIRE(deflateInit2(&s, Z_BEST_COMPRESSION, Z_DEFLATED, window_bits, 8,
+                         Z_DEFAULT_STRATEGY) == Z_OK);
+
+    std::string out(deflateBound(&s, in.size()), '\0');
+    s.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    s.avail_in = in.size();
+    s.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    s.avail_out = out.size();
+    REQUIRE(deflate(&s, Z_FINISH) == Z_STREAM_END);
+    out.resize(s.total_out);
+    deflateEnd(&s);
+    return out;
+}
+
+/* Feeds `in` in slices of `in_step` bytes and decodes into an output window
+   of `out_step` bytes. */
+static decoder::result run(decoder &d, const std::string &in,
+                           std::size_t in_step, std::size_t out_step,
+                           std::string &out)
+{
+    std::vector<char> window(out_step);
+    std::size_t pos = 0;
+    out.clear();
+
+    for (;;) {
+        std::size_t n = std::min(in_step, in.size() - pos);
+        std::size_t consumed, produced;
+        decoder::result r = d.decode(asio::buffer(in.data() + pos, n),
+                                     asio::buffer(window), consumed, produced);
+        pos += consumed;
+        out.append(&window[0], produced);
+
+        if (r != decoder::result::ok)
+            return r;
+
+        if (pos == in.size() && produced == 0)
+            return r;
+    }
+}
+
+static std::string sample()
+{
+    std::string json = "[";
+    for (int i = 0 ; i != 500 ; ++i) {
+        char item[64];
+        std::sprintf(item, "{\"id\":%d,\"name\":\"item %d\",\"ok\":true},", i,
+                     i * 7);
+        json += item;
+    }
+    json += "{}]";
+    return json;
+}
+
+TEST_CASE("content_decoder codings", "[reader]")
+{
+    decoder d;
+
+    CHECK(d.get_coding() == decoder::coding::identity);
+
+    REQUIRE(d.set_content_encoding("gzip"));
+    CHECK(d.get_coding() == decoder::coding::gzip);
+    REQUIRE(d.set_content_encoding("X-GZIP"));
+    CHECK(d.get_coding() == decoder::coding::gzip);
+    REQUIRE(d.set_content_encoding("identity , deflate"));
+    CHECK(d.get_coding() == decoder::coding::deflate);
+    REQUIRE(d.set_content_encoding(""));
+    CHECK(d.get_coding() == decoder::coding::identity);
+
+    CHECK(!d.set_content_encoding("br"));
+    CHECK(!d.set_content_encoding("gzip, deflate"));
+    CHECK(!d.set_content_encoding("gzip, chunked"));
+    CHECK(d.get_coding() == decoder::coding::identity);
+
+    REQUIRE(d.set_transfer_encoding("gzip ; level=\"9, really\", chunked"));
+    CHECK(d.get_coding() == decoder::coding::gzip);
+    REQUIRE(d.set_transfer_encoding("chunked"));
+    CHECK(d.get_coding() == decoder::coding::identity);
+}
+
+TEST_CASE("content_decoder incremental inflate", "[reader]")
+{
+    const std::string json = sample();
+    std::string out;
+    decoder d;
+
+    // gzip, zlib ("deflate") and raw deflate (sent by broken peers)
+    const int formats[] = {31, 15, -15};
+    for (int i = 0 ; i != 3 ; ++i) {
+        const std::string encoded = compress(json, formats[i]);
+        REQUIRE(d.set_content_encoding(i == 0 ? "gzip" : "deflate"));
+
+        CHECK(run(d, encoded, encoded.size(), 1 << 16, out)
+              == decoder::result::end_of_stream);
+        CHECK(out == json);
+        CHECK(d.total_in() == encoded.size());
+        CHECK(d.total_out() == json.size());
+
+        const std::size_t steps[][2] = {{1, 1}, {3, 7}, {64, 5}, {5, 4096}};
+        for (std::size_t j = 0 ; j != 4 ; ++j) {
+            d.reset(d.get_coding());
+            CHECK(run(d, encoded, steps[j][0], steps[j][1], out)
+                  == decoder::result::end_of_stream);
+            CHECK(out == json);
+        }
+    }
+
+    // Data after the end of the stream isn't consumed
+    const std::string encoded = compress(json, 31) + "tail";
+    d.reset(decoder::coding::gzip);
+    std::vector<char> window(json.size() + 10);
+    std::size_t consumed, produced;
+    CHECK(d.decode(asio::buffer(encoded), asio::buffer(window), consumed,
+                   produced) == decoder::result::end_of_stream);
+    CHECK(consumed == encoded.size() - 4);
+    CHECK(produced == json.size());
+    CHECK(d.decode(asio::buffer(encoded), asio::buffer(window), consumed,
+                   produced) == decoder::result::end_of_stream);
+    CHECK(consumed == 0);
+}
+
+TEST_CASE("content_decoder identity", "[reader]")
+{
+    decoder d;
+    std::string out;
+
+    CHECK(run(d, "plain body", 4, 3, out) == decoder::result::ok);
+    CHECK(out == "plain body");
+    CHECK(d.total_out() == 10);
+
+    d.reset();
+    d.set_max_size(5);
+    CHECK(run(d, "plain body", 4, 3, out) == decoder::result::size_exceeded);
+}
+
+TEST_CASE("content_decoder limits", "[reader]")
+{
+    const std::string zeros(4 * 1024 * 1024, '\0');
+    const std::string bomb = compress(zeros, 31);
+    std::string out;
+    decoder d;
+
+    REQUIRE(d.set_content_encoding("gzip"));
+    CHECK(run(d, bomb, bomb.size(), 4096, out)
+          == decoder::result::ratio_exceeded);
+    CHECK(out.size() < 1024 * 1024);
+
+    // The error is sticky
+    std::size_t consumed, produced;
+    char c;
+    CHECK(d.decode(asio::buffer(bomb), asio::buffer(&c, 1), consumed, produced)
+          == decoder::result::ratio_exceeded);
+    CHECK(produced == 0);
+
+    d.reset(decoder::coding::gzip);
+    d.set_max_ratio(0);
+    CHECK(run(d, bomb, bomb.size(), 4096, out)
+          == decoder::result::end_of_stream);
+    CHECK(out == zeros);
+
+    // Small, very compressible bodies are below the ratio threshold
+    const std::string small(decoder::ratio_threshold, 'a');
+    d.reset(decoder::coding::gzip);
+    d.set_max_ratio(10);
+    CHECK(run(d, compress(small, 31), 16, 4096, out)
+          == decoder::result::end_of_stream);
+    CHECK(out == small);
+
+    d.reset(decoder::coding::gzip);
+    d.set_max_size(1000);
+    CHECK(run(d, compress(small, 31), 16, 4096, out)
+          == decoder::result::size_exceeded);
+    CHECK(out.size() == 1001);
+}
+
+TEST_CASE("content_decoder invalid data", "[reader]")
+{
+    std::string out;
+    decoder d;
+
+    REQUIRE(d.set_content_encoding("gzip"));
+    CHECK(run(d, "this is not gzip", 16, 64, out)
+          == decoder::result::invalid_data);
+
+    std::string encoded = compress(sample(), 15);
+    encoded[encoded.size() / 2] ^= 0x55;
+    d.reset(decoder::coding::deflate);
+    CHECK(run(d, encoded, 32, 64, out) == decoder::result::invalid_data);
+}
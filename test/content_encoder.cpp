@@ -0,0 +1,209 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <boost/http/writer/content_encoder.hpp>
+#include <boost/http/reader/content_decoder.hpp>
+#include <boost/http/reader/request.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::writer::content_encoder encoder;
+typedef http::reader::content_decoder decoder;
+
+/* Encodes `in` feeding `in_step` bytes at a time into an output window of
+   `out_step` bytes. */
+static std::string encode(encoder &e, const std::string &in,
+                          std::size_t in_step, std::size_t out_step)
+{
+    std::vector<char> window(out_step);
+    std::string out;
+    std::size_t pos = 0;
+
+    for (;;) {
+        std::size_t n = std::min(in_step, in.size() - pos);
+        bool finish = pos + n == in.size();
+        std::size_t consumed, produced;
+        bool done = e.encode(asio::buffer(in.data() + pos, n),
+                             asio::buffer(window), finish, consumed, produced);
+        pos += consumed;
+        out.append(&window[0], produced);
+
+        if (done)
+            return out;
+    }
+}
+
+static std::string decode(decoder::coding c, const std::string &in)
+{
+    decoder d;
+    d.reset(c);
+    std::vector<char> window(in.size() * 20 + 64);
+    std::size_t consumed, produced;
+    REQUIRE(d.decode(asio::buffer(in), asio::buffer(window), consumed,
+                     produced) == decoder::result::end_of_stream);
+    REQUIRE(consumed == in.size());
+    return std::string(&window[0], produced);
+}
+
+static std::string sample()
+{
+    std::string html;
+    for (int i = 0 ; i != 300 ; ++i) {
+        char row[64];
+        std::sprintf(row, "<tr><td>%d</td><td>row %d</td></tr>\n", i, i * 3);
+        html += row;
+    }
+    return html;
+}
+
+TEST_CASE("content_encoder gzip and deflate", "[writer]")
+{
+    const std::string body = sample();
+    http::writer::deflate_pool pool;
+    encoder e(pool);
+
+    const std::size_t steps[][2] = {{1 << 20, 1 << 20}, {1, 1}, {7, 3},
+                                    {100, 64}};
+    for (std::size_t i = 0 ; i != 4 ; ++i) {
+        REQUIRE(e.start(encoder::coding::gzip, false)
+                == encoder::coding::gzip);
+        std::string encoded = encode(e, body, steps[i][0], steps[i][1]);
+        CHECK(encoded.size() < body.size() / 3);
+        CHECK(encoded.substr(0, 2) == "\x1F\x8B");
+        CHECK(decode(decoder::coding::gzip, encoded) == body);
+
+        REQUIRE(e.start(encoder::coding::deflate, false, body.size())
+                == encoder::coding::deflate);
+        encoded = encode(e, body, steps[i][0], steps[i][1]);
+        CHECK(encoded.substr(0, 2) == "\x78\x9C");
+        CHECK(decode(decoder::coding::deflate, encoded) == body);
+    }
+
+    // Empty bodies
+    REQUIRE(e.start(encoder::coding::gzip, false) == encoder::coding::gzip);
+    CHECK(decode(decoder::coding::gzip, encode(e, "", 1, 4)) == "");
+}
+
+TEST_CASE("content_encoder reuses pooled streams", "[writer]")
+{
+    http::writer::deflate_pool pool(Z_BEST_SPEED, 15, 8, 1);
+
+    {
+        encoder a(pool);
+        encoder b(pool);
+
+        a.start(encoder::coding::gzip, false);
+        b.start(encoder::coding::deflate, false);
+        CHECK(pool.size() == 0);
+
+        encode(a, "data", 4, 64);
+        CHECK(pool.size() == 1);
+
+        // The pool only keeps `max_idle` streams
+        encode(b, "data", 4, 64);
+        CHECK(pool.size() == 1);
+
+        // A stream given back by an unfinished body is reset before reuse
+        a.start(encoder::coding::gzip, false);
+        CHECK(pool.size() == 0);
+        std::size_t consumed, produced;
+        char window[64];
+        a.encode(asio::buffer("partial", 7), asio::buffer(window), false,
+                 consumed, produced);
+        a.start(encoder::coding::gzip, false);
+        CHECK(decode(decoder::coding::gzip, encode(a, "fresh", 5, 64))
+              == "fresh");
+    }
+
+    CHECK(pool.size() == 1);
+}
+
+TEST_CASE("content_encoder identity fallback", "[writer]")
+{
+    http::writer::deflate_pool pool;
+    encoder e(pool, 256);
+
+    CHECK(e.min_size() == 256);
+    CHECK(e.start(encoder::coding::gzip, false, 255)
+          == encoder::coding::identity);
+    CHECK(e.get_coding() == encoder::coding::identity);
+    CHECK(encode(e, "small body", 3, 4) == "small body");
+    CHECK(pool.size() == 0);
+
+    CHECK(e.start(encoder::coding::gzip, false, 256) == encoder::coding::gzip);
+
+    e.set_min_size(0);
+    CHECK(e.start(encoder::coding::gzip, false, 1) == encoder::coding::gzip);
+    CHECK(e.start(encoder::coding::identity, true) == encoder::coding::identity);
+    CHECK(encode(e, "abc", 2, 13) == "00000001\r\na\r\n"
+                                     "00000001\r\nb\r\n"
+                                     "00000001\r\nc\r\n"
+                                     "0\r\n\r\n");
+}
+
+TEST_CASE("content_encoder chunked output over reader::request", "[writer]")
+{
+    const std::string body = sample();
+    http::writer::deflate_pool pool;
+    encoder e(pool);
+
+    const std::size_t windows[] = {13, 64, 4096};
+    for (std::size_t i = 0 ; i != 3 ; ++i) {
+        REQUIRE(e.start(encoder::coding::gzip, true) == encoder::coding::gzip);
+        CHECK(e.chunked());
+
+        std::string msg = "POST / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Transfer-Encoding: gzip, chunked\r\n"
+            "\r\n";
+        msg += encode(e, body, 512, windows[i]);
+
+        http::reader::request parser;
+        decoder d;
+        std::string decoded;
+        std::vector<char> window(256);
+
+        parser.set_buffer(asio::buffer(msg));
+        while (parser.code() != http::token::code::end_of_message) {
+            REQUIRE(parser.code() != http::token::code::error_insufficient_data);
+            REQUIRE(parser.code() != http::token::code::error_invalid_data);
+            REQUIRE(parser.code()
+                    != http::token::code::error_invalid_transfer_encoding);
+
+            if (parser.code() == http::token::code::field_name
+                && parser.value<http::token::field_name>()
+                == "Transfer-Encoding") {
+                parser.next();
+                parser.next();
+                REQUIRE(parser.code() == http::token::code::field_value);
+                REQUIRE(d.set_transfer_encoding(
+                            parser.value<http::token::field_value>()));
+            }
+
+            if (parser.code() == http::token::code::body_chunk) {
+                asio::const_buffer chunk
+                    = parser.value<http::token::body_chunk>();
+                while (chunk.size() != 0) {
+                    std::size_t consumed, produced;
+                    decoder::result r = d.decode(chunk, asio::buffer(window),
+                                                 consumed, produced);
+                    chunk = chunk + consumed;
+                    decoded.append(&window[0], produced);
+                    if (r != decoder::result::ok)
+                        break;
+                }
+            }
+
+            parser.next();
+        }
+
+        CHECK(parser.parsed_count() + parser.token_size() == msg.size());
+        CHECK(decoded == body);
+    }
+}
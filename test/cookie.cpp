@@ -0,0 +1,122 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <string>
+#include <vector>
+#include <boost/http/reader/request.hpp>
+#include <boost/http/syntax/cookie.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::cookie<char> cookie;
+
+std::vector<std::string> collect(boost::string_view in)
+{
+    std::vector<std::string> ret;
+    boost::string_view name, value;
+    while (std::size_t n = cookie::decode(in, name, value)) {
+        ret.push_back(name.to_string() + "|" + value.to_string());
+        in.remove_prefix(n);
+    }
+    return ret;
+}
+
+TEST_CASE("cookie::decode", "[syntax]")
+{
+    std::vector<std::string> v;
+
+    CHECK(collect("").empty());
+    CHECK(collect(" ; ;;").empty());
+    CHECK(collect("novalue; =nameless").empty());
+
+    v = collect("SID=31d4d96e407aad42");
+    REQUIRE(v.size() == 1);
+    CHECK(v[0] == "SID|31d4d96e407aad42");
+
+    v = collect("SID=31d4d96e407aad42; lang=en-US");
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "SID|31d4d96e407aad42");
+    CHECK(v[1] == "lang|en-US");
+
+    // liberal on whitespace, empty elements and empty values
+    v = collect(" a = 1 ;; b=;c=\"quoted\" ;d=x=y;novalue;");
+    REQUIRE(v.size() == 4);
+    CHECK(v[0] == "a|1");
+    CHECK(v[1] == "b|");
+    CHECK(v[2] == "c|quoted");
+    CHECK(v[3] == "d|x=y");
+
+    // A lone DQUOTE isn't a quoted value
+    v = collect("e=\"");
+    REQUIRE(v.size() == 1);
+    CHECK(v[0] == "e|\"");
+
+    // Views reference the input
+    boost::string_view in("tracking=abc; session=xyz");
+    boost::string_view name, value;
+    CHECK(cookie::decode(in, name, value) == 13);
+    CHECK(name.data() == in.data());
+    CHECK(value.data() == in.data() + 9);
+}
+
+TEST_CASE("cookie::find", "[syntax]")
+{
+    std::string in;
+    for (int i = 0 ; i != 100 ; ++i)
+        in += "tracking_cookie_with_a_long_name=some-opaque-value; ";
+    in += "session=\"s3cr3t\"; tail=1";
+
+    boost::string_view value;
+
+    REQUIRE(cookie::find(in, "session", value));
+    CHECK(value == "s3cr3t");
+
+    REQUIRE(cookie::find(in, "tail", value));
+    CHECK(value == "1");
+
+    REQUIRE(cookie::find(in, "tracking_cookie_with_a_long_name", value));
+    CHECK(value == "some-opaque-value");
+
+    CHECK(!cookie::find(in, "sessio", value));
+    CHECK(!cookie::find(in, "some-opaque-value", value));
+    CHECK(!cookie::find(in, "", value));
+    CHECK(!cookie::find("", "a", value));
+
+    // The first match wins
+    REQUIRE(cookie::find("a=1; a=2", "a", value));
+    CHECK(value == "1");
+}
+
+TEST_CASE("cookie over the reader's field value", "[syntax]")
+{
+    const char req[]
+        = ("GET / HTTP/1.1\r\n"
+           "Cookie: theme=dark; SID=31d4d96e407aad42  \r\n"
+           "\r\n");
+    std::vector<char> buf(sizeof(req) - 1);
+    my_copy(buf, 0, req);
+
+    http::reader::request parser;
+    parser.set_buffer(asio::buffer(buf));
+
+    while (parser.code() != http::token::code::field_value) {
+        REQUIRE(parser.code() != http::token::code::error_insufficient_data);
+        parser.next();
+    }
+
+    boost::string_view field = parser.value<http::token::field_value>();
+    boost::string_view value;
+
+    REQUIRE(cookie::find(field, "SID", value));
+    CHECK(value == "31d4d96e407aad42");
+
+    std::vector<std::string> v = collect(field);
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "theme|dark");
+    CHECK(v[1] == "SID|31d4d96e407aad42");
+}
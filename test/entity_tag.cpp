@@ -0,0 +1,79 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <boost/http/syntax/entity_tag.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::entity_tag<char> entity_tag;
+
+TEST_CASE("entity_tag::match", "[syntax]")
+{
+    CHECK(entity_tag::match("\"xyzzy\"") == 7);
+    CHECK(entity_tag::match("W/\"xyzzy\"") == 9);
+    CHECK(entity_tag::match("\"\"") == 2);
+    CHECK(entity_tag::match("\"a\", \"b\"") == 3);
+    CHECK(entity_tag::match("\"\x80\xff\"") == 4);
+
+    CHECK(entity_tag::match("") == 0);
+    CHECK(entity_tag::match("xyzzy") == 0);
+    CHECK(entity_tag::match("w/\"xyzzy\"") == 0);
+    CHECK(entity_tag::match("W/xyzzy") == 0);
+    CHECK(entity_tag::match("\"xyzzy") == 0);
+    CHECK(entity_tag::match("\"a b\"") == 0);
+    CHECK(entity_tag::match("\"a\x7f\"") == 0);
+}
+
+TEST_CASE("entity_tag comparison", "[syntax]")
+{
+    // Table from section 2.3.2 of RFC7232
+    CHECK(!entity_tag::strong_compare("W/\"1\"", "W/\"1\""));
+    CHECK(entity_tag::weak_compare("W/\"1\"", "W/\"1\""));
+
+    CHECK(!entity_tag::strong_compare("W/\"1\"", "W/\"2\""));
+    CHECK(!entity_tag::weak_compare("W/\"1\"", "W/\"2\""));
+
+    CHECK(!entity_tag::strong_compare("W/\"1\"", "\"1\""));
+    CHECK(entity_tag::weak_compare("W/\"1\"", "\"1\""));
+
+    CHECK(entity_tag::strong_compare("\"1\"", "\"1\""));
+    CHECK(entity_tag::weak_compare("\"1\"", "\"1\""));
+
+    CHECK(entity_tag::is_weak("W/\"1\""));
+    CHECK(!entity_tag::is_weak("\"1\""));
+}
+
+TEST_CASE("entity_tag lists", "[syntax]")
+{
+    CHECK(entity_tag::weak_match("*", "\"abc\""));
+    CHECK(entity_tag::strong_match(" * ", "W/\"abc\""));
+
+    const char list[] = "W/\"xyzzy\", \"r2d2,xxxx\" , bogus,\"c3p0\"";
+
+    CHECK(entity_tag::weak_match(list, "\"xyzzy\""));
+    CHECK(!entity_tag::strong_match(list, "\"xyzzy\""));
+    CHECK(entity_tag::weak_match(list, "W/\"r2d2,xxxx\""));
+    CHECK(entity_tag::strong_match(list, "\"r2d2,xxxx\""));
+    CHECK(entity_tag::strong_match(list, "\"c3p0\""));
+    CHECK(!entity_tag::weak_match(list, "\"r2d2\""));
+    CHECK(!entity_tag::weak_match(list, "\"bogus\""));
+
+    CHECK(!entity_tag::weak_match("", "\"a\""));
+    CHECK(!entity_tag::weak_match("\"a", "\"a\""));
+    CHECK(!entity_tag::weak_match(" , ,", "\"a\""));
+
+    // There's no quoted-pair within entity-tags
+    const char backslash[] = "\"abc\\\", W/\"def\"";
+    CHECK(entity_tag::strong_match(backslash, "\"abc\\\""));
+    CHECK(entity_tag::weak_match(backslash, "\"def\""));
+    CHECK(!entity_tag::strong_match(backslash, "\"def\""));
+    CHECK(entity_tag::weak_match("\"\\\",\"def\"", "W/\"def\""));
+
+    // Stray quotes don't hide the entity-tags that follow
+    CHECK(entity_tag::weak_match("bo\"gus, \"def\"", "\"def\""));
+    CHECK(entity_tag::weak_match("\"a\"x\", \"def\"", "\"def\""));
+}
@@ -0,0 +1,127 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <vector>
+#include <boost/utility/string_view.hpp>
+#include <boost/http/algorithm/header/header_value_list.hpp>
+#include <boost/http/algorithm/header/header_value_any_of.hpp>
+
+namespace http = boost::http;
+
+typedef http::header_value_list<boost::string_view> header_value_list;
+
+std::vector<std::string> collect(const header_value_list &list)
+{
+    std::vector<std::string> ret;
+    for (header_value_list::const_iterator it = list.begin()
+             ; it != list.end() ; it++) {
+        ret.push_back(std::string(it->data(), it->size()));
+    }
+    return ret;
+}
+
+struct is_equal
+{
+    is_equal(const char *s) : s(s) {}
+
+    bool operator()(boost::string_view v) const
+    {
+        return v == s;
+    }
+
+    const char *s;
+};
+
+TEST_CASE("header_value_list", "[algorithm]")
+{
+    std::vector<std::string> v;
+
+    CHECK(collect(header_value_list("")).empty());
+    CHECK(collect(header_value_list(" ")).empty());
+    CHECK(collect(header_value_list(" ,\t, ,,")).empty());
+
+    v = collect(header_value_list("keep-alive"));
+    REQUIRE(v.size() == 1);
+    CHECK(v[0] == "keep-alive");
+
+    v = collect(header_value_list("gzip, deflate,br ,\t identity \t,"));
+    REQUIRE(v.size() == 4);
+    CHECK(v[0] == "gzip");
+    CHECK(v[1] == "deflate");
+    CHECK(v[2] == "br");
+    CHECK(v[3] == "identity");
+
+    v = collect(header_value_list("a b , c\td"));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "a b");
+    CHECK(v[1] == "c\td");
+
+    // quotes are ordinary characters unless asked otherwise
+    v = collect(header_value_list("\"a,b\", c"));
+    REQUIRE(v.size() == 3);
+    CHECK(v[0] == "\"a");
+    CHECK(v[1] == "b\"");
+    CHECK(v[2] == "c");
+
+    // Views reference the input
+    boost::string_view in("  Accept-Encoding, Origin");
+    header_value_list list(in);
+    CHECK(list.begin()->data() == in.data() + 2);
+}
+
+TEST_CASE("header_value_list with quoted-strings", "[algorithm]")
+{
+    std::vector<std::string> v;
+
+    v = collect(header_value_list("\"a,b\", c", true));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "\"a,b\"");
+    CHECK(v[1] == "c");
+
+    v = collect(header_value_list("W/\"xyzzy\", W/\"r2d2,xxxx\",\"c3p0\"",
+                                  true));
+    REQUIRE(v.size() == 3);
+    CHECK(v[0] == "W/\"xyzzy\"");
+    CHECK(v[1] == "W/\"r2d2,xxxx\"");
+    CHECK(v[2] == "\"c3p0\"");
+
+    v = collect(header_value_list("text/html;q=\"0,5\\\",\" , a", true));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "text/html;q=\"0,5\\\",\"");
+    CHECK(v[1] == "a");
+
+    // unterminated quoted-strings go up to the end
+    v = collect(header_value_list("a, \"b, c", true));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "a");
+    CHECK(v[1] == "\"b, c");
+
+    v = collect(header_value_list("a, \"b\\", true));
+    REQUIRE(v.size() == 2);
+    CHECK(v[1] == "\"b\\");
+
+    // long enough to exercise the vectorized search
+    v = collect(header_value_list("a-rather-long-element-name-here,"
+                                  "\"and a long quoted, string here\" ,"
+                                  " another-element-here", true));
+    REQUIRE(v.size() == 3);
+    CHECK(v[1] == "\"and a long quoted, string here\"");
+    CHECK(v[2] == "another-element-here");
+}
+
+TEST_CASE("header_value_any_of", "[algorithm]")
+{
+    CHECK(!http::header_value_any_of(boost::string_view(""), is_equal("")));
+    CHECK(!http::header_value_any_of(boost::string_view(" , "),
+                                     is_equal("")));
+    CHECK(http::header_value_any_of(boost::string_view("close, Upgrade"),
+                                    is_equal("Upgrade")));
+    CHECK(http::header_value_any_of(boost::string_view("close ,Upgrade "),
+                                    is_equal("close")));
+    CHECK(!http::header_value_any_of(boost::string_view("close, Upgrade"),
+                                     is_equal("keep-alive")));
+}
@@ -0,0 +1,436 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdlib>
+#include <string>
+#include <boost/http/reader/hpack.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::reader::hpack decoder;
+
+static std::string from_hex(const char *hex)
+{
+    std::string out;
+    std::string digits;
+    for (const char *c = hex ; *c ; ++c) {
+        if (*c == ' ')
+            continue;
+        digits += *c;
+        if (digits.size() == 2) {
+            out += char(std::strtol(digits.c_str(), NULL, 16));
+            digits.clear();
+        }
+    }
+    return out;
+}
+
+/* Decodes a whole header block fed in chunks of `n` bytes, keeping only the
+   unparsed bytes around. Fields are written as "name: value\n". */
+static std::string decode(decoder &d, const std::string &block,
+                          std::size_t n = std::string::npos)
+{
+    std::string out;
+    std::string buf;
+    std::size_t pos = 0;
+
+    for (;;) {
+        std::size_t step = std::min(n, block.size() - pos);
+        buf.append(block, pos, step);
+        pos += step;
+        d.set_buffer(asio::buffer(buf), pos == block.size());
+
+        while (d.code() != http::token::code::error_insufficient_data) {
+            switch (d.code()) {
+            case http::token::code::field_name:
+                out += d.value<http::token::field_name>().to_string();
+                out += ": ";
+                break;
+            case http::token::code::field_value:
+                out += d.value<http::token::field_value>().to_string();
+                out += "\n";
+                break;
+            case http::token::code::skip:
+                out += "~";
+                break;
+            case http::token::code::end_of_headers:
+                out += "$";
+                break;
+            case http::token::code::error_invalid_data:
+                out += "!";
+                return out;
+            default:
+                break;
+            }
+            d.next();
+        }
+
+        buf.erase(0, d.parsed_count());
+        if (pos == block.size())
+            return out;
+    }
+}
+
+// Decodes the blocks of the same connection with different chunk sizes
+static void check_sequence(const char *const (&blocks)[3],
+                           const char *const (&expected)[3],
+                           const std::size_t (&table_sizes)[3],
+                           std::size_t max_table_size)
+{
+    const std::size_t steps[] = {std::string::npos, 1, 2, 5};
+    for (std::size_t i = 0 ; i != 4 ; ++i) {
+        decoder d(max_table_size);
+        for (std::size_t j = 0 ; j != 3 ; ++j) {
+            INFO("step " << steps[i] << ", block " << j);
+            REQUIRE(decode(d, from_hex(blocks[j]), steps[i]) == expected[j]);
+            REQUIRE(d.table_size() == table_sizes[j]);
+        }
+    }
+}
+
+TEST_CASE("hpack integers", "[hpack]")
+{
+    // section C.1 of RFC7541
+    boost::uint_least32_t value;
+    std::string in = from_hex("0a");
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_decode_integer(p, in.size(), 5, value) == 1);
+    CHECK(value == 10);
+
+    in = from_hex("1f9a0a");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_decode_integer(p, in.size(), 5, value) == 3);
+    CHECK(value == 1337);
+    CHECK(http::detail::hpack_decode_integer(p, 2, 5, value) == 0);
+    CHECK(http::detail::hpack_decode_integer(p, 0, 5, value) == 0);
+
+    in = from_hex("ff 81feffff07");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_decode_integer(p, in.size(), 8, value) == 6);
+    CHECK(value == 0x80000000);
+
+    // Overflows
+    in = from_hex("ff 80ffffff0f");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_decode_integer(p, in.size(), 8, value) == -1);
+    in = from_hex("1f 808080808000");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_decode_integer(p, in.size(), 5, value) == -1);
+}
+
+TEST_CASE("hpack huffman", "[hpack]")
+{
+    char out[64];
+    std::string in = from_hex("f1e3 c2e5 f23a 6ba0 ab90 f4ff");
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(in.data());
+    std::ptrdiff_t n = http::detail::hpack_huffman_decode(p, in.size(), out);
+    REQUIRE(n == 15);
+    CHECK(std::string(out, n) == "www.example.com");
+
+    CHECK(http::detail::hpack_huffman_decode(p, 0, out) == 0);
+
+    // Every symbol round-trips through the code table
+    const http::detail::hpack_huffman_code *codes
+        = http::detail::hpack_huffman_codes();
+    for (int i = 0 ; i != 256 ; ++i) {
+        unsigned char buf[5] = {0};
+        boost::uint_least64_t bits = codes[i].code;
+        int size = codes[i].bits;
+        // Pad with EOS bits up to a byte boundary
+        int padded = (size + 7) / 8 * 8;
+        bits = (bits << (padded - size)) | ((1u << (padded - size)) - 1);
+        for (int j = 0 ; j != padded / 8 ; ++j)
+            buf[j] = static_cast<unsigned char>(bits >> (padded - 8 * (j + 1)));
+        REQUIRE(http::detail::hpack_huffman_decode(buf, padded / 8, out) == 1);
+        REQUIRE((unsigned char)(out[0]) == i);
+    }
+
+    // Padding longer than 7 bits
+    in = from_hex("ff");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_huffman_decode(p, in.size(), out) == -1);
+
+    // Padding that isn't EOS' prefix ('0' is 00000, then 3 bits of zeros)
+    in = from_hex("00");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_huffman_decode(p, in.size(), out) == -1);
+
+    // EOS itself
+    in = from_hex("ffffffff");
+    p = reinterpret_cast<const unsigned char*>(in.data());
+    CHECK(http::detail::hpack_huffman_decode(p, in.size(), out) == -1);
+}
+
+TEST_CASE("hpack literals", "[hpack]")
+{
+    decoder d;
+
+    // sections C.2.1 to C.2.4 of RFC7541
+    CHECK(decode(d, from_hex("400a 6375 7374 6f6d 2d6b 6579 0d63 7573 746f"
+                             "6d2d 6865 6164 6572"))
+          == "custom-key: custom-header\n$");
+    CHECK(d.table_size() == 55);
+    CHECK(d.table_entries() == 1);
+
+    CHECK(decode(d, from_hex("040c 2f73 616d 706c 652f 7061 7468"))
+          == ":path: /sample/path\n$");
+    CHECK(d.table_entries() == 1);
+
+    CHECK(decode(d, from_hex("1008 7061 7373 776f 7264 0673 6563 7265 74"))
+          == "password: secret\n$");
+    CHECK(d.table_entries() == 1);
+
+    CHECK(decode(d, from_hex("82")) == ":method: GET\n$");
+
+    // Empty header block
+    CHECK(decode(d, "") == "$");
+
+    // Dynamic table entries are indexed from 62
+    CHECK(decode(d, from_hex("be")) == "custom-key: custom-header\n$");
+    CHECK(decode(d, from_hex("bf")) == "!");
+}
+
+TEST_CASE("hpack requests", "[hpack]")
+{
+    const std::string expected[3] = {
+        ":method: GET\n:scheme: http\n:path: /\n"
+        ":authority: www.example.com\n$",
+        ":method: GET\n:scheme: http\n:path: /\n"
+        ":authority: www.example.com\ncache-control: no-cache\n$",
+        ":method: GET\n:scheme: https\n:path: /index.html\n"
+        ":authority: www.example.com\ncustom-key: custom-value\n$"
+    };
+    const char *const expected_c[3] = {
+        expected[0].c_str(), expected[1].c_str(), expected[2].c_str()
+    };
+    const std::size_t table_sizes[3] = {57, 110, 164};
+
+    // section C.3 of RFC7541
+    const char *const plain[3] = {
+        "8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d",
+        "8286 84be 5808 6e6f 2d63 6163 6865",
+        "8287 85bf 400a 6375 7374 6f6d 2d6b 6579 0c63 7573 746f 6d2d 7661"
+        "6c75 65"
+    };
+    check_sequence(plain, expected_c, table_sizes, 4096);
+
+    // section C.4 of RFC7541
+    const char *const huffman[3] = {
+        "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff",
+        "8286 84be 5886 a8eb 1064 9cbf",
+        "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf"
+    };
+    check_sequence(huffman, expected_c, table_sizes, 4096);
+}
+
+TEST_CASE("hpack responses", "[hpack]")
+{
+    const std::string expected[3] = {
+        ":status: 302\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:21 GMT\n"
+        "location: https://www.example.com\n$",
+        ":status: 307\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:21 GMT\n"
+        "location: https://www.example.com\n$",
+        ":status: 200\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:22 GMT\n"
+        "location: https://www.example.com\ncontent-encoding: gzip\n"
+        "set-cookie: foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600;"
+        " version=1\n$"
+    };
+    const char *const expected_c[3] = {
+        expected[0].c_str(), expected[1].c_str(), expected[2].c_str()
+    };
+    const std::size_t table_sizes[3] = {222, 222, 215};
+
+    // section C.5 of RFC7541 (evictions with a 256 bytes table)
+    const char *const plain[3] = {
+        "4803 3330 3258 0770 7269 7661 7465 611d 4d6f 6e2c 2032 3120 4f63"
+        "7420 3230 3133 2032 303a 3133 3a32 3120 474d 546e 1768 7474 7073"
+        "3a2f 2f77 7777 2e65 7861 6d70 6c65 2e63 6f6d",
+        "4803 3330 37c1 c0bf",
+        "88c1 611d 4d6f 6e2c 2032 3120 4f63 7420 3230 3133 2032 303a 3133"
+        "3a32 3220 474d 54c0 5a04 677a 6970 7738 666f 6f3d 4153 444a 4b48"
+        "514b 425a 584f 5157 454f 5049 5541 5851 5745 4f49 553b 206d 6178"
+        "2d61 6765 3d33 3630 303b 2076 6572 7369 6f6e 3d31"
+    };
+    check_sequence(plain, expected_c, table_sizes, 256);
+
+    // section C.6 of RFC7541
+    const char *const huffman[3] = {
+        "4882 6402 5885 aec3 771a 4b61 96d0 7abe 9410 54d4 44a8 2005 9504"
+        "0b81 66e0 82a6 2d1b ff6e 919d 29ad 1718 63c7 8f0b 97c8 e9ae 82ae"
+        "43d3",
+        "4883 640e ffc1 c0bf",
+        "88c1 6196 d07a be94 1054 d444 a820 0595 040b 8166 e084 a62d 1bff"
+        "c05a 839b d9ab 77ad 94e7 821d d7f2 e6c7 b335 dfdf cd5b 3960 d5af"
+        "2708 7f36 72c1 ab27 0fb5 291f 9587 3160 65c0 03ed 4ee5 b106 3d50"
+        "07"
+    };
+    check_sequence(huffman, expected_c, table_sizes, 256);
+}
+
+TEST_CASE("hpack well-known fields", "[hpack]")
+{
+    decoder d;
+    // :method GET, literal (new name), literal with indexed name "etag"
+    std::string block = from_hex("82 4003 666f 6f03 6261 72 6203 6162 63"
+                                 "be bf");
+    d.set_buffer(asio::buffer(block));
+
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.field() == http::hpack_field::method);
+    CHECK(d.token_size() == 1);
+    d.next();
+    REQUIRE(d.code() == http::token::code::field_value);
+    CHECK(d.token_size() == 0);
+    CHECK(d.field() == http::hpack_field::method);
+    d.next();
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.field() == http::hpack_field::unknown);
+    CHECK(d.token_size() == 9);
+    d.next();
+    d.next();
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.value<http::token::field_name>() == "etag");
+    CHECK(d.field() == http::hpack_field::etag);
+    CHECK(!d.never_indexed());
+    d.next();
+    d.next();
+
+    // Dynamic table entries remember where their names came from
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.value<http::token::field_name>() == "etag");
+    CHECK(d.field() == http::hpack_field::etag);
+    d.next();
+    d.next();
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.value<http::token::field_name>() == "foo");
+    CHECK(d.field() == http::hpack_field::unknown);
+    d.next();
+    d.next();
+    CHECK(d.code() == http::token::code::end_of_headers);
+    d.next();
+    CHECK(d.code() == http::token::code::error_insufficient_data);
+
+    // Never indexed literal
+    block = from_hex("1f 0803 6162 63");
+    d.set_buffer(asio::buffer(block));
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.value<http::token::field_name>() == "authorization");
+    CHECK(d.field() == http::hpack_field::authorization);
+    CHECK(d.never_indexed());
+    CHECK(d.table_entries() == 2);
+}
+
+TEST_CASE("hpack dynamic table", "[hpack]")
+{
+    decoder d(100);
+    CHECK(d.max_table_size() == 100);
+    CHECK(d.table_capacity() == 100);
+
+    // 2 entries of 42 bytes each fit
+    CHECK(decode(d, from_hex("4005 6b65 792d 3105 7661 6c2d 31"
+                             "4005 6b65 792d 3205 7661 6c2d 32"))
+          == "key-1: val-1\nkey-2: val-2\n$");
+    CHECK(d.table_size() == 84);
+
+    // The third evicts the first one and the ring wraps around
+    for (int i = 3 ; i != 40 ; ++i) {
+        std::string key = "key-" + std::string(1, char('a' + i % 26));
+        std::string block = from_hex("4005") + key + from_hex("05") + "val-0";
+        block[block.size() - 1] = char('0' + i % 10);
+        CHECK(decode(d, block) == key + ": val-" + char('0' + i % 10)
+              + "\n$");
+        CHECK(d.table_entries() == 2);
+        CHECK(decode(d, from_hex("be")) == key + ": val-" + char('0' + i % 10)
+              + "\n$");
+    }
+
+    // Indexed name of an entry evicted by the insertion itself
+    CHECK(decode(d, from_hex("7f00 08") + "new-val1"
+                 + from_hex("7f00 08") + "new-val2")
+          == "key-m: new-val1\nkey-n: new-val2\n$");
+    CHECK(decode(d, from_hex("be bf"))
+          == "key-n: new-val2\nkey-m: new-val1\n$");
+
+    // Entries bigger than the table empty it
+    CHECK(decode(d, from_hex("40 05") + "key-z" + from_hex("40")
+                 + std::string(64, 'v'))
+          == "key-z: " + std::string(64, 'v') + "\n$");
+    CHECK(d.table_size() == 0);
+    CHECK(d.table_entries() == 0);
+
+    // Size updates
+    CHECK(decode(d, from_hex("4005 6b65 792d 3105 7661 6c2d 31"))
+          == "key-1: val-1\n$");
+    CHECK(decode(d, from_hex("20 3f45 82")) == "~~:method: GET\n$");
+    CHECK(d.table_capacity() == 100);
+    CHECK(d.table_entries() == 0);
+    CHECK(decode(d, from_hex("3f46")) == "!");
+
+    d.reset();
+    CHECK(decode(d, from_hex("3f45")) == "~$");
+    // Only at the start of a block
+    CHECK(decode(d, from_hex("82 20")) == ":method: GET\n!");
+}
+
+TEST_CASE("hpack errors", "[hpack]")
+{
+    // Index 0 and indexes out of the table
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("80")) == "!");
+    }
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("be")) == "!");
+    }
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("7e 01 61")) == "!");
+    }
+
+    // Truncated representations at the end of the block
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("40 03 6162")) == "!");
+    }
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("ff")) == "!");
+    }
+
+    // Bad Huffman strings
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("40 81ff 01 61")) == "!");
+    }
+
+    // Integer overflow
+    {
+        decoder d;
+        CHECK(decode(d, from_hex("ff ffffffffff0f")) == "!");
+    }
+
+    // Incomplete representations wait for more data when the block goes on
+    {
+        decoder d;
+        std::string block = from_hex("4003 6162 6301 64");
+        d.set_buffer(asio::buffer(block.data(), 5), false);
+        CHECK(d.code() == http::token::code::error_insufficient_data);
+        CHECK(d.expected_token() == http::token::code::field_name);
+        CHECK(d.parsed_count() == 0);
+        d.set_buffer(asio::buffer(block));
+        REQUIRE(d.code() == http::token::code::field_name);
+        CHECK(d.value<http::token::field_name>() == "abc");
+        d.next();
+        REQUIRE(d.code() == http::token::code::field_value);
+        CHECK(d.value<http::token::field_value>() == "d");
+        CHECK(d.expected_token() == http::token::code::end_of_headers);
+    }
+}
@@ -0,0 +1,376 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/http/reader/hpack.hpp>
+#include <boost/http/writer/hpack.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::writer::hpack encoder;
+typedef http::reader::hpack decoder;
+
+static std::string to_hex(const std::string &in)
+{
+    std::string out;
+    for (std::size_t i = 0 ; i != in.size() ; ++i) {
+        char digits[3];
+        std::sprintf(digits, "%02x", static_cast<unsigned char>(in[i]));
+        out += digits;
+    }
+    return out;
+}
+
+/* Encodes the fields in `fields` ("name: value\n" lines) as a whole header
+   block */
+static std::string encode(encoder &e, const std::string &fields,
+                          encoder::indexing i = encoder::indexing::incremental)
+{
+    std::vector<char> buf(4096);
+    e.set_buffer(asio::buffer(buf));
+
+    for (std::size_t pos = 0 ; pos != fields.size() ;) {
+        std::size_t sep = fields.find(": ", pos + 1);
+        std::size_t end = fields.find('\n', sep);
+        REQUIRE(e.write_field(boost::string_view(&fields[pos], sep - pos),
+                              boost::string_view(&fields[sep + 2],
+                                                 end - sep - 2),
+                              i));
+        pos = end + 1;
+    }
+    e.end_headers();
+
+    return std::string(&buf[0], e.size());
+}
+
+static std::string decode(decoder &d, const std::string &block)
+{
+    std::string out;
+    d.set_buffer(asio::buffer(block));
+
+    while (d.code() != http::token::code::error_insufficient_data) {
+        switch (d.code()) {
+        case http::token::code::field_name:
+            out += d.value<http::token::field_name>().to_string();
+            out += ": ";
+            break;
+        case http::token::code::field_value:
+            out += d.value<http::token::field_value>().to_string();
+            out += "\n";
+            break;
+        case http::token::code::end_of_headers:
+            d.next();
+            return out;
+        case http::token::code::error_invalid_data:
+            return out + "!";
+        default:
+            break;
+        }
+        d.next();
+    }
+    return out + "!";
+}
+
+TEST_CASE("hpack writer primitives", "[hpack]")
+{
+    // section C.1 of RFC7541
+    unsigned char out[8];
+    CHECK(http::detail::hpack_integer_size(5, 10) == 1);
+    CHECK(http::detail::hpack_encode_integer(out, 5, 0xE0, 10) == 1);
+    CHECK(out[0] == 0xEA);
+    CHECK(http::detail::hpack_integer_size(5, 1337) == 3);
+    CHECK(http::detail::hpack_encode_integer(out, 5, 0, 1337) == 3);
+    CHECK(to_hex(std::string(out, out + 3)) == "1f9a0a");
+    CHECK(http::detail::hpack_integer_size(8, 42) == 1);
+    CHECK(http::detail::hpack_encode_integer(out, 8, 0, 42) == 1);
+    CHECK(out[0] == 42);
+    // The value matching the prefix needs an extra byte
+    CHECK(http::detail::hpack_integer_size(5, 31) == 2);
+    CHECK(http::detail::hpack_encode_integer(out, 5, 0, 31) == 2);
+    CHECK(to_hex(std::string(out, out + 2)) == "1f00");
+
+    // section C.4.1 of RFC7541
+    std::string in = "www.example.com";
+    unsigned char huffman[64];
+    CHECK(http::detail::hpack_huffman_encoded_size(in.data(), in.size())
+          == 12);
+    CHECK(http::detail::hpack_huffman_encode(in.data(), in.size(), huffman)
+          == 12);
+    CHECK(to_hex(std::string(huffman, huffman + 12))
+          == "f1e3c2e5f23a6ba0ab90f4ff");
+
+    // Every symbol (including the 30-bit ones) round-trips
+    for (int c = 0 ; c != 256 ; ++c) {
+        INFO("symbol " << c);
+        std::string s(3, char(c));
+        std::size_t n = http::detail::hpack_huffman_encoded_size(s.data(),
+                                                                 s.size());
+        CHECK(http::detail::hpack_huffman_encode(s.data(), s.size(), huffman)
+              == n);
+        char decoded[64];
+        CHECK(http::detail::hpack_huffman_decode(huffman, n, decoded) == 3);
+        CHECK(std::string(decoded, 3) == s);
+    }
+
+    // Static table names
+    CHECK(http::detail::hpack_static_find_name(":authority", 10) == 1);
+    CHECK(http::detail::hpack_static_find_name(":status", 7) == 8);
+    CHECK(http::detail::hpack_static_find_name("etag", 4) == 34);
+    CHECK(http::detail::hpack_static_find_name("www-authenticate", 16) == 61);
+    CHECK(http::detail::hpack_static_find_name("access-control-allow-origin",
+                                               27) == 20);
+    CHECK(http::detail::hpack_static_find_name("etah", 4) == 0);
+    CHECK(http::detail::hpack_static_find_name("x-custom-header", 15) == 0);
+    CHECK(http::detail::hpack_static_find_name("", 0) == 0);
+    CHECK(http::detail::hpack_static_find_name("access-control-allow-originn",
+                                               28) == 0);
+}
+
+TEST_CASE("hpack writer requests", "[hpack]")
+{
+    // section C.4 of RFC7541
+    encoder e;
+    decoder d;
+    const char *fields[3] = {
+        ":method: GET\n:scheme: http\n:path: /\n:authority: www.example.com\n",
+        ":method: GET\n:scheme: http\n:path: /\n:authority: www.example.com\n"
+        "cache-control: no-cache\n",
+        ":method: GET\n:scheme: https\n:path: /index.html\n"
+        ":authority: www.example.com\ncustom-key: custom-value\n"
+    };
+    const char *blocks[3] = {
+        "828684418cf1e3c2e5f23a6ba0ab90f4ff",
+        "828684be5886a8eb10649cbf",
+        "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"
+    };
+    const std::size_t table_sizes[3] = {57, 110, 164};
+
+    for (int i = 0 ; i != 3 ; ++i) {
+        INFO("block " << i);
+        std::string block = encode(e, fields[i]);
+        CHECK(to_hex(block) == blocks[i]);
+        CHECK(e.table_size() == table_sizes[i]);
+        CHECK(decode(d, block) == fields[i]);
+        CHECK(d.table_size() == e.table_size());
+    }
+}
+
+TEST_CASE("hpack writer responses", "[hpack]")
+{
+    // section C.6 of RFC7541 (evictions with a 256 bytes table)
+    encoder e;
+    decoder d;
+    e.set_peer_max_table_size(256);
+    CHECK(e.table_capacity() == 256);
+
+    const char *fields[3] = {
+        ":status: 302\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:21 GMT\n"
+        "location: https://www.example.com\n",
+        ":status: 307\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:21 GMT\n"
+        "location: https://www.example.com\n",
+        ":status: 200\ncache-control: private\n"
+        "date: Mon, 21 Oct 2013 20:13:22 GMT\n"
+        "location: https://www.example.com\ncontent-encoding: gzip\n"
+        "set-cookie: foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600;"
+        " version=1\n"
+    };
+    /* The first block starts with the dynamic table size update. "307" is
+       sent as is as Huffman doesn't make it shorter (unlike the RFC). */
+    const char *blocks[3] = {
+        "3fe101"
+        "488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1b"
+        "ff6e919d29ad171863c78f0b97c8e9ae82ae43d3",
+        "4803333037c1c0bf",
+        "88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad"
+        "94e7821dd7f2e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f95873160"
+        "65c003ed4ee5b1063d5007"
+    };
+    const std::size_t table_sizes[3] = {222, 222, 215};
+    const std::size_t table_entries[3] = {4, 4, 3};
+
+    for (int i = 0 ; i != 3 ; ++i) {
+        INFO("block " << i);
+        std::string block = encode(e, fields[i]);
+        CHECK(to_hex(block) == blocks[i]);
+        CHECK(e.table_size() == table_sizes[i]);
+        CHECK(e.table_entries() == table_entries[i]);
+        CHECK(decode(d, block) == fields[i]);
+        CHECK(d.table_size() == e.table_size());
+        CHECK(d.table_capacity() == 256);
+    }
+}
+
+TEST_CASE("hpack writer indexing", "[hpack]")
+{
+    encoder e;
+    decoder d;
+
+    // Not indexed (section 6.2.2 of RFC7541)
+    std::string block = encode(e, "custom-key: custom-header\n",
+                               encoder::indexing::none);
+    CHECK(to_hex(block) == "008825a849e95ba97d7f8925a849e95a728e42d9");
+    CHECK(e.table_entries() == 0);
+    CHECK(decode(d, block) == "custom-key: custom-header\n");
+    CHECK(d.table_entries() == 0);
+
+    // Sensitive fields are never indexed, not even through the static table
+    block = encode(e, ":method: GET\npassword: secret\n",
+                   encoder::indexing::never);
+    CHECK(to_hex(block).substr(0, 2) == "12");
+    CHECK(e.table_entries() == 0);
+    d.set_buffer(asio::buffer(block));
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.never_indexed());
+    CHECK(d.field() == http::hpack_field::method);
+    d.next();
+    d.next();
+    REQUIRE(d.code() == http::token::code::field_name);
+    CHECK(d.never_indexed());
+    CHECK(d.value<http::token::field_name>() == "password");
+    d.next();
+    d.next();
+    CHECK(d.code() == http::token::code::end_of_headers);
+    d.next();
+
+    // Exact matches are still used by fields that aren't indexed
+    block = encode(e, "content-encoding: br\n");
+    CHECK(to_hex(block).substr(0, 2) == "5a");
+    CHECK(decode(d, block) == "content-encoding: br\n");
+    block = encode(e, "content-encoding: br\n", encoder::indexing::none);
+    CHECK(to_hex(block) == "be");
+    CHECK(decode(d, block) == "content-encoding: br\n");
+}
+
+TEST_CASE("hpack writer names", "[hpack]")
+{
+    encoder e;
+    decoder d;
+
+    // The static name wins over the newer dynamic entries
+    std::string block = encode(e, "etag: \"a\"\netag: \"b\"\n");
+    CHECK(to_hex(block).substr(0, 2) == "62");
+    CHECK(decode(d, block) == "etag: \"a\"\netag: \"b\"\n");
+
+    // The newest dynamic entry is used for names out of the static table
+    block = encode(e, "x-a: 1\nx-a: 2\nx-a: 3\n");
+    CHECK(decode(d, block) == "x-a: 1\nx-a: 2\nx-a: 3\n");
+    block = encode(e, "x-a: 4\n", encoder::indexing::none);
+    CHECK(to_hex(block) == "0f2f0134");
+    CHECK(decode(d, block) == "x-a: 4\n");
+
+    // Repeated fields take a single byte
+    block = encode(e, "x-a: 2\netag: \"b\"\n");
+    CHECK(to_hex(block) == "bfc1");
+    CHECK(decode(d, block) == "x-a: 2\netag: \"b\"\n");
+    CHECK(d.table_size() == e.table_size());
+}
+
+TEST_CASE("hpack writer buffer", "[hpack]")
+{
+    encoder e;
+    decoder d;
+    char buf[16];
+
+    e.set_buffer(asio::buffer(buf, 4));
+    CHECK(e.write_field(":status", "200"));
+    CHECK(e.size() == 1);
+    // Doesn't fit: nothing is written and the table is untouched
+    CHECK(!e.write_field("server", "boost.http"));
+    CHECK(e.size() == 1);
+    CHECK(e.table_entries() == 0);
+
+    std::string block(buf, e.size());
+    e.set_buffer(asio::buffer(buf));
+    CHECK(e.write_field("server", "boost.http"));
+    CHECK(e.table_entries() == 1);
+    block.append(buf, e.size());
+    e.end_headers();
+
+    CHECK(decode(d, block) == ":status: 200\nserver: boost.http\n");
+    CHECK(d.table_size() == e.table_size());
+}
+
+TEST_CASE("hpack writer table size updates", "[hpack]")
+{
+    encoder e;
+    decoder d;
+
+    // The entry fills more than 3/4 of the table, so it isn't added
+    e.set_peer_max_table_size(100);
+    std::string block = encode(e, "x-big: " + std::string(40, 'a') + "\n");
+    CHECK(to_hex(block).substr(0, 6) == "3f4500");
+    CHECK(e.table_entries() == 0);
+    CHECK(decode(d, block).size() == 48);
+    CHECK(d.table_capacity() == 100);
+
+    block = encode(e, "x-small: a\n");
+    CHECK(to_hex(block).substr(0, 2) == "40");
+    CHECK(e.table_entries() == 1);
+    CHECK(decode(d, block) == "x-small: a\n");
+
+    // The smallest size set between two blocks is signaled too
+    e.set_peer_max_table_size(0);
+    CHECK(e.table_entries() == 0);
+    e.set_peer_max_table_size(2000);
+    block = encode(e, "x-small: a\n");
+    CHECK(to_hex(block).substr(0, 8) == "203fb10f");
+    CHECK(decode(d, block) == "x-small: a\n");
+    CHECK(d.table_capacity() == 2000);
+    CHECK(d.table_size() == e.table_size());
+
+    // The limit set at construction wins
+    e.set_peer_max_table_size(65536);
+    CHECK(e.table_capacity() == 4096);
+    block = encode(e, "x-small: a\n");
+    CHECK(to_hex(block) == "3fe11fbe");
+    CHECK(decode(d, block) == "x-small: a\n");
+
+    // No dynamic table at all
+    encoder e2(0);
+    decoder d2;
+    CHECK(e2.table_capacity() == 0);
+    block = encode(e2, "x-small: a\nx-small: a\n");
+    CHECK(to_hex(block).substr(0, 4) == "2000");
+    CHECK(e2.table_entries() == 0);
+    CHECK(decode(d2, block) == "x-small: a\nx-small: a\n");
+    CHECK(d2.table_capacity() == 0);
+
+    e2.reset();
+    CHECK(to_hex(encode(e2, ":status: 200\n")) == "2088");
+}
+
+TEST_CASE("hpack writer dynamic table", "[hpack]")
+{
+    // Many evictions and hash collisions, checked against the decoder
+    const std::size_t sizes[] = {64, 256, 4096};
+    for (std::size_t s = 0 ; s != 3 ; ++s) {
+        encoder e(sizes[s]);
+        decoder d(sizes[s]);
+        unsigned seed = 1;
+        for (int b = 0 ; b != 200 ; ++b) {
+            std::string fields;
+            for (int f = 0 ; f != 8 ; ++f) {
+                seed = seed * 1103515245 + 12345;
+                unsigned r = (seed >> 16) & 0x7FFF;
+                char field[64];
+                std::sprintf(field, "x-%u: %.*s%u\n", r % 13, int(r % 20),
+                             "vvvvvvvvvvvvvvvvvvvv", r % 7);
+                fields += field;
+            }
+            INFO("table " << sizes[s] << ", block " << b);
+            std::string block = encode(e, fields);
+            REQUIRE(decode(d, block) == fields);
+            REQUIRE(d.table_size() == e.table_size());
+            REQUIRE(d.table_entries() == e.table_entries());
+            REQUIRE(e.table_size() <= e.table_capacity());
+        }
+    }
+}
@@ -0,0 +1,690 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/http/http2_connection.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::http2_connection connection;
+typedef connection::error_code error_code;
+typedef connection::stream_state stream_state;
+typedef http::token::http2_frame::frame_type frame_type;
+typedef http::token::http2_frame::flags flags;
+typedef http::token::http2_setting::identifier identifier;
+
+static const std::string preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+
+static std::string be32(boost::uint_least32_t v)
+{
+    std::string out;
+    for (int i = 3 ; i >= 0 ; --i)
+        out += char(v >> (i * 8));
+    return out;
+}
+
+static std::string frame(int type, int f, boost::uint_least32_t stream_id,
+                         const std::string &payload = std::string())
+{
+    std::string out;
+    out += char(payload.size() >> 16);
+    out += char(payload.size() >> 8);
+    out += char(payload.size());
+    out += char(type);
+    out += char(f);
+    return out + be32(stream_id) + payload;
+}
+
+static std::string setting(int id, boost::uint_least32_t value)
+{
+    std::string out;
+    out += char(id >> 8);
+    out += char(id);
+    return out + be32(value);
+}
+
+static std::string headers(boost::uint_least32_t stream_id,
+                           bool end_stream = false)
+{
+    // ":method: GET" (the block contents don't matter to the connection)
+    return frame(frame_type::headers,
+                 flags::end_headers | (end_stream ? flags::end_stream : 0),
+                 stream_id, "\x82");
+}
+
+static std::string data(boost::uint_least32_t stream_id, std::size_t size,
+                        bool end_stream = false)
+{
+    return frame(frame_type::data, end_stream ? flags::end_stream : 0,
+                 stream_id, std::string(size, 'x'));
+}
+
+static std::string window_update(boost::uint_least32_t stream_id,
+                                 boost::uint_least32_t increment)
+{
+    return frame(frame_type::window_update, 0, stream_id, be32(increment));
+}
+
+/* The peer side: bytes are parsed by `reader::http2_frame` and every token is
+   recorded as a letter (lowercase if `receive()` says it must be ignored). */
+struct peer
+{
+    explicit peer(connection::role r = connection::role::server,
+                  boost::uint_least32_t max_concurrent_streams = 100,
+                  boost::uint_least32_t initial_window_size = 65535)
+        : conn(r, max_concurrent_streams, initial_window_size)
+        , parser(r)
+    {
+        if (boost::native_value(r) == connection::role::server)
+            CHECK(feed(preface + frame(frame_type::settings, 0, 0)) == "~FE");
+        else
+            CHECK(feed(frame(frame_type::settings, 0, 0)) == "FE");
+        // The client preface isn't a frame
+        if (boost::native_value(r) == connection::role::client)
+            conn.consume_output(preface.size());
+        output();
+    }
+
+    std::string feed(const std::string &bytes)
+    {
+        std::string out;
+        buffer += bytes;
+        parser.set_buffer(asio::buffer(buffer));
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            char c = '?';
+            switch (parser.code()) {
+            case http::token::code::skip:
+                c = '~';
+                break;
+            case http::token::code::http2_frame:
+                c = 'F';
+                break;
+            case http::token::code::http2_setting:
+                c = 'S';
+                break;
+            case http::token::code::body_chunk:
+                c = 'B';
+                break;
+            case http::token::code::end_of_message:
+                c = 'E';
+                break;
+            default:
+                c = '!';
+            }
+            if (!conn.receive(parser))
+                c = std::tolower(c);
+            out += c;
+            if (c == '!')
+                break;
+            parser.next();
+        }
+        buffer.erase(0, parser.parsed_count());
+        return out;
+    }
+
+    /* Frames written by the connection as "type:flags:stream:payload" (the
+       payload in hex) */
+    std::string output()
+    {
+        std::string out;
+        asio::const_buffer b = conn.output();
+        const unsigned char *p = static_cast<const unsigned char*>(b.data());
+        std::size_t size = b.size();
+        std::size_t i = 0;
+        while (i != size) {
+            REQUIRE(size - i >= 9);
+            std::size_t length = (p[i] << 16) | (p[i + 1] << 8) | p[i + 2];
+            char header[64];
+            std::sprintf(header, "%s%d:%d:%lu:", out.empty() ? "" : " ",
+                         int(p[i + 3]), int(p[i + 4]),
+                         (static_cast<unsigned long>(p[i + 5] & 0x7F) << 24)
+                         | (static_cast<unsigned long>(p[i + 6]) << 16)
+                         | (static_cast<unsigned long>(p[i + 7]) << 8)
+                         | p[i + 8]);
+            out += header;
+            for (std::size_t j = 0 ; j != length ; ++j) {
+                std::sprintf(header, "%02x", p[i + 9 + j]);
+                out += header;
+            }
+            i += 9 + length;
+        }
+        conn.consume_output(size);
+        return out;
+    }
+
+    /* Drains the scheduler, recording every DATA frame as
+       "stream:size[$]" */
+    std::string drain()
+    {
+        std::string out;
+        connection::data_frame f;
+        while (conn.next_data_frame(f)) {
+            char item[64];
+            std::sprintf(item, "%s%lu:%lu%s", out.empty() ? "" : " ",
+                         static_cast<unsigned long>(f.stream_id),
+                         static_cast<unsigned long>(f.size),
+                         f.end_stream ? "$" : "");
+            out += item;
+        }
+        return out;
+    }
+
+    connection conn;
+    http::reader::http2_frame parser;
+    std::string buffer;
+};
+
+TEST_CASE("http2_connection preface", "[http2]")
+{
+    {
+        connection c;
+        CHECK(c.error() == error_code::no_error);
+        asio::const_buffer b = c.output();
+        std::string out(static_cast<const char*>(b.data()), b.size());
+        CHECK(out == frame(frame_type::settings, 0, 0,
+                           setting(identifier::max_concurrent_streams, 100)));
+        c.consume_output(5);
+        CHECK(c.output().size() == out.size() - 5);
+        c.consume_output(out.size() - 5);
+        CHECK(c.output().size() == 0);
+    }
+
+    {
+        connection c(connection::role::client, 10, 1 << 20);
+        asio::const_buffer b = c.output();
+        std::string out(static_cast<const char*>(b.data()), b.size());
+        CHECK(out == preface
+              + frame(frame_type::settings, 0, 0,
+                      setting(identifier::max_concurrent_streams, 10)
+                      + setting(identifier::initial_window_size, 1 << 20)
+                      + setting(identifier::enable_push, 0)));
+    }
+}
+
+TEST_CASE("http2_connection settings and ping", "[http2]")
+{
+    peer p;
+
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::header_table_size, 100)
+                       + setting(identifier::max_concurrent_streams, 7)
+                       + setting(identifier::max_frame_size, 20000)
+                       + setting(99, 1)))
+          == "FSSSSE");
+    CHECK(p.output() == "4:1:0:");
+    CHECK(p.conn.peer_header_table_size() == 100);
+    CHECK(p.conn.peer_max_concurrent_streams() == 7);
+    CHECK(p.conn.peer_max_frame_size() == 20000);
+
+    CHECK(p.feed(frame(frame_type::ping, 0, 0, "12345678")) == "FBE");
+    CHECK(p.output() == "6:1:0:3132333435363738");
+    CHECK(p.feed(frame(frame_type::ping, flags::ack, 0, "12345678"))
+          == "FBE");
+    CHECK(p.output() == "");
+
+    // ACK of our SETTINGS
+    CHECK(p.feed(frame(frame_type::settings, flags::ack, 0)) == "FE");
+    CHECK(p.output() == "");
+
+    // Unknown frames are ignored
+    CHECK(p.feed(frame(0x42, 0, 1, "abc")) == "FBE");
+    CHECK(p.output() == "");
+
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size,
+                               0x80000000)))
+          == "Fse");
+    CHECK(p.conn.error() == error_code::flow_control_error);
+    CHECK(p.output() == "7:0:0:0000000000000003");
+    CHECK(p.feed("") == "");
+}
+
+TEST_CASE("http2_connection stream states", "[http2]")
+{
+    peer p;
+
+    CHECK(p.conn.state(1) == stream_state::idle);
+    CHECK(p.feed(headers(1)) == "FBE");
+    CHECK(p.conn.state(1) == stream_state::open);
+    CHECK(p.conn.last_peer_stream_id() == 1);
+    CHECK(p.conn.active_streams() == 1);
+
+    CHECK(p.feed(data(1, 5, true)) == "FBE");
+    CHECK(p.conn.state(1) == stream_state::half_closed_remote);
+    // Streams skipped over are closed (section 5.1.1 of RFC9113)
+    CHECK(p.feed(headers(5, true)) == "FBE");
+    CHECK(p.conn.state(3) == stream_state::closed);
+    CHECK(p.conn.state(5) == stream_state::half_closed_remote);
+    CHECK(p.conn.state(7) == stream_state::idle);
+    CHECK(p.output() == "");
+
+    // Response headers with a body (the block is split in CONTINUATION)
+    std::string block(20000, 'h');
+    p.conn.write_headers(1, asio::buffer(block), false);
+    std::string out = p.output();
+    CHECK(out.substr(0, 8) == "1:0:1:68");
+    CHECK(out.find(" 9:4:1:68") != std::string::npos);
+    CHECK(p.conn.state(1) == stream_state::half_closed_remote);
+    p.conn.write_data(1, 10, true);
+    CHECK(p.drain() == "1:10$");
+    CHECK(p.conn.state(1) == stream_state::closed);
+    CHECK(p.conn.active_streams() == 1);
+
+    // Response without a body
+    p.conn.write_headers(5, asio::buffer("\x88", 1), true);
+    CHECK(p.output() == "1:5:5:88");
+    CHECK(p.conn.state(5) == stream_state::closed);
+    CHECK(p.conn.active_streams() == 0);
+
+    // Frames on closed streams
+    CHECK(p.feed(data(1, 5)) == "fbe");
+    CHECK(p.output() == "3:0:1:00000005");
+    CHECK(p.feed(headers(3)) == "fbe");
+    CHECK(p.output() == "3:0:3:00000005");
+    CHECK(p.feed(window_update(1, 10)) == "FE");
+    CHECK(p.feed(frame(frame_type::rst_stream, 0, 1, be32(8))) == "FE");
+    CHECK(p.output() == "");
+
+    // Resets
+    CHECK(p.feed(headers(7)) == "FBE");
+    CHECK(p.feed(frame(frame_type::rst_stream, 0, 7, be32(8))) == "FE");
+    CHECK(p.conn.state(7) == stream_state::closed);
+    CHECK(p.feed(headers(9)) == "FBE");
+    p.conn.reset_stream(9, error_code::cancel);
+    CHECK(p.output() == "3:0:9:00000008");
+    CHECK(p.conn.state(9) == stream_state::closed);
+    CHECK(p.conn.active_streams() == 0);
+
+    // DATA on an idle stream
+    CHECK(p.feed(data(11, 1)) == "fbe");
+    CHECK(p.conn.error() == error_code::protocol_error);
+    CHECK(p.output() == "7:0:0:0000000900000001");
+
+    // Client side: streams are idle until their HEADERS are written
+    peer c(connection::role::client);
+    CHECK(c.conn.open_stream() == 1);
+    CHECK(c.conn.state(1) == stream_state::idle);
+    CHECK(c.conn.active_streams() == 1);
+    CHECK(c.output() == "");
+    CHECK(c.conn.write_headers(1, asio::buffer("\x82", 1), false));
+    CHECK(c.conn.state(1) == stream_state::open);
+    CHECK(c.conn.write_data(1, 3, true));
+    CHECK(c.output() == "1:4:1:82");
+    CHECK(c.drain() == "1:3$");
+    CHECK(c.conn.state(1) == stream_state::half_closed_local);
+
+    // The peer can't send anything on a stream it hasn't seen yet
+    CHECK(c.conn.open_stream() == 3);
+    CHECK(c.feed(headers(3)) == "fbe");
+    CHECK(c.conn.error() == error_code::protocol_error);
+    CHECK(c.output() == "7:0:0:0000000000000001");
+}
+
+TEST_CASE("http2_connection stream errors", "[http2]")
+{
+    // RST_STREAM on idle streams
+    {
+        peer p;
+        CHECK(p.feed(frame(frame_type::rst_stream, 0, 1, be32(0))) == "fe");
+        CHECK(p.conn.error() == error_code::protocol_error);
+    }
+
+    // Servers don't accept streams of their own parity
+    {
+        peer p;
+        CHECK(p.feed(headers(2)) == "fbe");
+        CHECK(p.conn.error() == error_code::protocol_error);
+    }
+
+    // Frames the reader rejects
+    {
+        peer p;
+        CHECK(p.feed(frame(frame_type::ping, 0, 0, "1234")) == "!");
+        CHECK(p.conn.error() == error_code::frame_size_error);
+        CHECK(p.output() == "7:0:0:0000000000000006");
+    }
+
+    // PRIORITY_UPDATE on a stream
+    {
+        peer p;
+        CHECK(p.feed(frame(0x10, 0, 1, be32(1) + "u=1")) == "fbe");
+        CHECK(p.conn.error() == error_code::protocol_error);
+    }
+
+    // Client side: PUSH_PROMISE while push is disabled
+    {
+        peer p(connection::role::client);
+        boost::uint_least32_t id = p.conn.open_stream();
+        CHECK(id == 1);
+        p.conn.write_headers(id, asio::buffer("\x82", 1), true);
+        CHECK(p.output() == "1:5:1:82");
+        CHECK(p.conn.state(1) == stream_state::half_closed_local);
+        CHECK(p.feed(frame(frame_type::push_promise, flags::end_headers, 1,
+                           be32(2) + "\x82"))
+              == "fbe");
+        CHECK(p.conn.error() == error_code::protocol_error);
+    }
+}
+
+TEST_CASE("http2_connection streams closed by the peer", "[http2]")
+{
+    peer p;
+
+    CHECK(p.feed(headers(1, true) + headers(3, true)) == "FBEFBE");
+    CHECK(p.conn.write_headers(1, asio::buffer("\x88", 1), false));
+    CHECK(p.conn.write_data(1, 100000, true));
+    CHECK(p.drain() == "1:16384 1:16384 1:16384 1:16383");
+    CHECK(p.conn.write_headers(3, asio::buffer("\x88", 1), false));
+    CHECK(p.conn.write_data(3, 10, false));
+    p.output();
+
+    // The peer cancels both streams before the responses are complete
+    CHECK(p.feed(frame(frame_type::rst_stream, 0, 1, be32(8))
+                 + frame(frame_type::rst_stream, 0, 3, be32(8)))
+          == "FEFE");
+    CHECK(p.conn.state(1) == stream_state::closed);
+    CHECK(p.conn.active_streams() == 0);
+
+    CHECK(!p.conn.write_data(1, 10, true));
+    CHECK(!p.conn.write_headers(3, asio::buffer("\x88", 1), true));
+    CHECK(!p.conn.write_data(3, 10, true));
+    CHECK(p.conn.send_window(1) == 0);
+    CHECK(p.output() == "");
+    CHECK(p.feed(window_update(0, 100000)) == "FE");
+    CHECK(p.drain() == "");
+
+    // Streams closed by GOAWAY
+    peer c(connection::role::client);
+    CHECK(c.conn.open_stream() == 1);
+    CHECK(c.conn.open_stream() == 3);
+    CHECK(c.feed(frame(frame_type::goaway, 0, 0, be32(1) + be32(0)))
+          == "FE");
+    CHECK(!c.conn.write_headers(3, asio::buffer("\x82", 1), true));
+    CHECK(c.conn.write_headers(1, asio::buffer("\x82", 1), true));
+    CHECK(c.output() == "1:5:1:82");
+}
+
+TEST_CASE("http2_connection concurrency limit", "[http2]")
+{
+    peer p(connection::role::server, 2);
+
+    CHECK(p.feed(headers(1) + headers(3)) == "FBEFBE");
+    // Refused streams still carry a header block for the HPACK decoder
+    CHECK(p.feed(frame(frame_type::headers, 0, 5, "\x82")
+                 + frame(frame_type::continuation, flags::end_headers, 5,
+                         "\x84"))
+          == "fbefbe");
+    CHECK(p.output() == "3:0:5:00000007");
+    CHECK(p.conn.state(5) == stream_state::closed);
+    CHECK(p.conn.last_peer_stream_id() == 5);
+
+    CHECK(p.feed(data(1, 0, true)) == "FE");
+    p.conn.write_headers(1, asio::buffer("\x88", 1), true);
+    p.output();
+    CHECK(p.feed(headers(7)) == "FBE");
+
+    // Graceful shutdown: new streams are refused
+    p.conn.shutdown();
+    CHECK(p.output() == "7:0:0:0000000700000000");
+    CHECK(p.conn.error() == error_code::no_error);
+    CHECK(p.feed(headers(9)) == "fbe");
+    CHECK(p.output() == "3:0:9:00000007");
+    CHECK(p.feed(data(7, 1)) == "FBE");
+}
+
+TEST_CASE("http2_connection send flow control", "[http2]")
+{
+    peer p;
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 100)))
+          == "FSE");
+    p.output();
+    CHECK(p.feed(headers(1, true)) == "FBE");
+    CHECK(p.conn.send_window(1) == 100);
+
+    p.conn.write_headers(1, asio::buffer("\x88", 1), false);
+    p.output();
+    p.conn.write_data(1, 250, true);
+    CHECK(p.drain() == "1:100");
+    CHECK(p.conn.send_window() == 65535 - 100);
+
+    CHECK(p.feed(window_update(1, 100)) == "FE");
+    CHECK(p.drain() == "1:100");
+    // SETTINGS may take the window below zero (section 6.9.2 of RFC9113)
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 50)))
+          == "FSE");
+    CHECK(p.conn.send_window(1) == -50);
+    CHECK(p.feed(window_update(1, 60)) == "FE");
+    CHECK(p.drain() == "1:10");
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 1000)))
+          == "FSE");
+    CHECK(p.drain() == "1:40$");
+    CHECK(p.conn.state(1) == stream_state::closed);
+    CHECK(p.output() == "4:1:0: 4:1:0:");
+
+    // The connection window
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 1 << 20)))
+          == "FSE");
+    CHECK(p.feed(headers(3, true)) == "FBE");
+    p.conn.write_data(3, 70000, true);
+    CHECK(p.drain() == "3:16384 3:16384 3:16384 3:16133");
+    CHECK(p.conn.send_window() == 0);
+    CHECK(p.feed(window_update(0, 1000)) == "FE");
+    CHECK(p.drain() == "3:1000");
+    CHECK(p.feed(window_update(0, 10000)) == "FE");
+    CHECK(p.drain() == "3:3715$");
+
+    // Bigger frames
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::max_frame_size, 40000))
+                 + window_update(0, 100000) + headers(5, true))
+          == "FSEFEFBE");
+    p.conn.write_data(5, 50000, false);
+    p.conn.write_data(5, 0, true);
+    CHECK(p.drain() == "5:40000 5:10000$");
+    p.output();
+
+    // Invalid increments
+    CHECK(p.feed(headers(7, true)) == "FBE");
+    CHECK(p.feed(window_update(7, 0)) == "fe");
+    CHECK(p.output() == "3:0:7:00000001");
+    CHECK(p.feed(headers(9, true)) == "FBE");
+    CHECK(p.feed(window_update(9, 0x7FFFFFFF)) == "fe");
+    CHECK(p.output() == "3:0:9:00000003");
+    CHECK(p.feed(window_update(11, 1)) == "fe");
+    CHECK(p.conn.error() == error_code::protocol_error);
+
+    peer p2;
+    CHECK(p2.feed(window_update(0, 0)) == "fe");
+    CHECK(p2.conn.error() == error_code::protocol_error);
+
+    peer p3;
+    CHECK(p3.feed(window_update(0, 0x7FFFFFFF - 65535)) == "FE");
+    CHECK(p3.feed(window_update(0, 1)) == "fe");
+    CHECK(p3.conn.error() == error_code::flow_control_error);
+}
+
+TEST_CASE("http2_connection receive flow control", "[http2]")
+{
+    peer p(connection::role::server, 100, 1000);
+    CHECK(p.output() == "");
+
+    // Our window only applies once the peer acknowledges it
+    CHECK(p.feed(headers(1)) == "FBE");
+    CHECK(p.feed(frame(frame_type::settings, flags::ack, 0)) == "FE");
+    CHECK(p.feed(headers(3)) == "FBE");
+
+    CHECK(p.feed(data(1, 900)) == "FBE");
+    CHECK(p.feed(data(3, 900)) == "FBE");
+    CHECK(p.feed(data(3, 101)) == "fbe");
+    CHECK(p.output() == "3:0:3:00000003");
+
+    // Window updates once half of a window is consumed
+    p.conn.consume(1, 400);
+    CHECK(p.output() == "");
+    p.conn.consume(1, 100);
+    CHECK(p.output() == "8:0:1:000001f4");
+    CHECK(p.feed(data(1, 580)) == "FBE");
+
+    // Padding is given back right away
+    CHECK(p.feed(frame(frame_type::data, flags::padded, 1,
+                       std::string("\x09", 1) + "abc" + std::string(9, '\0')))
+          == "FB~E");
+    p.conn.consume(1, 3);
+    CHECK(p.output() == "");
+
+    // The connection window
+    for (int i = 5 ; i != 5 + 2 * 40 ; i += 2) {
+        CHECK(p.feed(headers(i)) == "FBE");
+        CHECK(p.feed(data(i, 900)) == "FBE");
+        p.conn.consume(i, 900);
+    }
+    std::string out = p.output();
+    CHECK(out.find("8:0:0:") != std::string::npos);
+
+    peer p2(connection::role::server, 100, 1 << 20);
+    CHECK(p2.feed(frame(frame_type::settings, flags::ack, 0)) == "FE");
+    CHECK(p2.feed(headers(1)) == "FBE");
+    for (int i = 0 ; i != 3 ; ++i)
+        CHECK(p2.feed(data(1, 16384)) == "FBE");
+    CHECK(p2.feed(data(1, 16384)) == "fbe");
+    CHECK(p2.conn.error() == error_code::flow_control_error);
+}
+
+TEST_CASE("http2_connection priorities", "[http2]")
+{
+    peer p;
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 1 << 20))
+                 + window_update(0, 1 << 20))
+          == "FSEFE");
+    for (int i = 1 ; i != 13 ; i += 2)
+        CHECK(p.feed(headers(i, true)) == "FBE");
+
+    unsigned urgency = connection::default_urgency;
+    bool incremental = false;
+    CHECK(connection::parse_priority("u=5, i", urgency, incremental));
+    CHECK(urgency == 5);
+    CHECK(incremental);
+    CHECK(connection::parse_priority("u=9, i=?0, x=y", urgency, incremental));
+    CHECK(urgency == 5);
+    CHECK(!incremental);
+    CHECK(connection::parse_priority("u=\"1\", i=1", urgency, incremental));
+    CHECK(urgency == 5);
+    CHECK(!incremental);
+    CHECK(!connection::parse_priority("u=", urgency, incremental));
+    CHECK(connection::parse_priority("", urgency, incremental));
+    CHECK(urgency == 5);
+
+    // Urgency first, then stream order or round-robin
+    p.conn.set_priority(3, 1, true);
+    p.conn.set_priority(5, 1, true);
+    p.conn.set_priority(7, 0, false);
+    p.conn.set_priority(9, 4, false);
+    p.conn.set_priority(11, 4, false);
+    p.conn.write_data(11, 20000, true);
+    p.conn.write_data(9, 20000, true);
+    p.conn.write_data(1, 20000, true);
+    p.conn.write_data(5, 20000, true);
+    p.conn.write_data(3, 30000, true);
+    p.conn.write_data(7, 20000, true);
+    CHECK(p.drain()
+          == "7:16384 7:3616$ 5:16384 3:16384 5:3616$ 3:13616$ 1:16384 1:3616$"
+          " 9:16384 9:3616$ 11:16384 11:3616$");
+
+    // PRIORITY_UPDATE (section 7.1 of RFC9218)
+    CHECK(p.feed(headers(13, true) + headers(15, true)) == "FBEFBE");
+    p.conn.write_data(13, 10, true);
+    p.conn.write_data(15, 10, true);
+    CHECK(p.feed(frame(0x10, 0, 0, be32(15) + "u=2")) == "FBE");
+    CHECK(p.feed(frame(0x10, 0, 0, be32(99) + "u=0")) == "FBE");
+    CHECK(p.drain() == "15:10$ 13:10$");
+    CHECK(p.conn.active_streams() == 0);
+    // The prioritized stream is only known at the end of the frame
+    CHECK(p.feed(frame(0x10, 0, 0, be32(0) + "u=0")) == "FBe");
+    CHECK(p.conn.error() == error_code::protocol_error);
+}
+
+TEST_CASE("http2_connection stream table", "[http2]")
+{
+    peer p(connection::role::server, 5000);
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::initial_window_size, 1 << 20))
+                 + window_update(0, 1 << 30))
+          == "FSEFE");
+
+    std::string bytes;
+    for (boost::uint_least32_t i = 1 ; i != 4001 ; i += 2)
+        bytes += headers(i, true);
+    p.feed(bytes);
+    CHECK(p.conn.active_streams() == 2000);
+    p.output();
+
+    // Close them in a scrambled order
+    std::vector<boost::uint_least32_t> ids;
+    for (boost::uint_least32_t i = 1 ; i != 4001 ; i += 2)
+        ids.push_back(i);
+    for (std::size_t i = 0 ; i != ids.size() ; ++i)
+        std::swap(ids[i], ids[(i * 7919) % ids.size()]);
+
+    for (std::size_t i = 0 ; i != ids.size() ; ++i) {
+        p.conn.write_headers(ids[i], asio::buffer("\x88", 1), false);
+        p.conn.write_data(ids[i], 1, true);
+        if (i % 2 == 0)
+            continue;
+        p.drain();
+        for (std::size_t j = i % 89 ; j <= i ; j += 89)
+            REQUIRE(p.conn.state(ids[j]) == stream_state::closed);
+        for (std::size_t j = i + 1 ; j < ids.size() ; j += 97)
+            REQUIRE(p.conn.state(ids[j]) == stream_state::half_closed_remote);
+    }
+    CHECK(p.conn.active_streams() == 0);
+    p.output();
+
+    // Slots are reused
+    CHECK(p.feed(headers(4001)) == "FBE");
+    CHECK(p.conn.state(4001) == stream_state::open);
+    CHECK(p.conn.active_streams() == 1);
+}
+
+TEST_CASE("http2_connection goaway", "[http2]")
+{
+    peer p(connection::role::client);
+    CHECK(p.feed(frame(frame_type::settings, 0, 0,
+                       setting(identifier::max_concurrent_streams, 3)))
+          == "FSE");
+    p.output();
+
+    CHECK(p.conn.open_stream() == 1);
+    CHECK(p.conn.open_stream() == 3);
+    CHECK(p.conn.open_stream() == 5);
+    CHECK(p.conn.open_stream() == 0);
+    CHECK(p.conn.state(7) == stream_state::idle);
+
+    p.conn.write_headers(1, asio::buffer("\x82", 1), true);
+    CHECK(p.feed(frame(frame_type::headers, flags::end_headers | flags::end_stream,
+                       1, "\x88"))
+          == "FBE");
+    CHECK(p.conn.state(1) == stream_state::closed);
+    CHECK(p.conn.open_stream() == 7);
+
+    CHECK(p.feed(frame(frame_type::goaway, 0, 0, be32(3) + be32(0)))
+          == "FE");
+    CHECK(p.conn.goaway_received());
+    // Processed by the peer, but still waiting for its HEADERS
+    CHECK(p.conn.state(3) == stream_state::idle);
+    CHECK(p.conn.state(5) == stream_state::closed);
+    CHECK(p.conn.state(7) == stream_state::closed);
+    CHECK(p.conn.open_stream() == 0);
+    CHECK(p.conn.error() == error_code::no_error);
+}
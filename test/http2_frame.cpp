@@ -0,0 +1,439 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <boost/http/reader/http2_frame.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::reader::http2_frame reader;
+typedef http::token::http2_frame::frame_type frame_type;
+typedef http::token::http2_frame::flags flags;
+
+static const std::string preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+
+static std::string be32(boost::uint_least32_t v)
+{
+    std::string out;
+    for (int i = 3 ; i >= 0 ; --i)
+        out += char(v >> (i * 8));
+    return out;
+}
+
+static std::string frame(int type, int f, boost::uint_least32_t stream_id,
+                         const std::string &payload)
+{
+    std::string out;
+    out += char(payload.size() >> 16);
+    out += char(payload.size() >> 8);
+    out += char(payload.size());
+    out += char(type);
+    out += char(f);
+    return out + be32(stream_id) + payload;
+}
+
+static std::string setting(int id, boost::uint_least32_t value)
+{
+    std::string out;
+    out += char(id >> 8);
+    out += char(id);
+    return out + be32(value);
+}
+
+// The first frame of every connection
+static const std::string settings = preface + frame(frame_type::settings, 0, 0,
+                                                    "");
+
+static void record(reader &parser, std::string &out)
+{
+    switch (parser.code()) {
+    case http::token::code::http2_frame:
+        {
+            http::token::http2_frame::type f
+                = parser.value<http::token::http2_frame>();
+            char header[128];
+            std::sprintf(header, "<%d:%d:%lu:%lu", int(f.frame_type),
+                         int(f.flags), static_cast<unsigned long>(f.stream_id),
+                         static_cast<unsigned long>(f.payload_size));
+            out += header;
+
+            switch (f.frame_type) {
+            case frame_type::headers:
+            case frame_type::priority:
+                if (f.weight != 0) {
+                    std::sprintf(header, " dep=%s%lu/%d",
+                                 f.exclusive ? "!" : "",
+                                 static_cast<unsigned long>(
+                                     f.stream_dependency),
+                                 int(f.weight));
+                    out += header;
+                }
+                break;
+            case frame_type::rst_stream:
+                std::sprintf(header, " err=%lu",
+                             static_cast<unsigned long>(f.error_code));
+                out += header;
+                break;
+            case frame_type::push_promise:
+                std::sprintf(header, " promised=%lu",
+                             static_cast<unsigned long>(f.promised_stream_id));
+                out += header;
+                break;
+            case frame_type::goaway:
+                std::sprintf(header, " last=%lu err=%lu",
+                             static_cast<unsigned long>(f.last_stream_id),
+                             static_cast<unsigned long>(f.error_code));
+                out += header;
+                break;
+            case frame_type::window_update:
+                std::sprintf(header, " inc=%lu",
+                             static_cast<unsigned long>(
+                                 f.window_size_increment));
+                out += header;
+                break;
+            }
+
+            if (f.pad_length != 0) {
+                std::sprintf(header, " pad=%d", int(f.pad_length));
+                out += header;
+            }
+            out += ">";
+            break;
+        }
+    case http::token::code::http2_setting:
+        {
+            http::token::http2_setting::type s
+                = parser.value<http::token::http2_setting>();
+            char entry[64];
+            std::sprintf(entry, "[%d=%lu]", int(s.identifier),
+                         static_cast<unsigned long>(s.value));
+            out += entry;
+            break;
+        }
+    case http::token::code::body_chunk:
+        {
+            asio::const_buffer chunk = parser.value<http::token::body_chunk>();
+            out.append(static_cast<const char*>(chunk.data()), chunk.size());
+            break;
+        }
+    case http::token::code::skip:
+        out += "~";
+        break;
+    case http::token::code::end_of_message:
+        out += "$";
+        break;
+    case http::token::code::error_invalid_data:
+        out += "!";
+        break;
+    case http::token::code::error_frame_too_big:
+        out += "!big";
+        break;
+    default:
+        break;
+    }
+}
+
+/* Feeds `stream` in chunks of `n` bytes, keeping only the unparsed bytes
+   around. Consecutive skip tokens and payload chunks are merged, so the output
+   doesn't depend on `n`. */
+static std::string parse(reader &parser, const std::string &stream,
+                         std::size_t n = std::string::npos)
+{
+    std::string out;
+    std::string buf;
+    std::size_t pos = 0;
+
+    for (;;) {
+        std::size_t step = std::min(n, stream.size() - pos);
+        buf.append(stream, pos, step);
+        pos += step;
+        parser.set_buffer(asio::buffer(buf));
+
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            if (parser.code() != http::token::code::skip
+                || out.empty() || out[out.size() - 1] != '~') {
+                record(parser, out);
+            }
+            if (parser.code() == http::token::code::error_invalid_data
+                || parser.code() == http::token::code::error_frame_too_big) {
+                return out;
+            }
+            parser.next();
+        }
+
+        buf.erase(0, parser.parsed_count());
+        if (pos == stream.size())
+            return out;
+    }
+}
+
+static std::string parse_all(const std::string &stream,
+                             reader::role r = reader::role::server)
+{
+    std::string reference;
+    {
+        reader parser(r);
+        reference = parse(parser, stream);
+    }
+
+    const std::size_t steps[] = {1, 3, 7, 33};
+    for (std::size_t i = 0 ; i != 4 ; ++i) {
+        reader parser(r);
+        REQUIRE(parse(parser, stream, steps[i]) == reference);
+    }
+    return reference;
+}
+
+TEST_CASE("http2 frames", "[parser]")
+{
+    CHECK(parse_all(settings) == "~<4:0:0:0>$");
+
+    // The server's connection preface is a SETTINGS frame
+    CHECK(parse_all(frame(frame_type::settings, 0, 0,
+                          setting(0x3, 100) + setting(0x4, 65535)
+                          + setting(0x5, 16384) + setting(0xFF, 7)),
+                    reader::role::client)
+          == "<4:0:0:24>[3=100][4=65535][5=16384][255=7]$");
+
+    CHECK(parse_all(settings
+                    + frame(frame_type::settings, flags::ack, 0, "")
+                    + frame(frame_type::headers,
+                            flags::end_headers | flags::end_stream, 1,
+                            "\x82\x84")
+                    + frame(frame_type::data, 0, 1, "Hello")
+                    + frame(frame_type::data, flags::end_stream, 1, "")
+                    + frame(frame_type::ping, 0, 0, "12345678")
+                    + frame(frame_type::rst_stream, 0, 3, be32(8))
+                    + frame(frame_type::window_update, 0, 0,
+                            be32(0x80000000 | 1000))
+                    + frame(frame_type::goaway, 0, 0,
+                            be32(5) + be32(2) + "debug"))
+          == "~<4:0:0:0>$<4:1:0:0>$<1:5:1:2>\x82\x84$<0:0:1:5>Hello$"
+          "<0:1:1:0>$<6:0:0:8>12345678$<3:0:3:0 err=8>$"
+          "<8:0:0:0 inc=1000>$<7:0:0:5 last=5 err=2>debug$");
+
+    // Unknown frame types are delivered as opaque payloads
+    CHECK(parse_all(settings + frame(0xFA, 0xFF, 9, "opaque"))
+          == "~<4:0:0:0>$<250:255:9:6>opaque$");
+
+    // Reserved bit of the stream identifier is ignored
+    CHECK(parse_all(settings + frame(frame_type::data, 0, 0x80000003, "x"))
+          == "~<4:0:0:0>$<0:0:3:1>x$");
+}
+
+TEST_CASE("http2 padding and priority", "[parser]")
+{
+    CHECK(parse_all(settings
+                    + frame(frame_type::data, flags::padded, 1,
+                            "\x03" "abc" + std::string(3, '\0')))
+          == "~<4:0:0:0>$<0:8:1:3 pad=3>abc~$");
+
+    // Padding only
+    CHECK(parse_all(settings
+                    + frame(frame_type::data, flags::padded, 1,
+                            "\x02" + std::string(2, '\0')))
+          == "~<4:0:0:0>$<0:8:1:0 pad=2>~$");
+
+    CHECK(parse_all(settings
+                    + frame(frame_type::headers,
+                            flags::padded | flags::priority
+                            | flags::end_headers,
+                            3, "\x01" + be32(0x80000001) + "\x0F" "hb"
+                            + std::string(1, '\0')))
+          == "~<4:0:0:0>$<1:44:3:2 dep=!1/15 pad=1>hb~$");
+
+    CHECK(parse_all(settings
+                    + frame(frame_type::priority, 0, 5, be32(3) + "\x20"))
+          == "~<4:0:0:0>$<2:0:5:0 dep=3/32>$");
+
+    CHECK(parse_all(frame(frame_type::settings, 0, 0, "")
+                    + frame(frame_type::push_promise,
+                            flags::end_headers | flags::padded, 1,
+                            "\x01" + be32(2) + "pp" + std::string(1, '\0')),
+                    reader::role::client)
+          == "<4:0:0:0>$<5:12:1:2 promised=2 pad=1>pp~$");
+}
+
+TEST_CASE("http2 continuation", "[parser]")
+{
+    CHECK(parse_all(settings
+                    + frame(frame_type::headers, 0, 1, "ab")
+                    + frame(frame_type::continuation, 0, 1, "cd")
+                    + frame(frame_type::continuation, flags::end_headers, 1,
+                            "ef")
+                    + frame(frame_type::data, 0, 1, "x"))
+          == "~<4:0:0:0>$<1:0:1:2>ab$<9:0:1:2>cd$<9:4:1:2>ef$<0:0:1:1>x$");
+
+    // Nothing can interrupt a header block
+    CHECK(parse_all(settings
+                    + frame(frame_type::headers, 0, 1, "ab")
+                    + frame(frame_type::ping, 0, 0, "12345678"))
+          == "~<4:0:0:0>$<1:0:1:2>ab$!");
+    CHECK(parse_all(settings
+                    + frame(frame_type::headers, 0, 1, "ab")
+                    + frame(frame_type::continuation, 0, 3, "cd"))
+          == "~<4:0:0:0>$<1:0:1:2>ab$!");
+
+    // CONTINUATION without a header block
+    CHECK(parse_all(settings + frame(frame_type::continuation, 4, 1, "ab"))
+          == "~<4:0:0:0>$!");
+}
+
+TEST_CASE("http2 errors", "[parser]")
+{
+    // Bad preface (e.g. a HTTP/1.1 request) is rejected on the first byte
+    {
+        reader parser;
+        std::string data("G");
+        parser.set_buffer(asio::buffer(data));
+        CHECK(parser.code() == http::token::code::error_invalid_data);
+    }
+    CHECK(parse_all("PRI * HTTP/2.0\r\n\r\nSM\r\n\nX") == "!");
+
+    // The first frame must be a SETTINGS frame (and not an acknowledgement)
+    CHECK(parse_all(preface + frame(frame_type::ping, 0, 0, "12345678"))
+          == "~!");
+    CHECK(parse_all(preface + frame(frame_type::settings, flags::ack, 0, ""))
+          == "~!");
+
+    // Stream identifiers
+    CHECK(parse_all(settings + frame(frame_type::data, 0, 0, "a"))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings + frame(frame_type::headers, 4, 0, "a"))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings + frame(frame_type::settings, 0, 1, ""))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings + frame(frame_type::ping, 0, 1, "12345678"))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings + frame(frame_type::goaway, 0, 1,
+                                     be32(0) + be32(0)))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings + frame(frame_type::priority, 0, 3,
+                                     be32(3) + "\x01"))
+          == "~<4:0:0:0>$!");
+
+    // Clients don't push
+    CHECK(parse_all(settings + frame(frame_type::push_promise, 4, 1, be32(2)))
+          == "~<4:0:0:0>$!");
+
+    // Fixed sizes
+    CHECK(parse_all(settings + frame(frame_type::ping, 0, 0, "1234567"))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(settings + frame(frame_type::rst_stream, 0, 1, "123"))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(settings + frame(frame_type::window_update, 0, 1, "12345"))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(settings + frame(frame_type::priority, 0, 1, "1234"))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(settings + frame(frame_type::goaway, 0, 0, "1234567"))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(preface + frame(frame_type::settings, 0, 0, "12345"))
+          == "~!big");
+    CHECK(parse_all(settings + frame(frame_type::settings, flags::ack, 0,
+                                     setting(1, 0)))
+          == "~<4:0:0:0>$!big");
+    CHECK(parse_all(settings + frame(frame_type::data, flags::padded, 1, ""))
+          == "~<4:0:0:0>$!big");
+
+    // Padding bigger than the payload
+    CHECK(parse_all(settings + frame(frame_type::data, flags::padded, 1,
+                                     "\x02" "a"))
+          == "~<4:0:0:0>$!");
+    CHECK(parse_all(settings
+                    + frame(frame_type::headers,
+                            flags::padded | flags::priority, 1,
+                            "\x01" + be32(0) + "\x01"))
+          == "~<4:0:0:0>$!");
+
+    // Invalid settings
+    CHECK(parse_all(preface + frame(frame_type::settings, 0, 0,
+                                    setting(0x2, 1) + setting(0x2, 2)))
+          == "~<4:0:0:12>[2=1]!");
+    CHECK(parse_all(preface + frame(frame_type::settings, 0, 0,
+                                    setting(0x5, 16383)))
+          == "~<4:0:0:6>!");
+    CHECK(parse_all(preface + frame(frame_type::settings, 0, 0,
+                                    setting(0x5, 16777216)))
+          == "~<4:0:0:6>!");
+}
+
+TEST_CASE("http2 max frame size", "[parser]")
+{
+    const boost::uint_least32_t default_max_frame_size
+        = reader::default_max_frame_size;
+    const std::string big(default_max_frame_size + 1, 'b');
+
+    {
+        reader parser;
+        CHECK(parser.max_frame_size() == default_max_frame_size);
+        CHECK(parse(parser, settings
+                    + frame(frame_type::data, 0, 1, big.substr(1))
+                    + frame(frame_type::data, 0, 1, big))
+              == "~<4:0:0:0>$<0:0:1:16384>" + big.substr(1) + "$!big");
+    }
+
+    // The frame is rejected as soon as its header arrives
+    {
+        reader parser;
+        std::string data = settings + frame(frame_type::data, 0, 1, big)
+            .substr(0, reader::frame_header_size);
+        parser.set_buffer(asio::buffer(data));
+        while (parser.code() != http::token::code::error_insufficient_data
+               && parser.code() != http::token::code::error_frame_too_big) {
+            parser.next();
+        }
+        CHECK(parser.code() == http::token::code::error_frame_too_big);
+    }
+
+    {
+        reader parser;
+        parser.set_max_frame_size(1 << 20);
+        CHECK(parse(parser, settings + frame(frame_type::data, 0, 1, big))
+              == "~<4:0:0:0>$<0:0:1:16385>" + big + "$");
+
+        // The limit survives reset()
+        parser.reset();
+        CHECK(parser.max_frame_size() == 1 << 20);
+        CHECK(parser.expected_token() == http::token::code::skip);
+    }
+}
+
+TEST_CASE("http2 chunks refer to the buffer", "[parser]")
+{
+    std::string stream = settings + frame(frame_type::data, 0, 1, "0123456789");
+
+    reader parser;
+    parser.set_buffer(asio::buffer(stream.data(), stream.size() - 4));
+    REQUIRE(parser.code() == http::token::code::skip);
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::http2_frame);
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::end_of_message);
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::http2_frame);
+    CHECK(parser.token_size() == 9);
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    asio::const_buffer chunk = parser.value<http::token::body_chunk>();
+    CHECK(chunk.data() == stream.data() + stream.size() - 10);
+    CHECK(chunk.size() == 6);
+    parser.next();
+    CHECK(parser.code() == http::token::code::error_insufficient_data);
+    CHECK(parser.expected_token() == http::token::code::body_chunk);
+
+    std::size_t parsed = parser.parsed_count();
+    parser.set_buffer(asio::buffer(stream.data() + parsed,
+                                   stream.size() - parsed));
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    chunk = parser.value<http::token::body_chunk>();
+    CHECK(std::string(static_cast<const char*>(chunk.data()), chunk.size())
+          == "6789");
+    parser.next();
+    CHECK(parser.code() == http::token::code::end_of_message);
+    CHECK(parser.expected_token() == http::token::code::http2_frame);
+}
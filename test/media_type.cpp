@@ -0,0 +1,155 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <vector>
+#include <boost/http/syntax/media_type.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::media_type<char> media_type;
+typedef media_type::interned interned;
+
+std::vector<std::string> collect(boost::string_view in)
+{
+    std::vector<std::string> ret;
+    media_type::parameter p;
+    char scratch[64];
+    while (std::size_t n = media_type::decode_parameter(in, p, scratch,
+                                                       sizeof(scratch))) {
+        ret.push_back(p.name.to_string() + "|" + p.value.to_string());
+        in.remove_prefix(n);
+    }
+    return ret;
+}
+
+TEST_CASE("media_type::decode", "[syntax]")
+{
+    media_type::components c;
+
+    REQUIRE(media_type::decode("text/html", c));
+    CHECK(c.type == "text");
+    CHECK(c.subtype == "html");
+    CHECK(c.parameters.size() == 0);
+    CHECK(c.id == interned::text_html);
+
+    REQUIRE(media_type::decode("Application/JSON ; charset=utf-8 ", c));
+    CHECK(c.type == "Application");
+    CHECK(c.subtype == "JSON");
+    CHECK(c.parameters == "charset=utf-8");
+    CHECK(c.id == interned::application_json);
+
+    REQUIRE(media_type::decode("multipart/form-data; boundary=x", c));
+    CHECK(c.id == interned::multipart_form_data);
+
+    REQUIRE(media_type::decode("application/x-www-form-urlencoded", c));
+    CHECK(c.id == interned::application_x_www_form_urlencoded);
+
+    REQUIRE(media_type::decode("image/svg+xml", c));
+    CHECK(c.id == interned::image_svg_xml);
+
+    REQUIRE(media_type::decode("application/vnd.api+json", c));
+    CHECK(c.id == interned::unknown);
+
+    REQUIRE(media_type::decode("text/xml", c));
+    CHECK(c.id == interned::unknown);
+
+    CHECK(!media_type::decode("", c));
+    CHECK(!media_type::decode("text", c));
+    CHECK(!media_type::decode("text/", c));
+    CHECK(!media_type::decode("/html", c));
+    CHECK(!media_type::decode("text/html/x", c));
+    CHECK(!media_type::decode("te xt/html", c));
+    CHECK(!media_type::decode("text /html", c));
+}
+
+TEST_CASE("media_type interned ids", "[syntax]")
+{
+    const char *types[] = {
+        "text/plain", "text/html", "text/css", "text/csv", "text/javascript",
+        "text/event-stream", "application/json", "application/xml",
+        "application/javascript", "application/octet-stream",
+        "application/x-www-form-urlencoded", "application/grpc",
+        "multipart/form-data", "multipart/byteranges", "multipart/mixed",
+        "image/png", "image/jpeg", "image/gif", "image/webp", "image/svg+xml"
+    };
+    media_type::components c;
+
+    for (int i = 0 ; i != 20 ; ++i) {
+        CAPTURE(types[i]);
+        REQUIRE(media_type::decode(types[i], c));
+        CHECK(c.id == i + 1);
+    }
+
+    // Same sizes as interned ones
+    REQUIRE(media_type::decode("text/gif", c));
+    CHECK(c.id == interned::unknown);
+    REQUIRE(media_type::decode("image/html", c));
+    CHECK(c.id == interned::unknown);
+    REQUIRE(media_type::decode("IMAGE/WebP", c));
+    CHECK(c.id == interned::image_webp);
+    REQUIRE(media_type::decode("application/x-www-form-urlencodedx", c));
+    CHECK(c.id == interned::unknown);
+}
+
+TEST_CASE("media_type parameters", "[syntax]")
+{
+    std::vector<std::string> v;
+
+    CHECK(collect("").empty());
+    CHECK(collect(" ; ;novalue;=x").empty());
+
+    v = collect("charset=UTF-8; format=flowed ;delsp=\"yes\"");
+    REQUIRE(v.size() == 3);
+    CHECK(v[0] == "charset|UTF-8");
+    CHECK(v[1] == "format|flowed");
+    CHECK(v[2] == "delsp|yes");
+
+    v = collect("boundary=\"a;b=\\\"c\\\\\"; x=1");
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "boundary|a;b=\"c\\");
+    CHECK(v[1] == "x|1");
+
+    // Without a scratch buffer, escapes are kept
+    media_type::parameter p;
+    boost::string_view in("title=\"a \\\"b\\\"\"");
+    REQUIRE(media_type::decode_parameter(in, p) == in.size());
+    CHECK(p.escaped);
+    CHECK(p.value == "a \\\"b\\\"");
+
+    // Unescaped values never point to the scratch buffer
+    char scratch[4];
+    REQUIRE(media_type::decode_parameter("a=\"xyz\"", p, scratch, 4) == 7);
+    CHECK(!p.escaped);
+    CHECK(p.value == "xyz");
+    CHECK(p.value.data() != scratch);
+
+    // Too small
+    REQUIRE(media_type::decode_parameter("a=\"\\x\\y\\z\\w\\v\"", p, scratch, 4)
+            == 14);
+    CHECK(p.escaped);
+}
+
+TEST_CASE("media_type::find_parameter", "[syntax]")
+{
+    media_type::components c;
+    REQUIRE(media_type::decode("multipart/form-data; charset=utf-8;"
+                               " BOUNDARY=\"--\\\"simple\\\" boundary\"", c));
+
+    media_type::parameter p;
+    char scratch[64];
+
+    REQUIRE(media_type::find_parameter(c.parameters, "boundary", p, scratch,
+                                       sizeof(scratch)));
+    CHECK(!p.escaped);
+    CHECK(p.value == "--\"simple\" boundary");
+
+    REQUIRE(media_type::find_parameter(c.parameters, "Charset", p));
+    CHECK(p.value == "utf-8");
+
+    CHECK(!media_type::find_parameter(c.parameters, "format", p));
+}
@@ -0,0 +1,246 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <string>
+#include <boost/http/reader/multipart.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+/* Flattens the tokens into a string. Consecutive body chunks are merged, so
+   fragmented and whole feeds can be compared. */
+static void record(http::reader::multipart &parser, std::string &out,
+                   bool &in_body)
+{
+    http::token::code::value code = parser.code();
+    if (code != http::token::code::body_chunk)
+        in_body = false;
+
+    switch (code) {
+    case http::token::code::field_name:
+        out += "[" + parser.value<http::token::field_name>().to_string() + ":";
+        break;
+    case http::token::code::field_value:
+        out += parser.value<http::token::field_value>().to_string() + "]";
+        break;
+    case http::token::code::end_of_headers:
+        out += "{";
+        break;
+    case http::token::code::body_chunk:
+        {
+            asio::const_buffer b = parser.value<http::token::body_chunk>();
+            if (!in_body)
+                out += "<";
+            out.append(static_cast<const char*>(b.data()), b.size());
+            in_body = true;
+            break;
+        }
+    case http::token::code::end_of_body:
+        out += "}";
+        break;
+    case http::token::code::end_of_message:
+        out += "$";
+        break;
+    default:
+        break;
+    }
+}
+
+static std::string parse_whole(boost::string_view boundary,
+                               const std::string &body)
+{
+    http::reader::multipart parser(boundary);
+    std::string out;
+    bool in_body = false;
+
+    parser.set_buffer(asio::buffer(body));
+    while (parser.code() != http::token::code::error_insufficient_data) {
+        if (parser.code() == http::token::code::error_invalid_data)
+            return out + "!";
+        record(parser, out, in_body);
+        parser.next();
+    }
+    return out;
+}
+
+/* Feeds the body one byte at a time and only keeps the unparsed bytes around,
+   as an application streaming the parts to disk would do. */
+static std::string parse_fragmented(boost::string_view boundary,
+                                    const std::string &body,
+                                    std::size_t &max_held)
+{
+    http::reader::multipart parser(boundary);
+    std::string out;
+    std::string buf;
+    bool in_body = false;
+    max_held = 0;
+
+    for (std::size_t i = 0 ; i != body.size() ; ++i) {
+        buf += body[i];
+        parser.set_buffer(asio::buffer(buf));
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            if (parser.code() == http::token::code::error_invalid_data)
+                return out + "!";
+            record(parser, out, in_body);
+            parser.next();
+        }
+        buf.erase(0, parser.parsed_count());
+        max_held = std::max(max_held, buf.size());
+    }
+    return out;
+}
+
+TEST_CASE("multipart/form-data", "[reader]")
+{
+    const std::string body
+        = "This is the preamble.\r\n"
+        "--AaB03x\r\n"
+        "Content-Disposition: form-data; name=\"submit-name\"\r\n"
+        "\r\n"
+        "Larry\r\n"
+        "--AaB03x  \r\n"
+        "Content-Disposition: form-data; name=\"files\"; filename=\"a.txt\"\r\n"
+        "Content-Type:   text/plain \r\n"
+        "\r\n"
+        "line one\r\n--AaB03 is not the boundary\r\n-\r\n--\r\n"
+        "--AaB03x--\r\n"
+        "This is the epilogue.\r\n";
+    const std::string expected
+        = "[Content-Disposition:form-data; name=\"submit-name\"]{<Larry}"
+        "[Content-Disposition:form-data; name=\"files\"; filename=\"a.txt\"]"
+        "[Content-Type:text/plain]"
+        "{<line one\r\n--AaB03 is not the boundary\r\n-\r\n--}$";
+
+    CHECK(parse_whole("AaB03x", body) == expected);
+
+    std::size_t max_held;
+    CHECK(parse_fragmented("AaB03x", body, max_held) == expected);
+
+    // The longest header line is the only thing kept around
+    CHECK(max_held < 80);
+}
+
+TEST_CASE("multipart bodies are streamed in constant memory", "[reader]")
+{
+    std::string data;
+    for (std::size_t i = 0 ; i != 4096 ; ++i)
+        data += static_cast<char>(i % 2 ? '\r' : "-\nab"[i % 4]);
+
+    const std::string body
+        = "--frontier\r\n"
+        "\r\n"
+        + data +
+        "\r\n--frontier--";
+
+    CHECK(parse_whole("frontier", body) == "{<" + data + "}$");
+
+    std::size_t max_held;
+    CHECK(parse_fragmented("frontier", body, max_held) == "{<" + data + "}$");
+
+    // Less than the delimiter (CRLF + "--" + boundary)
+    CHECK(max_held < 14);
+}
+
+TEST_CASE("multipart parts without headers or data", "[reader]")
+{
+    const std::string body
+        = "--b\r\n"
+        "\r\n"
+        "\r\n--b\t\r\n"
+        "\r\n"
+        "x\r\n--b--";
+
+    std::size_t max_held;
+    CHECK(parse_whole("b", body) == "{}{<x}$");
+    CHECK(parse_fragmented("b", body, max_held) == "{}{<x}$");
+}
+
+TEST_CASE("multipart tokens", "[reader]")
+{
+    http::reader::multipart parser("xyz");
+
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+    REQUIRE(parser.expected_token() == http::token::code::skip);
+
+    parser.set_buffer(my_buffer("--xyz\r\n"
+                                "A: b\r\n"
+                                "\r\n"
+                                "data\r\n"
+                                "--xyz--"));
+
+    REQUIRE(parser.code() == http::token::code::skip);
+    REQUIRE(parser.token_size() == 5);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+    REQUIRE(parser.token_size() == 2);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::field_name);
+    REQUIRE(parser.value<http::token::field_name>() == "A");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::field_value);
+    REQUIRE(parser.value<http::token::field_value>() == "b");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::end_of_headers);
+    REQUIRE(parser.expected_token() == http::token::code::body_chunk);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    REQUIRE(parser.token_size() == 4);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::end_of_body);
+    REQUIRE(parser.token_size() == 0);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+    REQUIRE(parser.token_size() == 7);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+    REQUIRE(parser.token_size() == 2);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::end_of_message);
+    REQUIRE(parser.token_size() == 0);
+    REQUIRE(parser.parsed_count() == 28);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+
+    parser.reset();
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+    parser.set_buffer(my_buffer("--xyz\r\n"));
+    REQUIRE(parser.code() == http::token::code::skip);
+}
+
+TEST_CASE("multipart errors", "[reader]")
+{
+    // Invalid boundaries
+    CHECK(http::reader::multipart("").code()
+          == http::token::code::error_invalid_data);
+    CHECK(http::reader::multipart("trailing ").code()
+          == http::token::code::error_invalid_data);
+    CHECK(http::reader::multipart("semi;colon").code()
+          == http::token::code::error_invalid_data);
+    CHECK(http::reader::multipart(std::string(71, 'a')).code()
+          == http::token::code::error_invalid_data);
+    CHECK(http::reader::multipart(std::string(70, 'a')).code()
+          == http::token::code::error_insufficient_data);
+
+    CHECK(parse_whole("b", "--b-x\r\n") == "!");
+    CHECK(parse_whole("b", "--b garbage\r\n") == "!");
+    CHECK(parse_whole("b", "--b\r\nno colon\r\n") == "[no:!");
+}
@@ -0,0 +1,130 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <boost/http/algorithm/path/normalize_path.hpp>
+
+namespace http = boost::http;
+
+std::string normalize(std::string in)
+{
+    if (in.empty())
+        return std::string();
+
+    in.resize(http::normalize_path(&in[0], in.size()));
+    return in;
+}
+
+TEST_CASE("normalize_path", "[algorithm]")
+{
+    CHECK(normalize("") == "");
+    CHECK(normalize("/") == "/");
+    CHECK(normalize("/a/b/c") == "/a/b/c");
+    CHECK(normalize("/a/b/c/") == "/a/b/c/");
+
+    // Examples from section 5.2.4 of RFC3986
+    CHECK(normalize("/a/b/c/./../../g") == "/a/g");
+    CHECK(normalize("mid/content=5/../6") == "mid/6");
+
+    CHECK(normalize("/.") == "/");
+    CHECK(normalize("/a/.") == "/a/");
+    CHECK(normalize("/a/./") == "/a/");
+    CHECK(normalize("/a/./b") == "/a/b");
+    CHECK(normalize("/a/.../b") == "/a/.../b");
+    CHECK(normalize("/a/..b/.c") == "/a/..b/.c");
+
+    // slashes are collapsed
+    CHECK(normalize("//") == "/");
+    CHECK(normalize("//a///b//") == "/a/b/");
+    CHECK(normalize("/a//..//b") == "/b");
+}
+
+TEST_CASE("normalize_path RFC3986 examples", "[algorithm]")
+{
+    /* The examples from section 5.4 of RFC3986, as the paths merged with the
+       base "http://a/b/c/d;p?q" (i.e. prefixed by "/b/c/") */
+
+    // section 5.4.1
+    CHECK(normalize("/b/c/g") == "/b/c/g");
+    CHECK(normalize("/b/c/./g") == "/b/c/g");
+    CHECK(normalize("/b/c/g/") == "/b/c/g/");
+    CHECK(normalize("/b/c/.") == "/b/c/");
+    CHECK(normalize("/b/c/./") == "/b/c/");
+    CHECK(normalize("/b/c/..") == "/b/");
+    CHECK(normalize("/b/c/../") == "/b/");
+    CHECK(normalize("/b/c/../g") == "/b/g");
+    CHECK(normalize("/b/c/../..") == "/");
+    CHECK(normalize("/b/c/../../") == "/");
+    CHECK(normalize("/b/c/../../g") == "/g");
+
+    // section 5.4.2
+    CHECK(normalize("/b/c/../../../g") == "/g");
+    CHECK(normalize("/b/c/../../../../g") == "/g");
+    CHECK(normalize("/./g") == "/g");
+    CHECK(normalize("/../g") == "/g");
+    CHECK(normalize("/b/c/g.") == "/b/c/g.");
+    CHECK(normalize("/b/c/.g") == "/b/c/.g");
+    CHECK(normalize("/b/c/g..") == "/b/c/g..");
+    CHECK(normalize("/b/c/..g") == "/b/c/..g");
+    CHECK(normalize("/b/c/./../g") == "/b/g");
+    CHECK(normalize("/b/c/./g/.") == "/b/c/g/");
+    CHECK(normalize("/b/c/g/./h") == "/b/c/g/h");
+    CHECK(normalize("/b/c/g/../h") == "/b/c/h");
+    CHECK(normalize("/b/c/g;x=1/./y") == "/b/c/g;x=1/y");
+    CHECK(normalize("/b/c/g;x=1/../y") == "/b/c/y");
+}
+
+TEST_CASE("normalize_path percent-encoded dots", "[algorithm]")
+{
+    CHECK(normalize("/a/%2E/b") == "/a/b");
+    CHECK(normalize("/a/%2e/b") == "/a/b");
+    CHECK(normalize("/a/b/%2e%2E/c") == "/a/c");
+    CHECK(normalize("/a/b/%2E%2e/c") == "/a/c");
+    CHECK(normalize("/a/b/.%2E") == "/a/");
+    CHECK(normalize("/a/b/%2e.") == "/a/");
+    CHECK(normalize("/%2e%2E/a") == "/a");
+
+    // Not dot segments
+    CHECK(normalize("/a/%2e%2e%2e") == "/a/%2e%2e%2e");
+    CHECK(normalize("/a/%2ex") == "/a/%2ex");
+    CHECK(normalize("/a/%2f/b") == "/a/%2f/b");
+    CHECK(normalize("/a/%2/b") == "/a/%2/b");
+    CHECK(normalize("/a/%2") == "/a/%2");
+}
+
+TEST_CASE("normalize_path relative paths", "[algorithm]")
+{
+    CHECK(normalize("a") == "a");
+    CHECK(normalize("a/..") == "");
+    CHECK(normalize("a/../") == "");
+    CHECK(normalize("a/b/..") == "a/");
+    CHECK(normalize("./a") == "a");
+    CHECK(normalize("../a") == "a");
+    CHECK(normalize("../../a/b") == "a/b");
+    CHECK(normalize(".") == "");
+    CHECK(normalize("..") == "");
+}
+
+TEST_CASE("normalize_path trailing dot-dot", "[algorithm]")
+{
+    // The slash before ".." stays (section 5.2.4 of RFC3986)
+    CHECK(normalize("/a/..") == "/");
+    CHECK(normalize("/a/b/..") == "/a/");
+    CHECK(normalize("/a/b/../") == "/a/");
+    CHECK(normalize("/a/b/c/../..") == "/a/");
+    CHECK(normalize("/a/b/%2e%2e") == "/a/");
+}
+
+TEST_CASE("normalize_path above the root", "[algorithm]")
+{
+    // ".." segments never climb above the root
+    CHECK(normalize("/..") == "/");
+    CHECK(normalize("/../") == "/");
+    CHECK(normalize("/../a") == "/a");
+    CHECK(normalize("/../../a") == "/a");
+    CHECK(normalize("/a/../../b") == "/b");
+    CHECK(normalize("/../a/../..") == "/");
+}
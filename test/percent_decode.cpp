@@ -0,0 +1,118 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <boost/http/syntax/percent_decode.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::percent_decode<char> percent_decode;
+typedef percent_decode::result result;
+
+result decode(const std::string &in, std::string &out)
+{
+    std::size_t size;
+    out.resize(in.size());
+    result ret = percent_decode::decode(in, &out[0], size);
+    out.resize(size);
+    return ret;
+}
+
+result decode_in_place(std::string &in)
+{
+    std::size_t size;
+    result ret = percent_decode::decode(in, &in[0], size);
+    in.resize(size);
+    return ret;
+}
+
+TEST_CASE("percent_decode::find", "[syntax]")
+{
+    CHECK(percent_decode::find("") == 0);
+    CHECK(percent_decode::find("abc") == 3);
+    CHECK(percent_decode::find("%") == 0);
+    CHECK(percent_decode::find("a%20") == 1);
+    CHECK(percent_decode::find("/some/long/path/that/crosses/a/vector/"
+                               "boundary%2F") == 46);
+}
+
+TEST_CASE("percent_decode::decode", "[syntax]")
+{
+    std::string out;
+
+    REQUIRE(decode("", out) == result::ok);
+    CHECK(out == "");
+
+    REQUIRE(decode("/plain/path", out) == result::ok);
+    CHECK(out == "/plain/path");
+
+    REQUIRE(decode("%41%62%2f%2F", out) == result::ok);
+    CHECK(out == "Ab//");
+
+    REQUIRE(decode("hello%20world", out) == result::ok);
+    CHECK(out == "hello world");
+
+    REQUIRE(decode("%E2%82%AC", out) == result::ok);
+    CHECK(out == "\xE2\x82\xAC");
+
+    REQUIRE(decode("a+b", out) == result::ok);
+    CHECK(out == "a+b");
+
+    REQUIRE(decode("/a/rather/long/path/so/escapes/are/found/by/the/"
+                   "vectorized/loop%3Fyes", out) == result::ok);
+    CHECK(out == "/a/rather/long/path/so/escapes/are/found/by/the/"
+                 "vectorized/loop?yes");
+
+    CHECK(decode("%", out) == result::invalid_escape);
+    CHECK(decode("%2", out) == result::invalid_escape);
+    CHECK(decode("%g0", out) == result::invalid_escape);
+    CHECK(decode("%0g", out) == result::invalid_escape);
+    CHECK(decode("%%20", out) == result::invalid_escape);
+
+    REQUIRE(decode("ab%2xyz", out) == result::invalid_escape);
+    CHECK(out == "ab");
+
+    REQUIRE(decode("ab%00cd", out) == result::encoded_nul);
+    CHECK(out == "ab");
+}
+
+TEST_CASE("percent_decode::decode in place", "[syntax]")
+{
+    std::string buf("/files/my%20document%2Etxt?x=%7e");
+    REQUIRE(decode_in_place(buf) == result::ok);
+    CHECK(buf == "/files/my document.txt?x=~");
+
+    buf = "no escapes";
+    REQUIRE(decode_in_place(buf) == result::ok);
+    CHECK(buf == "no escapes");
+
+    buf = "%61%62%63";
+    REQUIRE(decode_in_place(buf) == result::ok);
+    CHECK(buf == "abc");
+}
+
+TEST_CASE("percent_decode::decode_form", "[syntax]")
+{
+    std::string in("first+name=J%C3%BAlia+%2B+Ana&a+rather+long+value+to+"
+                   "cross+the+vector+loop");
+    std::string out(in.size(), '\0');
+    std::size_t size;
+
+    REQUIRE(percent_decode::decode_form(in, &out[0], size) == result::ok);
+    out.resize(size);
+    CHECK(out == "first name=J\xC3\xBAlia + Ana&a rather long value to cross"
+                 " the vector loop");
+
+    REQUIRE(percent_decode::decode_form(in, &in[0], size) == result::ok);
+    in.resize(size);
+    CHECK(in == out);
+
+    out.resize(4);
+    CHECK(percent_decode::decode_form("a+%0", &out[0], size)
+          == result::invalid_escape);
+    CHECK(size == 2);
+}
@@ -0,0 +1,120 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <string>
+#include <boost/http/writer/pipeline.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+template<class ConstBufferSequence>
+std::string flatten(const ConstBufferSequence &buffers)
+{
+    std::string ret;
+    for (typename ConstBufferSequence::const_iterator it = buffers.begin()
+             ; it != buffers.end() ; ++it) {
+        ret.append(static_cast<const char*>(it->data()), it->size());
+    }
+    return ret;
+}
+
+template<class ConstBufferSequence>
+std::size_t buffer_count(const ConstBufferSequence &buffers)
+{
+    return buffers.end() - buffers.begin();
+}
+
+TEST_CASE("Responses are held until earlier ones finish", "[writer]")
+{
+    http::writer::pipeline<4> p;
+
+    REQUIRE(p.empty());
+    REQUIRE(!p.full());
+    REQUIRE(p.ready_size() == 0);
+    REQUIRE(buffer_count(p.data()) == 0);
+
+    std::size_t t1 = p.reserve();
+    std::size_t t2 = p.reserve();
+    std::size_t t3 = p.reserve();
+    REQUIRE(p.size() == 3);
+
+    p.complete(t3, my_buffer("HTTP/1.1 200 OK\r\n\r\n"), my_buffer("third"));
+    p.complete(t2, my_buffer("HTTP/1.1 204 No Content\r\n\r\n"));
+    REQUIRE(p.ready_size() == 0);
+    REQUIRE(buffer_count(p.data()) == 0);
+
+    p.complete(t1, my_buffer("HTTP/1.1 200 OK\r\n\r\n"), my_buffer("first"));
+    REQUIRE(buffer_count(p.data()) == 5);
+    REQUIRE(flatten(p.data())
+            == "HTTP/1.1 200 OK\r\n\r\nfirst"
+               "HTTP/1.1 204 No Content\r\n\r\n"
+               "HTTP/1.1 200 OK\r\n\r\nthird");
+    REQUIRE(p.ready_size() == flatten(p.data()).size());
+    REQUIRE(p.ready_size() == asio::buffer_size(p.data()));
+
+    p.consume(p.ready_size());
+    REQUIRE(p.empty());
+    REQUIRE(p.ready_size() == 0);
+    REQUIRE(buffer_count(p.data()) == 0);
+}
+
+TEST_CASE("Partial writes keep the remaining bytes in order", "[writer]")
+{
+    http::writer::pipeline<2> p;
+
+    std::size_t t1 = p.reserve();
+    std::size_t t2 = p.reserve();
+    REQUIRE(p.full());
+
+    p.complete(t1, my_buffer("head1"), my_buffer("body1"));
+    REQUIRE(flatten(p.data()) == "head1body1");
+
+    p.consume(3);
+    REQUIRE(flatten(p.data()) == "d1body1");
+    REQUIRE(p.size() == 2);
+
+    p.consume(4);
+    REQUIRE(flatten(p.data()) == "dy1");
+
+    p.complete(t2, my_buffer("head2"));
+    REQUIRE(flatten(p.data()) == "dy1head2");
+
+    p.consume(3);
+    REQUIRE(p.size() == 1);
+    REQUIRE(!p.full());
+    REQUIRE(flatten(p.data()) == "head2");
+
+    // The ring wraps around
+    std::size_t t3 = p.reserve();
+    REQUIRE(t3 == 2);
+    p.complete(t3, my_buffer(""), my_buffer("body3"));
+    REQUIRE(flatten(p.data()) == "head2body3");
+    REQUIRE(buffer_count(p.data()) == 2);
+
+    p.consume(7);
+    REQUIRE(flatten(p.data()) == "dy3");
+    p.consume(3);
+    REQUIRE(p.empty());
+}
+
+TEST_CASE("Empty responses are retired once they reach the front", "[writer]")
+{
+    http::writer::pipeline<3> p;
+
+    std::size_t t1 = p.reserve();
+    std::size_t t2 = p.reserve();
+
+    p.complete(t2, asio::const_buffer());
+    REQUIRE(p.size() == 2);
+
+    p.complete(t1, asio::const_buffer());
+    REQUIRE(p.empty());
+
+    p.reserve();
+    p.reset();
+    REQUIRE(p.empty());
+    REQUIRE(p.reserve() == 0);
+}
@@ -0,0 +1,96 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <boost/http/protocol.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::protocol protocol;
+
+static protocol::value sniff(const std::string &in)
+{
+    return protocol::sniff(asio::buffer(in));
+}
+
+// Every proper prefix of `in` must ask for more data
+static bool needs_all(const std::string &in)
+{
+    for (std::size_t i = 0 ; i != in.size() ; ++i) {
+        if (sniff(in.substr(0, i)) != protocol::insufficient_data)
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("protocol::sniff http/1", "[misc]")
+{
+    CHECK(sniff("") == protocol::insufficient_data);
+    CHECK(sniff("G") == protocol::http_1);
+    CHECK(sniff("GET / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("OPTIONS * HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PO") == protocol::http_1);
+    CHECK(sniff("POST / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PUT / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PATCH / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PROPFIND / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PRI / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PROXY") == protocol::insufficient_data);
+    CHECK(sniff("PROXYFIND / HTTP/1.1\r\n") == protocol::http_1);
+    CHECK(sniff("PRI * HTTP/2.0\r\n\r\nSM\r\n\r")
+          == protocol::insufficient_data);
+    CHECK(sniff("PRI * HTTP/2.0\r\n\r\nSM\r\n\rx") == protocol::http_1);
+}
+
+TEST_CASE("protocol::sniff http/2", "[misc]")
+{
+    std::string preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+    CHECK(needs_all(preface));
+    CHECK(sniff(preface) == protocol::http_2);
+    CHECK(sniff(preface + std::string("\x00\x00\x00\x04", 4))
+          == protocol::http_2);
+}
+
+TEST_CASE("protocol::sniff proxy", "[misc]")
+{
+    CHECK(needs_all("PROXY "));
+    CHECK(sniff("PROXY ") == protocol::proxy_v1);
+    CHECK(sniff("PROXY TCP4 192.0.2.1 192.0.2.2 56324 443\r\nGET")
+          == protocol::proxy_v1);
+
+    std::string signature("\r\n\r\n\0\r\nQUIT\n", 12);
+    CHECK(needs_all(signature));
+    CHECK(sniff(signature) == protocol::proxy_v2);
+    CHECK(sniff(signature + "\x21\x11") == protocol::proxy_v2);
+    CHECK(sniff("\r\n\r\n") == protocol::insufficient_data);
+    CHECK(sniff("\r\nGET / HTTP/1.1\r\n") == protocol::unknown);
+    CHECK(sniff(std::string("\r\n\r\n\0\r\nQUIT\r", 12)) == protocol::unknown);
+}
+
+TEST_CASE("protocol::sniff tls", "[misc]")
+{
+    // TLS 1.0 record (as sent by TLS 1.3 clients) with a ClientHello
+    std::string hello("\x16\x03\x01\x02\x00\x01\x00\x01\xfc\x03\x03", 11);
+    CHECK(needs_all(hello.substr(0, 6)));
+    CHECK(sniff(hello.substr(0, 6)) == protocol::tls);
+    CHECK(sniff(hello) == protocol::tls);
+
+    CHECK(sniff(std::string("\x16\x02", 2)) == protocol::unknown);
+    // ServerHello
+    CHECK(sniff(std::string("\x16\x03\x03\x00\x7a\x02", 6))
+          == protocol::unknown);
+    // Alert record
+    CHECK(sniff(std::string("\x15\x03\x03\x00\x02", 5)) == protocol::unknown);
+}
+
+TEST_CASE("protocol::sniff unknown", "[misc]")
+{
+    CHECK(sniff(" GET / HTTP/1.1\r\n") == protocol::unknown);
+    CHECK(sniff(std::string("\x00", 1)) == protocol::unknown);
+    CHECK(sniff("\x80\x2e\x01") == protocol::unknown);
+    CHECK(sniff("\n") == protocol::unknown);
+}
@@ -0,0 +1,86 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <vector>
+#include <boost/http/algorithm/query/query_range.hpp>
+
+namespace http = boost::http;
+
+typedef http::query_range<boost::string_view> query_range;
+
+std::vector<std::string> collect(const query_range &range)
+{
+    std::vector<std::string> ret;
+    for (query_range::const_iterator it = range.begin() ; it != range.end()
+             ; ++it) {
+        ret.push_back(std::string(it->key.data(), it->key.size()) + "|"
+                      + std::string(it->value.data(), it->value.size()));
+    }
+    return ret;
+}
+
+TEST_CASE("query_range raw", "[algorithm]")
+{
+    std::vector<std::string> v;
+
+    v = collect(query_range(""));
+    CHECK(v.empty());
+
+    v = collect(query_range("&&&"));
+    CHECK(v.empty());
+
+    v = collect(query_range("a=1&b=2"));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "a|1");
+    CHECK(v[1] == "b|2");
+
+    v = collect(query_range("&flag&&x=&=y&k=v=w&"));
+    REQUIRE(v.size() == 4);
+    CHECK(v[0] == "flag|");
+    CHECK(v[1] == "x|");
+    CHECK(v[2] == "|y");
+    CHECK(v[3] == "k|v=w");
+
+    v = collect(query_range("name=caf%C3%A9&q=a+b"));
+    REQUIRE(v.size() == 2);
+    CHECK(v[0] == "name|caf%C3%A9");
+    CHECK(v[1] == "q|a+b");
+
+    // Views reference the input
+    boost::string_view in("key=value");
+    query_range r(in);
+    REQUIRE(r.begin() != r.end());
+    CHECK(r.begin()->key.data() == in.data());
+    CHECK(r.begin()->value.data() == in.data() + 4);
+    CHECK(!r.begin()->decoded);
+}
+
+TEST_CASE("query_range decoded", "[algorithm]")
+{
+    char scratch[16];
+    std::vector<std::string> v;
+
+    v = collect(query_range("name=caf%C3%A9&q=a+b%2B&long_key_long=long_value"
+                            "&bad=%zz", scratch, sizeof(scratch)));
+    REQUIRE(v.size() == 4);
+    CHECK(v[0] == "name|caf\xC3\xA9");
+    CHECK(v[1] == "q|a b+");
+    // doesn't fit in scratch
+    CHECK(v[2] == "long_key_long|long_value");
+    // invalid escape
+    CHECK(v[3] == "bad|%zz");
+
+    query_range r("k%3D=v%26", scratch, sizeof(scratch));
+    query_range::const_iterator it = r.begin();
+    REQUIRE(it != r.end());
+    CHECK(it->decoded);
+    CHECK(it->key == "k=");
+    CHECK(it->value == "v&");
+    CHECK(it->key.data() == scratch);
+    it++;
+    CHECK(it == r.end());
+}
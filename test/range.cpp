@@ -0,0 +1,127 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/http/syntax/range.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::range<char> range;
+typedef range::result result;
+typedef range::byte_range<boost::uint64_t> byte_range;
+
+TEST_CASE("range::decode", "[syntax]")
+{
+    byte_range out[4];
+    std::size_t n;
+
+    // Examples from section 2.1 of RFC7233
+    REQUIRE(range::decode("bytes=0-499", 10000, out, 4, n) == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 0);
+    CHECK(out[0].size == 500);
+
+    REQUIRE(range::decode("bytes=500-999", 10000, out, 4, n) == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 500);
+    CHECK(out[0].size == 500);
+
+    REQUIRE(range::decode("bytes=-500", 10000, out, 4, n) == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 9500);
+    CHECK(out[0].size == 500);
+
+    REQUIRE(range::decode("bytes=9500-", 10000, out, 4, n) == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 9500);
+    CHECK(out[0].size == 500);
+
+    REQUIRE(range::decode("bytes=0-0,-1", 10000, out, 4, n) == result::ok);
+    REQUIRE(n == 2);
+    CHECK(out[0].offset == 0);
+    CHECK(out[0].size == 1);
+    CHECK(out[1].offset == 9999);
+    CHECK(out[1].size == 1);
+
+    // Ranges are clamped to the representation
+    REQUIRE(range::decode("Bytes=100-99999999999999999999999", 1000, out, 4, n)
+            == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 100);
+    CHECK(out[0].size == 900);
+
+    REQUIRE(range::decode("bytes=-99999999999999999999999", 1000, out, 4, n)
+            == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 0);
+    CHECK(out[0].size == 1000);
+
+    // Unsatisfiable ranges are dropped
+    REQUIRE(range::decode("bytes=2000-3000, 10-19", 1000, out, 4, n)
+            == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 10);
+
+    CHECK(range::decode("bytes=1000-", 1000, out, 4, n)
+          == result::unsatisfiable);
+    CHECK(range::decode("bytes=-0", 1000, out, 4, n) == result::unsatisfiable);
+    CHECK(range::decode("bytes=0-", 0, out, 4, n) == result::unsatisfiable);
+    CHECK(range::decode("bytes=99999999999999999999999-", 1000, out, 4, n)
+          == result::unsatisfiable);
+}
+
+TEST_CASE("range::decode merges ranges", "[syntax]")
+{
+    byte_range out[8];
+    std::size_t n;
+
+    REQUIRE(range::decode("bytes=500-600, 0-99 ,601-999,50-150,,-5", 10000,
+                          out, 8, n) == result::ok);
+    REQUIRE(n == 3);
+    CHECK(out[0].offset == 0);
+    CHECK(out[0].size == 151);
+    CHECK(out[1].offset == 500);
+    CHECK(out[1].size == 500);
+    CHECK(out[2].offset == 9995);
+    CHECK(out[2].size == 5);
+
+    REQUIRE(range::decode("bytes=0-10,2-3,11-11", 100, out, 8, n)
+            == result::ok);
+    REQUIRE(n == 1);
+    CHECK(out[0].offset == 0);
+    CHECK(out[0].size == 12);
+
+    // The cap applies before merging
+    CHECK(range::decode("bytes=0-1,0-1,0-1", 100, out, 2, n)
+          == result::too_many_ranges);
+
+    std::string many = "bytes=0-0";
+    for (int i = 0 ; i != 1000 ; ++i)
+        many += ",0-0";
+    CHECK(range::decode(many, 100, out, 8, n) == result::too_many_ranges);
+}
+
+TEST_CASE("range::decode rejects invalid ranges", "[syntax]")
+{
+    byte_range out[4];
+    std::size_t n;
+
+    CHECK(range::decode("", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes= , ", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes 0-1", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("items=0-1", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=1", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=-", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=5-4", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=a-4", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=0-1,1-x", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=-1-2", 1000, out, 4, n) == result::invalid);
+    CHECK(range::decode("bytes=99999999999999999999999-5", 1000, out, 4, n)
+          == result::invalid);
+}
@@ -579,6 +579,10 @@ void my_tester(const char (&input)[N],
             case http::token::code::error_use_another_connection:
             case http::token::code::status_code:
             case http::token::code::reason_phrase:
+            case http::token::code::error_frame_too_big:
+            case http::token::code::websocket_frame:
+            case http::token::code::http2_frame:
+            case http::token::code::http2_setting:
                 BOOST_HTTP_DETAIL_UNREACHABLE("SHOULDN'T HAPPEN");
                 break;
             }
@@ -259,4 +259,11 @@ TEST_CASE("decode_transfer_encoding", "[detail]")
     CHECK(decode_transfer_encoding("a chunked b,   chunked") == CHUNKED_AT_END);
     CHECK(decode_transfer_encoding("chunked b,   chunked") == CHUNKED_AT_END);
     CHECK(decode_transfer_encoding("a chunked,   chunked") == CHUNKED_AT_END);
+
+    // commas within quoted-strings don't split codings
+    CHECK(decode_transfer_encoding("a;p=\"x,chunked\"") == CHUNKED_NOT_FOUND);
+    CHECK(decode_transfer_encoding("chunked, a;p=\"x,chunked\"")
+          == CHUNKED_INVALID);
+    CHECK(decode_transfer_encoding("a;p=\"x,\\\"y\", chunked")
+          == CHUNKED_AT_END);
 }
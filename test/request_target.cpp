@@ -0,0 +1,118 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <boost/http/syntax/request_target.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::request_target<char> request_target;
+typedef request_target::form form;
+typedef request_target::components components;
+
+TEST_CASE("origin-form", "[syntax]")
+{
+    components c;
+
+    REQUIRE(request_target::decode("/", c) == form::origin);
+    CHECK(c.scheme.empty());
+    CHECK(c.authority.empty());
+    CHECK(c.path == "/");
+    CHECK(c.query.empty());
+
+    REQUIRE(request_target::decode("/where?q=now", c) == form::origin);
+    CHECK(c.path == "/where");
+    CHECK(c.query == "q=now");
+
+    REQUIRE(request_target::decode("/a/b?x?y", c) == form::origin);
+    CHECK(c.path == "/a/b");
+    CHECK(c.query == "x?y");
+
+    REQUIRE(request_target::decode("/?", c) == form::origin);
+    CHECK(c.path == "/");
+    CHECK(c.query.empty());
+
+    // Views reference the input
+    boost::string_view in("/index.html?lang=pt");
+    REQUIRE(request_target::decode(in, c) == form::origin);
+    CHECK(c.path.data() == in.data());
+    CHECK(c.query.data() == in.data() + 12);
+}
+
+TEST_CASE("absolute-form", "[syntax]")
+{
+    components c;
+
+    REQUIRE(request_target::decode("http://www.example.org/pub/WWW/TheProject"
+                                   ".html", c) == form::absolute);
+    CHECK(c.scheme == "http");
+    CHECK(c.authority == "www.example.org");
+    CHECK(c.path == "/pub/WWW/TheProject.html");
+    CHECK(c.query.empty());
+
+    REQUIRE(request_target::decode("https://example.com:8080?a=b", c)
+            == form::absolute);
+    CHECK(c.scheme == "https");
+    CHECK(c.authority == "example.com:8080");
+    CHECK(c.path.empty());
+    CHECK(c.query == "a=b");
+
+    REQUIRE(request_target::decode("http://notheaven.onion/", c)
+            == form::absolute);
+    CHECK(c.authority == "notheaven.onion");
+    CHECK(c.path == "/");
+
+    REQUIRE(request_target::decode("coap+tcp://host", c)
+            == form::absolute);
+    CHECK(c.scheme == "coap+tcp");
+
+    REQUIRE(request_target::decode("urn:isbn:0451450523", c)
+            == form::absolute);
+    CHECK(c.scheme == "urn");
+    CHECK(c.authority.empty());
+    CHECK(c.path == "isbn:0451450523");
+
+    REQUIRE(request_target::decode("mailto:someone?subject=hi", c)
+            == form::absolute);
+    CHECK(c.scheme == "mailto");
+    CHECK(c.path == "someone");
+    CHECK(c.query == "subject=hi");
+}
+
+TEST_CASE("authority-form", "[syntax]")
+{
+    components c;
+
+    REQUIRE(request_target::decode("www.example.com:80", c)
+            == form::authority);
+    CHECK(c.scheme.empty());
+    CHECK(c.authority == "www.example.com:80");
+    CHECK(c.path.empty());
+    CHECK(c.query.empty());
+
+    REQUIRE(request_target::decode("127.0.0.1:443", c) == form::authority);
+    CHECK(c.authority == "127.0.0.1:443");
+
+    REQUIRE(request_target::decode("localhost", c) == form::authority);
+    CHECK(c.authority == "localhost");
+
+    REQUIRE(request_target::decode("localhost:", c) == form::authority);
+
+    CHECK(request_target::decode("user@localhost:80", c) == form::invalid);
+    CHECK(request_target::decode("1host:80/", c) == form::invalid);
+    CHECK(request_target::decode("1host:http", c) == form::invalid);
+    CHECK(request_target::decode("a?b", c) == form::invalid);
+}
+
+TEST_CASE("asterisk-form", "[syntax]")
+{
+    components c;
+
+    REQUIRE(request_target::decode("*", c) == form::asterisk);
+    CHECK(c.path.empty());
+
+    CHECK(request_target::decode("", c) == form::invalid);
+}
@@ -0,0 +1,203 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <boost/http/router.hpp>
+
+namespace http = boost::http;
+
+typedef http::router<int> router;
+typedef router::param param;
+
+TEST_CASE("method::convert", "[misc]")
+{
+    CHECK(http::method::convert(boost::string_view("GET")) == http::method::get);
+    CHECK(http::method::convert(boost::string_view("HEAD"))
+          == http::method::head);
+    CHECK(http::method::convert(boost::string_view("POST"))
+          == http::method::post);
+    CHECK(http::method::convert(boost::string_view("PUT")) == http::method::put);
+    CHECK(http::method::convert(boost::string_view("DELETE"))
+          == http::method::delete_);
+    CHECK(http::method::convert(boost::string_view("CONNECT"))
+          == http::method::connect);
+    CHECK(http::method::convert(boost::string_view("OPTIONS"))
+          == http::method::options);
+    CHECK(http::method::convert(boost::string_view("TRACE"))
+          == http::method::trace);
+    CHECK(http::method::convert(boost::string_view("PATCH"))
+          == http::method::patch);
+    CHECK(http::method::convert(boost::string_view("get"))
+          == http::method::other);
+    CHECK(http::method::convert(boost::string_view("PROPFIND"))
+          == http::method::other);
+    CHECK(http::method::convert(boost::string_view("")) == http::method::other);
+}
+
+TEST_CASE("Invalid and conflicting routes", "[router]")
+{
+    router r;
+
+    CHECK(!r.add(http::method::get, "", 0));
+    CHECK(!r.add(http::method::get, "users", 0));
+    CHECK(!r.add(http::method::get, "/users/{}", 0));
+    CHECK(!r.add(http::method::get, "/users/{id", 0));
+    CHECK(!r.add(http::method::get, "/users/x{id}", 0));
+    CHECK(!r.add(http::method::get, "/users/{id}x", 0));
+    CHECK(r.size() == 0);
+
+    CHECK(r.add(http::method::get, "/users/{id}", 1));
+    CHECK(!r.add(http::method::get, "/users/{id}", 2));
+    CHECK(!r.add(http::method::put, "/users/{name}", 2));
+    CHECK(r.add(http::method::put, "/users/{id}", 2));
+    CHECK(r.size() == 2);
+
+    // Rejected patterns leave no trace in the tree
+    router r2;
+    CHECK(!r2.add(http::method::get, "/users/{id}/x{", 1));
+    CHECK(!r2.add(http::method::get, "/users/{id}/{}", 1));
+    CHECK(r2.add(http::method::get, "/users/{uid}", 2));
+    CHECK(r2.add(http::method::get, "/users/{uid}/posts", 3));
+    CHECK(!r2.add(http::method::get, "/users/{uid}/posts", 4));
+    CHECK(!r2.add(http::method::get, "/users/{id}/posts/{n}", 5));
+    CHECK(r2.add(http::method::put, "/users/{uid}/posts/{n}", 6));
+    CHECK(r2.size() == 3);
+    CHECK(r2.max_captures() == 2);
+
+    router::param params[2];
+    std::size_t n;
+    const int *h = r2.match(http::method::get, "/users/42", params, 2, n);
+    REQUIRE(h);
+    CHECK(*h == 2);
+    REQUIRE(n == 1);
+    CHECK(params[0].name == "uid");
+    CHECK(!r2.match(http::method::get, "/users/42/posts/1", params, 2, n));
+}
+
+TEST_CASE("Route matching", "[router]")
+{
+    // A slice of a typical REST API
+    const char *routes[] = {
+        "/",
+        "/user",
+        "/user/repos",
+        "/user/emails",
+        "/users/{user}",
+        "/users/{user}/repos",
+        "/users/{user}/followers",
+        "/users/{user}/following/{target}",
+        "/repos/{owner}/{repo}",
+        "/repos/{owner}/{repo}/issues",
+        "/repos/{owner}/{repo}/issues/{number}",
+        "/repos/{owner}/{repo}/issues/{number}/comments",
+        "/repos/{owner}/{repo}/pulls",
+        "/repos/{owner}/{repo}/pulls/{number}",
+        "/repos/{owner}/{repo}/pulls/{number}/files",
+        "/repos/{owner}/{repo}/git/refs",
+        "/orgs/{org}",
+        "/orgs/{org}/members",
+        "/search/repositories",
+        "/search/users",
+        "/static/main.css",
+        "/static/{file}",
+    };
+    const std::size_t nroutes = sizeof(routes) / sizeof(routes[0]);
+
+    router r;
+    for (std::size_t i = 0 ; i != nroutes ; ++i)
+        REQUIRE(r.add(http::method::get, routes[i], int(i)));
+    REQUIRE(r.add(http::method::post, "/repos/{owner}/{repo}/issues", 100));
+    REQUIRE(r.size() == nroutes + 1);
+    CHECK(r.max_captures() == 3);
+
+    param params[4];
+    std::size_t n;
+    const int *h;
+
+    for (std::size_t i = 0 ; i != nroutes ; ++i) {
+        // every static route matches itself
+        if (boost::string_view(routes[i]).find('{') != boost::string_view::npos)
+            continue;
+
+        h = r.match(http::method::get, routes[i], params, 4, n);
+        REQUIRE(h);
+        CHECK(*h == int(i));
+        CHECK(n == 0);
+    }
+
+    h = r.match(http::method::get, "/users/octocat/following/torvalds",
+                params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 7);
+    REQUIRE(n == 2);
+    CHECK(params[0].name == "user");
+    CHECK(params[0].value == "octocat");
+    CHECK(params[1].name == "target");
+    CHECK(params[1].value == "torvalds");
+
+    boost::string_view target("/repos/boostorg/http/issues/42/comments?page=2");
+    h = r.match(http::method::get, target, params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 11);
+    REQUIRE(n == 3);
+    CHECK(params[0].value == "boostorg");
+    CHECK(params[1].value == "http");
+    CHECK(params[2].name == "number");
+    CHECK(params[2].value == "42");
+    // zero-copy
+    CHECK(params[0].value.data() == target.data() + 7);
+
+    h = r.match(http::method::post, "/repos/boostorg/http/issues", params, 4,
+                n);
+    REQUIRE(h);
+    CHECK(*h == 100);
+
+    // static segments win over captures
+    h = r.match(http::method::get, "/static/main.css", params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 20);
+    h = r.match(http::method::get, "/static/main.js", params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 21);
+    CHECK(params[0].value == "main.js");
+
+    // backtracks from a static prefix into a capture
+    h = r.match(http::method::get, "/user/repos", params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 2);
+    h = r.match(http::method::get, "/users/repos", params, 4, n);
+    REQUIRE(h);
+    CHECK(*h == 4);
+    CHECK(params[0].value == "repos");
+
+    CHECK(!r.match(http::method::delete_, "/user", params, 4, n));
+    CHECK(!r.match(http::method::get, "/users/", params, 4, n));
+    CHECK(!r.match(http::method::get, "/users", params, 4, n));
+    CHECK(!r.match(http::method::get, "/user/repos/", params, 4, n));
+    CHECK(!r.match(http::method::get, "/nothing", params, 4, n));
+    CHECK(!r.match(http::method::get, "", params, 4, n));
+
+    // Routes that share prefixes split nodes after their children were stored
+    router r2;
+    CHECK(r2.max_captures() == 0);
+    REQUIRE(r2.add(http::method::get, "/abc", 0));
+    REQUIRE(r2.add(http::method::get, "/abd", 1));
+    REQUIRE(r2.add(http::method::get, "/x", 2));
+    REQUIRE(r2.add(http::method::get, "/ab", 3));
+    REQUIRE(r2.add(http::method::get, "/abe", 4));
+    REQUIRE(r2.add(http::method::get, "/a", 5));
+    REQUIRE(r2.add(http::method::get, "/y/{z}", 6));
+    CHECK(r2.max_captures() == 1);
+    const char *targets[] = { "/abc", "/abd", "/x", "/ab", "/abe", "/a" };
+    for (int i = 0 ; i != 6 ; ++i) {
+        h = r2.match(http::method::get, targets[i], params, 1, n);
+        REQUIRE(h);
+        CHECK(*h == i);
+    }
+    h = r2.match(http::method::get, "/y/w", params, 1, n);
+    REQUIRE(h);
+    CHECK(*h == 6);
+    CHECK(!r2.match(http::method::get, "/abf", params, 1, n));
+}
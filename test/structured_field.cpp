@@ -0,0 +1,230 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <string>
+#include <boost/http/syntax/structured_field.hpp>
+
+namespace http = boost::http;
+namespace syntax = http::syntax;
+
+typedef syntax::structured_field<char> sf;
+typedef sf::result result;
+typedef sf::node_type node_type;
+typedef sf::node node;
+
+std::string serialize_list(const node *nodes, std::size_t nnodes)
+{
+    std::string ret(sf::serialize_list(nodes, nnodes, NULL, 0), '\0');
+    if (ret.size())
+        sf::serialize_list(nodes, nnodes, &ret[0], ret.size());
+    return ret;
+}
+
+std::string serialize_dictionary(const node *nodes, std::size_t nnodes)
+{
+    std::string ret(sf::serialize_dictionary(nodes, nnodes, NULL, 0), '\0');
+    if (ret.size())
+        sf::serialize_dictionary(nodes, nnodes, &ret[0], ret.size());
+    return ret;
+}
+
+std::string roundtrip_item(const std::string &in)
+{
+    node nodes[16];
+    std::size_t n;
+    if (sf::parse_item(in, nodes, 16, n) != result::ok)
+        return "<invalid>";
+
+    char out[128];
+    std::size_t size = sf::serialize_item(nodes, n, out, sizeof(out));
+    REQUIRE(size <= sizeof(out));
+    return std::string(out, size);
+}
+
+std::string roundtrip_list(const std::string &in)
+{
+    node nodes[16];
+    std::size_t n;
+    if (sf::parse_list(in, nodes, 16, n) != result::ok)
+        return "<invalid>";
+
+    return serialize_list(nodes, n);
+}
+
+std::string roundtrip_dictionary(const std::string &in)
+{
+    node nodes[16];
+    std::size_t n;
+    if (sf::parse_dictionary(in, nodes, 16, n) != result::ok)
+        return "<invalid>";
+
+    return serialize_dictionary(nodes, n);
+}
+
+TEST_CASE("structured_field items", "[syntax]")
+{
+    node nodes[4];
+    std::size_t n;
+
+    REQUIRE(sf::parse_item("42", nodes, 4, n) == result::ok);
+    REQUIRE(n == 1);
+    CHECK(nodes[0].type == node_type::integer);
+    CHECK(nodes[0].number == 42);
+
+    REQUIRE(sf::parse_item(" -999999999999999 ", nodes, 4, n) == result::ok);
+    CHECK(nodes[0].type == node_type::integer);
+    CHECK(nodes[0].number == -999999999999999LL);
+
+    REQUIRE(sf::parse_item("4.5", nodes, 4, n) == result::ok);
+    CHECK(nodes[0].type == node_type::decimal);
+    CHECK(nodes[0].number == 4500);
+
+    REQUIRE(sf::parse_item("-0.125", nodes, 4, n) == result::ok);
+    CHECK(nodes[0].type == node_type::decimal);
+    CHECK(nodes[0].number == -125);
+
+    REQUIRE(sf::parse_item("\"hello \\\"world\\\"\"", nodes, 4, n)
+            == result::ok);
+    CHECK(nodes[0].type == node_type::string);
+    CHECK(nodes[0].text == "hello \\\"world\\\"");
+    {
+        char out[32];
+        std::size_t size = sf::unescape(nodes[0].text, out);
+        CHECK(std::string(out, size) == "hello \"world\"");
+    }
+
+    REQUIRE(sf::parse_item("*foo123/456:bar", nodes, 4, n) == result::ok);
+    CHECK(nodes[0].type == node_type::token);
+    CHECK(nodes[0].text == "*foo123/456:bar");
+
+    REQUIRE(sf::parse_item(":cHJldGVuZCB0aGlzIGlzIGJpbmFyeSBjb250ZW50Lg==:",
+                           nodes, 4, n) == result::ok);
+    CHECK(nodes[0].type == node_type::byte_sequence);
+    CHECK(nodes[0].text == "cHJldGVuZCB0aGlzIGlzIGJpbmFyeSBjb250ZW50Lg==");
+
+    REQUIRE(sf::parse_item("?0;a;b=?0;c=1.5", nodes, 4, n) == result::ok);
+    REQUIRE(n == 4);
+    CHECK(nodes[0].type == node_type::boolean);
+    CHECK(nodes[0].number == 0);
+    CHECK(nodes[0].size == 4);
+    CHECK(nodes[0].nparams == 3);
+    CHECK(sf::find_parameter(nodes[0], "a")->number == 1);
+    CHECK(sf::find_parameter(nodes[0], "b")->number == 0);
+    CHECK(sf::find_parameter(nodes[0], "c")->number == 1500);
+    CHECK(sf::find_parameter(nodes[0], "d") == NULL);
+
+    CHECK(sf::parse_item("", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1 2", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1234567890123456", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1234567890123.0", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1.1234", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1.", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("-", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("\"abc", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("\"\\a\"", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("\"\t\"", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item(":abc", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item(":a!c:", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("?2", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1;A=2", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("(1)", nodes, 4, n) == result::invalid);
+    CHECK(sf::parse_item("1;a;b;c;d", nodes, 4, n) == result::too_many_nodes);
+}
+
+TEST_CASE("structured_field lists", "[syntax]")
+{
+    node nodes[16];
+    std::size_t n;
+
+    REQUIRE(sf::parse_list("", nodes, 16, n) == result::ok);
+    CHECK(n == 0);
+
+    // Client hint
+    const char ua[] = "\"Chromium\";v=\"112\", \"Not:A-Brand\";v=\"99\"";
+    REQUIRE(sf::parse_list(ua, nodes, 16, n) == result::ok);
+    REQUIRE(n == 4);
+    CHECK(nodes[0].text == "Chromium");
+    CHECK(nodes[0].size == 2);
+    CHECK(sf::find_parameter(nodes[0], "v")->text == "112");
+    CHECK(nodes[2].text == "Not:A-Brand");
+    CHECK(sf::find_parameter(nodes[2], "v")->text == "99");
+    CHECK(serialize_list(nodes, n) == ua);
+
+    // Inner lists
+    REQUIRE(sf::parse_list("(\"foo\" \"bar\";x);lvl=5, (), 1", nodes, 16, n)
+            == result::ok);
+    REQUIRE(n == 7);
+    CHECK(nodes[0].type == node_type::inner_list);
+    CHECK(nodes[0].size == 5);
+    CHECK(nodes[0].nparams == 1);
+    CHECK(nodes[1].text == "foo");
+    CHECK(nodes[2].text == "bar");
+    CHECK(nodes[2].nparams == 1);
+    CHECK(nodes[4].key == "lvl");
+    CHECK(nodes[5].type == node_type::inner_list);
+    CHECK(nodes[5].size == 1);
+    CHECK(nodes[6].number == 1);
+    CHECK(sf::find_parameter(nodes[0], "lvl")->number == 5);
+
+    CHECK(roundtrip_list("  a ,\tb,(  1  2 );k=?0 ") == "a, b, (1 2);k=?0");
+    CHECK(roundtrip_list("1.50, -0.0, 2.001, 3.010") == "1.5, 0.0, 2.001, 3.01");
+
+    CHECK(roundtrip_list("a,") == "<invalid>");
+    CHECK(roundtrip_list(",a") == "<invalid>");
+    CHECK(roundtrip_list("a b") == "<invalid>");
+    CHECK(roundtrip_list("(a b") == "<invalid>");
+    CHECK(roundtrip_list("(a,b)") == "<invalid>");
+    CHECK(roundtrip_list("((a))") == "<invalid>");
+
+    CHECK(sf::parse_list("a, b, c", nodes, 2, n) == result::too_many_nodes);
+}
+
+TEST_CASE("structured_field dictionaries", "[syntax]")
+{
+    node nodes[16];
+    std::size_t n;
+
+    // Priority (RFC9218)
+    REQUIRE(sf::parse_dictionary("u=3, i", nodes, 16, n) == result::ok);
+    REQUIRE(n == 2);
+    CHECK(sf::find_member(nodes, n, "u")->number == 3);
+    CHECK(sf::find_member(nodes, n, "i")->type == node_type::boolean);
+    CHECK(sf::find_member(nodes, n, "i")->number == 1);
+    CHECK(sf::find_member(nodes, n, "x") == NULL);
+
+    // Later duplicates win
+    REQUIRE(sf::parse_dictionary("u=3, u=1", nodes, 16, n) == result::ok);
+    CHECK(sf::find_member(nodes, n, "u")->number == 1);
+
+    CHECK(roundtrip_dictionary("en=\"Applepie\", da=:w4ZibGV0w6ZydGU=:")
+          == "en=\"Applepie\", da=:w4ZibGV0w6ZydGU=:");
+    CHECK(roundtrip_dictionary("a=?0, b, c; foo=bar")
+          == "a=?0, b, c;foo=bar");
+    CHECK(roundtrip_dictionary("rating=1.5, feelings=(joy sadness)")
+          == "rating=1.5, feelings=(joy sadness)");
+    CHECK(roundtrip_dictionary("a=(1 2), b=3, c=4;aa=bb, d=(5 6);valid")
+          == "a=(1 2), b=3, c=4;aa=bb, d=(5 6);valid");
+    CHECK(roundtrip_dictionary("b=?1;x") == "b;x");
+
+    CHECK(roundtrip_dictionary("A=1") == "<invalid>");
+    CHECK(roundtrip_dictionary("a=") == "<invalid>");
+    CHECK(roundtrip_dictionary("a=1,") == "<invalid>");
+    CHECK(roundtrip_dictionary("a=1 b=2") == "<invalid>");
+}
+
+TEST_CASE("structured_field serializer truncates", "[syntax]")
+{
+    node nodes[4];
+    std::size_t n;
+    REQUIRE(sf::parse_item("\"hello\";q=0.5", nodes, 4, n) == result::ok);
+
+    char out[8] = {0};
+    CHECK(sf::serialize_item(nodes, n, out, 4) == 13);
+    CHECK(std::string(out, 4) == "\"hel");
+    CHECK(out[4] == '\0');
+
+    CHECK(roundtrip_item("-12;a=\"x\\\\y\"") == "-12;a=\"x\\\\y\"");
+}
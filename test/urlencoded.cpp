@@ -0,0 +1,174 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <string>
+#include <boost/http/reader/urlencoded.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+static void record(http::reader::urlencoded &parser, std::string &out)
+{
+    switch (parser.code()) {
+    case http::token::code::field_name:
+        out += "[" + parser.value<http::token::field_name>().to_string() + "|";
+        break;
+    case http::token::code::field_value:
+        out += parser.value<http::token::field_value>().to_string() + "]";
+        break;
+    case http::token::code::end_of_message:
+        out += "$";
+        break;
+    case http::token::code::error_invalid_data:
+        out += "!";
+        break;
+    default:
+        break;
+    }
+}
+
+static std::string parse_whole(std::string body)
+{
+    http::reader::urlencoded parser;
+    std::string out;
+
+    parser.set_buffer(asio::buffer(&body[0], body.size()));
+    for (;;) {
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            record(parser, out);
+            if (parser.code() == http::token::code::error_invalid_data
+                || parser.code() == http::token::code::end_of_message) {
+                return out;
+            }
+            parser.next();
+        }
+        parser.put_eof();
+    }
+}
+
+/* Feeds the body in chunks of `n` bytes, keeping only the unparsed bytes
+   around. */
+static std::string parse_fragmented(const std::string &body, std::size_t n,
+                                    std::size_t &max_held)
+{
+    http::reader::urlencoded parser;
+    std::string out;
+    std::string buf;
+    max_held = 0;
+
+    for (std::size_t i = 0 ; i < body.size() ; i += n) {
+        buf.append(body, i, n);
+        parser.set_buffer(asio::buffer(&buf[0], buf.size()));
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            record(parser, out);
+            if (parser.code() == http::token::code::error_invalid_data)
+                return out;
+            parser.next();
+        }
+        buf.erase(0, parser.parsed_count());
+        max_held = std::max(max_held, buf.size());
+    }
+
+    parser.set_buffer(asio::buffer(&buf[0], buf.size()));
+    parser.put_eof();
+    while (parser.code() != http::token::code::error_insufficient_data) {
+        record(parser, out);
+        if (parser.code() == http::token::code::error_invalid_data
+            || parser.code() == http::token::code::end_of_message) {
+            break;
+        }
+        parser.next();
+    }
+    return out;
+}
+
+TEST_CASE("urlencoded pairs", "[reader]")
+{
+    CHECK(parse_whole("") == "$");
+    CHECK(parse_whole("a=1") == "[a|1]$");
+    CHECK(parse_whole("a=1&b=2") == "[a|1][b|2]$");
+    CHECK(parse_whole("a=1&&b=2&") == "[a|1][b|2]$");
+    CHECK(parse_whole("flag&x=") == "[flag|][x|]$");
+    CHECK(parse_whole("=v&k=a=b") == "[|v][k|a=b]$");
+    CHECK(parse_whole("first+name=J%C3%BCrgen+M.&q=%26%3D%2B")
+          == "[first name|J\xC3\xBCrgen M.][q|&=+]$");
+
+    CHECK(parse_whole("a=%zz") == "[a|!");
+    CHECK(parse_whole("a%2=1") == "!");
+    CHECK(parse_whole("a=%00") == "[a|!");
+}
+
+TEST_CASE("urlencoded chunked feeding", "[reader]")
+{
+    const std::string body = "name=Ana+Maria&comment=Hello%2C+world%21"
+        "&&empty=&lang=pt-BR&tags=a%26b";
+    const std::string expected = "[name|Ana Maria][comment|Hello, world!]"
+        "[empty|][lang|pt-BR][tags|a&b]$";
+
+    REQUIRE(parse_whole(body) == expected);
+
+    for (std::size_t n = 1 ; n != 8 ; ++n) {
+        std::size_t max_held;
+        CHECK(parse_fragmented(body, n, max_held) == expected);
+
+        // Only the unfinished pair is kept
+        CHECK(max_held < 25 + n);
+    }
+}
+
+TEST_CASE("urlencoded tokens", "[reader]")
+{
+    http::reader::urlencoded parser;
+    char body[] = "k%41=v&x";
+
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+    REQUIRE(parser.expected_token() == http::token::code::field_name);
+
+    parser.set_buffer(asio::buffer(body, sizeof(body) - 1));
+
+    REQUIRE(parser.code() == http::token::code::field_name);
+    REQUIRE(parser.token_size() == 4);
+    REQUIRE(parser.value<http::token::field_name>() == "kA");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+    REQUIRE(parser.token_size() == 1);
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::field_value);
+    REQUIRE(parser.value<http::token::field_value>() == "v");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::skip);
+
+    // "x" might be the beginning of a longer key
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+    REQUIRE(parser.parsed_count() == 7);
+
+    parser.put_eof();
+    REQUIRE(parser.code() == http::token::code::field_name);
+    REQUIRE(parser.value<http::token::field_name>() == "x");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::field_value);
+    REQUIRE(parser.token_size() == 0);
+    REQUIRE(parser.value<http::token::field_value>() == "");
+
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::end_of_message);
+    REQUIRE(parser.parsed_count() == 8);
+
+    // The reader is ready for the next body
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::error_insufficient_data);
+    REQUIRE(parser.expected_token() == http::token::code::field_name);
+
+    char body2[] = "y=1&";
+    parser.set_buffer(asio::buffer(body2, sizeof(body2) - 1));
+    REQUIRE(parser.code() == http::token::code::field_name);
+    REQUIRE(parser.value<http::token::field_name>() == "y");
+}
@@ -0,0 +1,267 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <boost/http/reader/websocket.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::reader::websocket websocket;
+typedef http::token::websocket_frame::opcode opcode;
+
+static const unsigned char key[4] = {0x37, 0xFA, 0x21, 0x3D};
+
+/* Builds a frame. The payload is masked with `key` if `masked` is
+   `true`. */
+static std::string frame(bool fin, opcode::value op, const std::string &payload,
+                         bool masked = true, bool rsv1 = false)
+{
+    std::string out;
+    out += char((fin ? 0x80 : 0) | (rsv1 ? 0x40 : 0) | op);
+
+    char mask_bit = masked ? 0x80 : 0;
+    if (payload.size() < 126) {
+        out += char(mask_bit | payload.size());
+    } else if (payload.size() <= 0xFFFF) {
+        out += char(mask_bit | 126);
+        out += char(payload.size() >> 8);
+        out += char(payload.size());
+    } else {
+        out += char(mask_bit | 127);
+        for (int i = 7 ; i >= 0 ; --i)
+            out += char(boost::uint_least64_t(payload.size()) >> (i * 8));
+    }
+
+    if (!masked)
+        return out + payload;
+
+    out.append(reinterpret_cast<const char*>(key), 4);
+    for (std::size_t i = 0 ; i != payload.size() ; ++i)
+        out += char(payload[i] ^ key[i % 4]);
+    return out;
+}
+
+static void record(websocket &parser, std::string &out)
+{
+    switch (parser.code()) {
+    case http::token::code::websocket_frame:
+        {
+            http::token::websocket_frame::type f
+                = parser.value<http::token::websocket_frame>();
+            char header[64];
+            std::sprintf(header, "<%s%s%d:%lu>", f.fin ? "F" : "",
+                         f.rsv1 ? "R" : "", int(f.opcode),
+                         static_cast<unsigned long>(f.payload_size));
+            out += header;
+            break;
+        }
+    case http::token::code::body_chunk:
+        {
+            asio::const_buffer chunk = parser.value<http::token::body_chunk>();
+            out.append(static_cast<const char*>(chunk.data()), chunk.size());
+            break;
+        }
+    case http::token::code::end_of_message:
+        out += "$";
+        break;
+    case http::token::code::error_invalid_data:
+        out += "!";
+        break;
+    case http::token::code::error_frame_too_big:
+        out += "!big";
+        break;
+    default:
+        break;
+    }
+}
+
+/* Feeds `stream` in chunks of `n` bytes, keeping only the unparsed bytes
+   around, and merges the payload chunks. */
+static std::string parse(websocket &parser, const std::string &stream,
+                         std::size_t n = std::string::npos)
+{
+    std::string out;
+    std::string buf;
+    std::size_t pos = 0;
+
+    for (;;) {
+        std::size_t step = std::min(n, stream.size() - pos);
+        buf.append(stream, pos, step);
+        pos += step;
+        parser.set_buffer(asio::buffer(&buf[0], buf.size()));
+
+        while (parser.code() != http::token::code::error_insufficient_data) {
+            record(parser, out);
+            if (parser.code() == http::token::code::error_invalid_data
+                || parser.code() == http::token::code::error_frame_too_big) {
+                return out;
+            }
+            parser.next();
+        }
+
+        buf.erase(0, parser.parsed_count());
+        if (pos == stream.size())
+            return out;
+    }
+}
+
+static std::string parse_all(const std::string &stream,
+                             websocket::role r = websocket::role::server)
+{
+    std::string reference;
+    {
+        websocket parser(r);
+        reference = parse(parser, stream);
+    }
+
+    const std::size_t steps[] = {1, 3, 7, 33};
+    for (std::size_t i = 0 ; i != 4 ; ++i) {
+        websocket parser(r);
+        REQUIRE(parse(parser, stream, steps[i]) == reference);
+    }
+    return reference;
+}
+
+TEST_CASE("xor_mask", "[detail]")
+{
+    std::string data;
+    for (int i = 0 ; i != 300 ; ++i)
+        data += char(i * 7);
+
+    for (std::size_t offset = 0 ; offset != 4 ; ++offset) {
+        for (std::size_t n = 0 ; n != 100 ; ++n) {
+            std::string expected = data.substr(0, n);
+            for (std::size_t i = 0 ; i != n ; ++i)
+                expected[i] ^= key[(offset + i) % 4];
+
+            std::string masked = data.substr(0, n);
+            http::detail::xor_mask(
+                reinterpret_cast<unsigned char*>(&masked[0]), n, key, offset);
+            REQUIRE(masked == expected);
+        }
+    }
+}
+
+TEST_CASE("websocket frames", "[parser]")
+{
+    CHECK(parse_all(frame(true, opcode::text, "Hello")) == "<F1:5>Hello$");
+    CHECK(parse_all(frame(true, opcode::binary, "")) == "<F2:0>$");
+    CHECK(parse_all(frame(true, opcode::text, "Hello", false),
+                    websocket::role::client) == "<F1:5>Hello$");
+
+    // 16-bit and 64-bit lengths
+    std::string medium(300, 'm');
+    std::string large(70000, 'l');
+    CHECK(parse_all(frame(true, opcode::binary, medium))
+          == "<F2:300>" + medium + "$");
+    CHECK(parse_all(frame(true, opcode::binary, large, false),
+                    websocket::role::client) == "<F2:70000>" + large + "$");
+
+    // Fragmented message with a control frame in the middle
+    CHECK(parse_all(frame(false, opcode::text, "Hel")
+                    + frame(true, opcode::ping, "p")
+                    + frame(false, opcode::continuation, "")
+                    + frame(true, opcode::continuation, "lo")
+                    + frame(true, opcode::close, "\x03\xE8"))
+          == "<1:3>Hel<F9:1>p$<0:0><F0:2>lo$<F8:2>\x03\xE8$");
+}
+
+TEST_CASE("websocket chunks are unmasked once", "[parser]")
+{
+    std::string stream
+        = frame(true, opcode::text, "a payload of 30 bytes and more")
+        + frame(true, opcode::text, "x");
+
+    websocket parser;
+    std::vector<char> buf(stream.begin(), stream.end());
+
+    /* The frame is split and the buffer is given again with the unread bytes
+       (the current token included) */
+    parser.set_buffer(asio::buffer(&buf[0], 20));
+    REQUIRE(parser.code() == http::token::code::websocket_frame);
+    REQUIRE(parser.token_size() == 6);
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    REQUIRE(parser.token_size() == 14);
+    REQUIRE(parser.parsed_count() == 6);
+    parser.set_buffer(asio::buffer(&buf[6], buf.size() - 6));
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    REQUIRE(parser.token_size() == 14);
+    CHECK(std::string(&buf[6], 14) == "a payload of 3");
+    parser.next();
+    REQUIRE(parser.code() == http::token::code::body_chunk);
+    CHECK(std::string(&buf[20], parser.token_size()) == "0 bytes and more");
+    parser.next();
+    CHECK(parser.code() == http::token::code::end_of_message);
+    CHECK(parser.expected_token() == http::token::code::websocket_frame);
+    parser.next();
+    CHECK(parser.code() == http::token::code::websocket_frame);
+}
+
+TEST_CASE("websocket errors", "[parser]")
+{
+    // Unmasked frame sent to a server and masked frame sent to a client
+    CHECK(parse_all(frame(true, opcode::text, "a", false)) == "!");
+    CHECK(parse_all(frame(true, opcode::text, "a"), websocket::role::client)
+          == "!");
+
+    // Reserved bits and opcodes
+    CHECK(parse_all(frame(true, opcode::text, "a", true, true)) == "!");
+    CHECK(parse_all("\xA1\x80" + std::string(4, 'k')) == "!");
+    CHECK(parse_all("\x83\x80" + std::string(4, 'k')) == "!");
+    CHECK(parse_all("\x8B\x80" + std::string(4, 'k')) == "!");
+
+    // Fragmented and big control frames
+    CHECK(parse_all(frame(false, opcode::ping, "")) == "!");
+    CHECK(parse_all(frame(true, opcode::pong, std::string(126, 'p'))) == "!");
+
+    // Continuation without a message and message inside another message
+    CHECK(parse_all(frame(true, opcode::continuation, "a")) == "!");
+    CHECK(parse_all(frame(false, opcode::text, "a")
+                    + frame(true, opcode::binary, "b")) == "<1:1>a!");
+
+    // The most significant bit of the 64-bit length must be 0
+    CHECK(parse_all(std::string("\x82\xFF\x80", 3) + std::string(11, '\0'))
+          == "!");
+
+    // Errors are found before the rest of the header arrives
+    {
+        websocket parser;
+        std::string data("\x89\xFF", 2);
+        parser.set_buffer(asio::buffer(&data[0], data.size()));
+        CHECK(parser.code() == http::token::code::error_invalid_data);
+    }
+
+    {
+        websocket parser;
+        parser.set_max_payload_size(4);
+        CHECK(parser.max_payload_size() == 4);
+        CHECK(parse(parser, frame(true, opcode::text, "abcd")
+                    + frame(true, opcode::text, "abcde")) == "<F1:4>abcd$!big");
+    }
+}
+
+TEST_CASE("websocket rsv1", "[parser]")
+{
+    websocket parser;
+    CHECK(!parser.rsv1_allowed());
+    parser.set_rsv1_allowed(true);
+
+    CHECK(parse(parser, frame(false, opcode::text, "a", true, true)
+                + frame(true, opcode::continuation, "b"))
+          == "<R1:1>a<F0:1>b$");
+
+    // Only the first frame of data messages may carry it
+    parser.reset();
+    CHECK(parser.rsv1_allowed());
+    CHECK(parse(parser, frame(true, opcode::ping, "", true, true)) == "!");
+    parser.reset();
+    CHECK(parse(parser, frame(false, opcode::text, "a")
+                + frame(true, opcode::continuation, "b", true, true))
+          == "<1:1>a!");
+}
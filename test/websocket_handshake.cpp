@@ -0,0 +1,162 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <string>
+#include <boost/http/websocket_handshake.hpp>
+#include <boost/http/reader/request.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::websocket_handshake handshake;
+
+// A copy, so the static member isn't odr-used by Catch's expression templates
+static const std::size_t response_size = handshake::response_size;
+
+static handshake::result handle(handshake &h, const std::string &request)
+{
+    http::reader::request parser;
+    parser.set_buffer(asio::buffer(request));
+
+    for (;;) {
+        REQUIRE(parser.symbol() != http::token::symbol::error);
+        h.put(parser);
+        if (parser.code() == http::token::code::end_of_headers)
+            return h.get_result();
+        parser.next();
+    }
+}
+
+static handshake::result handle(const std::string &request)
+{
+    handshake h;
+    return handle(h, request);
+}
+
+static std::string accept_key(const char (&key)[25])
+{
+    char k[handshake::key_size];
+    std::copy(key, key + handshake::key_size, k);
+    char out[handshake::accept_size];
+    handshake::accept_key(k, out);
+    return std::string(out, handshake::accept_size);
+}
+
+TEST_CASE("websocket accept key", "[websocket_handshake]")
+{
+    // section 1.3 of RFC6455
+    CHECK(accept_key("dGhlIHNhbXBsZSBub25jZQ==")
+          == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    CHECK(accept_key("AAAAAAAAAAAAAAAAAAAAAA==")
+          == "ICX+Yqv66kxgM0FcWaLWlFLwTAI=");
+    CHECK(accept_key("/////////////////////w==")
+          == "XXpj4jYzLM2yUE0C7TIgMwTQh2g=");
+    CHECK(accept_key("x3JJHMbDL1EzLkh9GBhXDw==")
+          == "HSmrc0sMlYUkAGmm5OPpG2HaGWk=");
+}
+
+TEST_CASE("websocket handshake accepted", "[websocket_handshake]")
+{
+    handshake h;
+    REQUIRE(h.get_result() == handshake::result::incomplete);
+    REQUIRE(handle(h,
+                   "GET /chat HTTP/1.1\r\n"
+                   "Host: server.example.com\r\n"
+                   "Upgrade: websocket\r\n"
+                   "Connection: keep-alive, Upgrade\r\n"
+                   "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                   "Origin: http://example.com\r\n"
+                   "Sec-WebSocket-Version: 13\r\n"
+                   "\r\n") == handshake::result::accepted);
+
+    const std::string expected = "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+        "\r\n";
+    CHECK(expected.size() == response_size);
+
+    char buf[256];
+    CHECK(h.write_response(asio::buffer(buf, handshake::response_size - 1))
+          == 0);
+    REQUIRE(h.write_response(asio::buffer(buf)) == response_size);
+    CHECK(std::string(buf, response_size) == expected);
+
+    const std::string extra = "Sec-WebSocket-Protocol: chat\r\n";
+    std::size_t n = h.write_response(asio::buffer(buf), extra);
+    REQUIRE(n == response_size + extra.size());
+    CHECK(std::string(buf, n)
+          == expected.substr(0, expected.size() - 2) + extra + "\r\n");
+
+    // Field names and tokens are case-insensitive
+    CHECK(handle("GET / HTTP/1.1\r\n"
+                 "host: a\r\n"
+                 "UPGRADE: WebSocket\r\n"
+                 "connection: upgrade\r\n"
+                 "sec-websocket-key: x3JJHMbDL1EzLkh9GBhXDw==\r\n"
+                 "sec-websocket-version: 13\r\n"
+                 "\r\n") == handshake::result::accepted);
+
+    // The reset object is ready for another request
+    h.reset();
+    CHECK(h.get_result() == handshake::result::incomplete);
+    CHECK(h.write_response(asio::buffer(buf)) == 0);
+}
+
+TEST_CASE("websocket handshake rejected", "[websocket_handshake]")
+{
+    const std::string host = "Host: a\r\n";
+    const std::string upgrade = "Upgrade: websocket\r\n";
+    const std::string connection = "Connection: Upgrade\r\n";
+    const std::string key = "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n";
+    const std::string version = "Sec-WebSocket-Version: 13\r\n";
+    const std::string get = "GET / HTTP/1.1\r\n";
+
+    CHECK(handle(get + host + "\r\n") == handshake::result::not_upgrade);
+    CHECK(handle(get + host + "Upgrade: h2c\r\n" + connection + "\r\n")
+          == handshake::result::not_upgrade);
+
+    CHECK(handle("POST / HTTP/1.1\r\n" + host + upgrade + connection + key
+                 + version + "Content-Length: 0\r\n\r\n")
+          == handshake::result::bad_request);
+    CHECK(handle("GET / HTTP/1.0\r\n" + host + upgrade + connection + key
+                 + version + "\r\n") == handshake::result::bad_request);
+    CHECK(handle(get + host + upgrade + "Connection: close\r\n" + key + version
+                 + "\r\n") == handshake::result::bad_request);
+    CHECK(handle(get + host + upgrade + connection + version + "\r\n")
+          == handshake::result::bad_request);
+    CHECK(handle(get + host + upgrade + connection + key + key + version
+                 + "\r\n") == handshake::result::bad_request);
+    CHECK(handle(get + host + upgrade + connection + key + "\r\n")
+          == handshake::result::bad_request);
+
+    // Keys that aren't the base64 encoding of 16 bytes
+    const char *bad_keys[] = {
+        "dGhlIHNhbXBsZSBub25jZQ=",
+        "dGhlIHNhbXBsZSBub25jZQ===",
+        "dGhlIHNhbXBsZSBub25jZR==",
+        "dGhlIHNhbXBsZSBub25j*Q==",
+        "dGhlIHNhbXBsZSBub25jZQAA"
+    };
+    for (std::size_t i = 0 ; i != 5 ; ++i) {
+        CHECK(handle(get + host + upgrade + connection + "Sec-WebSocket-Key: "
+                     + bad_keys[i] + "\r\n" + version + "\r\n")
+              == handshake::result::bad_request);
+    }
+
+    handshake h;
+    REQUIRE(handle(h, get + host + upgrade + connection + key
+                   + "Sec-WebSocket-Version: 8\r\n\r\n")
+            == handshake::result::unsupported_version);
+
+    char buf[256];
+    std::size_t n = h.write_response(asio::buffer(buf));
+    CHECK(std::string(buf, n) == "HTTP/1.1 426 Upgrade Required\r\n"
+          "Sec-WebSocket-Version: 13\r\n"
+          "Content-Length: 0\r\n"
+          "\r\n");
+}
@@ -0,0 +1,350 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "common.hpp"
+#include <cstdio>
+#include <string>
+#include <boost/http/writer/websocket.hpp>
+#include <boost/http/reader/websocket.hpp>
+
+namespace asio = boost::asio;
+namespace http = boost::http;
+
+typedef http::writer::websocket writer;
+typedef http::reader::websocket reader;
+typedef http::token::websocket_frame::opcode opcode;
+
+static std::string to_string(writer::const_buffers_type buffers)
+{
+    std::string ret;
+    for (writer::const_buffers_type::const_iterator it = buffers.begin()
+             ; it != buffers.end() ; ++it) {
+        ret.append(static_cast<const char*>(it->data()), it->size());
+    }
+    return ret;
+}
+
+struct message
+{
+    int opcode;
+    bool rsv1;
+    std::string payload;
+};
+
+/* Parses the whole `stream` with the reader. Messages are listed in the order
+   they end. */
+static std::vector<message> parse(std::string stream, reader::role r)
+{
+    std::vector<message> ret;
+    reader parser(r);
+    parser.set_rsv1_allowed(true);
+    parser.set_buffer(asio::buffer(&stream[0], stream.size()));
+
+    // Control frames may interrupt a data message
+    message data, control;
+    message *current = NULL;
+    bool first = true;
+    while (parser.code() != http::token::code::error_insufficient_data) {
+        REQUIRE(parser.code() != http::token::code::error_invalid_data);
+        switch (parser.code()) {
+        case http::token::code::websocket_frame:
+            {
+                http::token::websocket_frame::type f
+                    = parser.value<http::token::websocket_frame>();
+                if (f.opcode & 0x8) {
+                    current = &control;
+                } else {
+                    current = &data;
+                    if (!first)
+                        break;
+                    first = false;
+                }
+                current->opcode = f.opcode;
+                current->rsv1 = f.rsv1;
+                break;
+            }
+        case http::token::code::body_chunk:
+            {
+                asio::const_buffer c = parser.value<http::token::body_chunk>();
+                current->payload.append(static_cast<const char*>(c.data()),
+                                        c.size());
+                break;
+            }
+        case http::token::code::end_of_message:
+            ret.push_back(*current);
+            current->payload.clear();
+            if (current == &data)
+                first = true;
+            break;
+        default:
+            break;
+        }
+        parser.next();
+    }
+    REQUIRE(parser.parsed_count() == stream.size());
+    return ret;
+}
+
+class inflater
+{
+public:
+    inflater()
+    {
+        std::memset(&stream, 0, sizeof(stream));
+        REQUIRE(inflateInit2(&stream, -MAX_WBITS) == Z_OK);
+    }
+
+    ~inflater()
+    {
+        inflateEnd(&stream);
+    }
+
+    // section 7.2.2 of RFC7692
+    std::string operator()(std::string payload)
+    {
+        payload.append("\x00\x00\xFF\xFF", 4);
+        std::vector<char> out(1 << 20);
+        stream.next_in = reinterpret_cast<Bytef*>(&payload[0]);
+        stream.avail_in = static_cast<uInt>(payload.size());
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        int ret = inflate(&stream, Z_SYNC_FLUSH);
+        REQUIRE((ret == Z_OK || ret == Z_BUF_ERROR));
+        REQUIRE(stream.avail_in == 0);
+        return std::string(&out[0], out.size() - stream.avail_out);
+    }
+
+private:
+    z_stream stream;
+};
+
+/* Writes a compressed message feeding `in_step` bytes at a time into output
+   windows of `out_step` bytes. */
+static std::string compress(writer &w, opcode::value op, const std::string &in,
+                            std::size_t in_step, std::size_t out_step,
+                            std::size_t *frames = NULL)
+{
+    std::vector<char> window(out_step);
+    std::string out;
+    std::size_t pos = 0;
+    if (frames)
+        *frames = 0;
+
+    for (;;) {
+        std::size_t n = std::min(in_step, in.size() - pos);
+        bool finish = pos + n == in.size();
+        std::size_t consumed;
+        bool done = w.write_compressed(op, asio::buffer(in.data() + pos, n),
+                                       asio::buffer(window), finish, consumed);
+        pos += consumed;
+        REQUIRE(w.size() == to_string(w.data()).size());
+        out += to_string(w.data());
+        if (frames && w.size() != 0)
+            ++*frames;
+
+        if (done)
+            return out;
+    }
+}
+
+static std::string sample()
+{
+    std::string text;
+    for (int i = 0 ; i != 200 ; ++i) {
+        char row[64];
+        std::sprintf(row, "{\"id\":%d,\"value\":\"item %d\"}\n", i, i * 7);
+        text += row;
+    }
+    return text;
+}
+
+TEST_CASE("websocket writer frames", "[writer]")
+{
+    writer w;
+
+    w.write_frame(opcode::text, asio::const_buffer("Hello", 5));
+    CHECK(w.size() == 7);
+    CHECK(std::distance(w.data().begin(), w.data().end()) == 2);
+    CHECK(to_string(w.data()) == "\x81\x05Hello");
+
+    // The payload isn't copied
+    const std::string medium(300, 'm');
+    w.write_frame(opcode::binary, asio::buffer(medium));
+    CHECK(to_string(w.data()) == "\x82\x7E\x01\x2C" + medium);
+    CHECK((w.data().begin() + 1)->data() == medium.data());
+
+    const std::string large(70000, 'l');
+    w.write_frame(opcode::binary, asio::buffer(large));
+    CHECK(to_string(w.data())
+          == std::string("\x82\x7F\x00\x00\x00\x00\x00\x01\x11\x70", 10)
+          + large);
+
+    w.write_frame(opcode::close, asio::const_buffer());
+    CHECK(to_string(w.data()) == std::string("\x88\x00", 2));
+}
+
+TEST_CASE("websocket writer fragments and client masking", "[writer]")
+{
+    const char *roles[] = {"server", "client"};
+    for (int i = 0 ; i != 2 ; ++i) {
+        INFO(roles[i]);
+        writer::role wr = i ? writer::role::client : writer::role::server;
+        reader::role rr = i ? reader::role::server : reader::role::client;
+        writer w(wr);
+        std::string stream;
+
+        std::string parts[] = {"Hel", "ping", "lo, ", "world"};
+        std::string big(1000, 'b');
+        unsigned char keys[][4] = {{1, 2, 3, 4}, {0xFF, 0, 0x80, 7},
+                                   {9, 9, 9, 9}, {0x12, 0x34, 0x56, 0x78},
+                                   {0xAA, 0xBB, 0xCC, 0xDD}};
+
+        w.set_mask_key(keys[0]);
+        w.write_frame(opcode::text, asio::buffer(&parts[0][0], 3), false);
+        stream += to_string(w.data());
+        w.set_mask_key(keys[1]);
+        w.write_frame(opcode::ping, asio::buffer(&parts[1][0], 4));
+        stream += to_string(w.data());
+        w.set_mask_key(keys[2]);
+        w.write_frame(opcode::text, asio::buffer(&parts[2][0], 4), false);
+        stream += to_string(w.data());
+        w.set_mask_key(keys[3]);
+        w.write_frame(opcode::text, asio::buffer(&parts[3][0], 5), true);
+        stream += to_string(w.data());
+        w.set_mask_key(keys[4]);
+        w.write_frame(opcode::binary, asio::buffer(&big[0], big.size()));
+        stream += to_string(w.data());
+
+        std::vector<message> msgs = parse(stream, rr);
+        REQUIRE(msgs.size() == 3);
+        CHECK(msgs[0].opcode == opcode::ping);
+        CHECK(msgs[0].payload == "ping");
+        CHECK(msgs[1].opcode == opcode::text);
+        CHECK(msgs[1].payload == "Hello, world");
+        CHECK(msgs[2].opcode == opcode::binary);
+        CHECK(msgs[2].payload == std::string(1000, 'b'));
+    }
+}
+
+TEST_CASE("websocket writer permessage-deflate", "[writer]")
+{
+    http::writer::deflate_pool pool;
+
+    // section 7.2.3.1 of RFC7692
+    {
+        writer w;
+        w.enable_deflate(pool, false);
+        CHECK(w.deflate_enabled());
+        CHECK(compress(w, opcode::text, "Hello", 5, 64)
+              == std::string("\xC1\x07\xF2\x48\xCD\xC9\xC9\x07\x00", 9));
+        CHECK(pool.size() == 1);
+    }
+
+    const std::string body = sample();
+    // The smallest windows have more framing than compressed data
+    const std::size_t steps[][2] = {{1 << 20, 1 << 20}, {100, 64}, {1, 7},
+                                    {7, 8}, {4096, 9}};
+    for (int i = 0 ; i != 2 ; ++i) {
+        writer::role wr = i ? writer::role::client : writer::role::server;
+        reader::role rr = i ? reader::role::server : reader::role::client;
+
+        for (std::size_t j = 0 ; j != 5 ; ++j) {
+            writer w(wr);
+            w.enable_deflate(pool, true);
+            unsigned char key[4] = {0x11, 0x22, 0x33, (unsigned char)j};
+            w.set_mask_key(key);
+
+            std::string stream = compress(w, opcode::text, body, steps[j][0],
+                                          steps[j][1]);
+            std::size_t first_size = stream.size();
+            if (j < 2)
+                CHECK(first_size < body.size() / 3);
+
+            w.write_frame(opcode::pong, asio::mutable_buffer());
+            stream += to_string(w.data());
+
+            // Context takeover: the same message costs far less
+            std::string again = compress(w, opcode::binary, body, steps[j][0],
+                                         steps[j][1]);
+            if (j < 2)
+                CHECK(again.size() < first_size / 4);
+            stream += again;
+
+            std::vector<message> msgs = parse(stream, rr);
+            REQUIRE(msgs.size() == 3);
+            inflater inflate;
+            CHECK(msgs[0].opcode == opcode::text);
+            CHECK(msgs[0].rsv1);
+            CHECK(inflate(msgs[0].payload) == body);
+            CHECK(msgs[1].opcode == opcode::pong);
+            CHECK(!msgs[1].rsv1);
+            CHECK(msgs[2].opcode == opcode::binary);
+            CHECK(msgs[2].rsv1);
+            CHECK(inflate(msgs[2].payload) == body);
+        }
+    }
+
+    // Control frames can be written between the frames of a message
+    {
+        writer w;
+        w.enable_deflate(pool, true);
+        std::vector<char> window(256);
+        std::size_t consumed;
+        std::string stream;
+
+        REQUIRE(!w.write_compressed(opcode::text, asio::buffer(body),
+                                    asio::buffer(window), false, consumed));
+        CHECK(consumed == body.size());
+        stream += to_string(w.data());
+        w.write_frame(opcode::ping, asio::const_buffer("?", 1));
+        stream += to_string(w.data());
+        while (!w.write_compressed(opcode::text, asio::const_buffer(),
+                                   asio::buffer(window), true, consumed)) {
+            stream += to_string(w.data());
+        }
+        stream += to_string(w.data());
+
+        std::vector<message> msgs = parse(stream, reader::role::client);
+        REQUIRE(msgs.size() == 2);
+        CHECK(msgs[0].opcode == opcode::ping);
+        CHECK(msgs[1].opcode == opcode::text);
+        CHECK(inflater()(msgs[1].payload) == body);
+    }
+}
+
+TEST_CASE("websocket writer without context takeover", "[writer]")
+{
+    http::writer::deflate_pool pool(Z_DEFAULT_COMPRESSION, 15, 8, 1);
+    const std::string body = sample();
+
+    writer w;
+    w.enable_deflate(pool, false);
+
+    std::string a = compress(w, opcode::text, body, 512, 256);
+    CHECK(pool.size() == 1);
+    std::string b = compress(w, opcode::text, body, 512, 256);
+    CHECK(pool.size() == 1);
+
+    // Every message is compressed from scratch
+    CHECK(a == b);
+    std::vector<message> msgs = parse(a + b, reader::role::client);
+    REQUIRE(msgs.size() == 2);
+    CHECK(inflater()(msgs[0].payload) == body);
+    CHECK(inflater()(msgs[1].payload) == body);
+
+    // Empty messages
+    std::string empty = compress(w, opcode::binary, "", 1, 16);
+    msgs = parse(empty, reader::role::client);
+    REQUIRE(msgs.size() == 1);
+    CHECK(inflater()(msgs[0].payload) == "");
+
+    // With context takeover, the stream is only given back at the end
+    w.enable_deflate(pool, true);
+    compress(w, opcode::text, body, 512, 256);
+    CHECK(pool.size() == 0);
+    w.disable_deflate();
+    CHECK(!w.deflate_enabled());
+    CHECK(pool.size() == 1);
+}